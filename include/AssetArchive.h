@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+// Fonts and sounds packed into one indexed file (assets.pak, written by
+// tools/AssetPacker.cpp at build time). The file is memory-mapped and
+// assets are views into the mapping: fonts are opened through
+// SDL_RWFromConstMem, sounds are PCM already in the mixer's output format
+// and play straight from the mapping.
+//
+// Layout: a Header, `count` Entries sorted by name, then the data of each
+// entry at a 16-byte aligned offset. Integers are native-endian, the archive
+// is built on the machine that runs it.
+class AssetArchive {
+public:
+    static constexpr std::uint32_t MAGIC = 0x4B415054;  // "TPAK"
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t NAME_LENGTH = 52;
+    static constexpr std::size_t ALIGNMENT = 16;
+
+    enum class Kind : std::uint32_t {
+        Raw,  // File bytes as they were
+        Pcm   // MIX_DEFAULT_FORMAT samples, AUDIO_CHANNELS channels at AUDIO_SAMPLE_RATE
+    };
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t count;
+        std::uint32_t reserved;
+    };
+
+    struct Entry {
+        char name[NAME_LENGTH];  // Zero padded, e.g. "fonts/Arial.ttf"
+        Kind kind;
+        std::uint32_t offset;    // From the start of the archive
+        std::uint32_t size;
+    };
+
+    struct Asset {
+        std::string_view name;
+        Kind kind;
+        std::span<const std::byte> data;
+    };
+
+    // One file for pack()
+    struct Input {
+        std::string name;
+        Kind kind;
+        std::vector<std::byte> data;
+    };
+
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool open(const std::string& path);                 // Memory-maps the file
+    bool openMemory(std::span<const std::byte> bytes);  // Not copied, must outlive the archive
+    void close();
+    bool isOpen() const { return !bytes_.empty(); }
+
+    std::optional<Asset> find(std::string_view name) const;
+    std::optional<Asset> findFirst(std::string_view prefix) const;  // Lowest name with the prefix
+    std::span<const Entry> entries() const;
+
+    // The complete archive image for a set of files, names longer than
+    // NAME_LENGTH - 1 are rejected
+    static std::optional<std::vector<std::byte>> pack(std::vector<Input> inputs);
+
+private:
+    std::span<const std::byte> bytes_;
+    MappedFile file_;  // Open when bytes_ is our own mapping
+
+    bool validate() const;
+    Asset assetAt(const Entry& entry) const;
+};
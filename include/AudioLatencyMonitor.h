@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Measures the audio device from inside its callback: how often the mixer
+// is really called, how much it is asked for each time, and how often a
+// callback comes so late that the device must have run dry. onCallback()
+// runs on SDL's audio thread, everything else may be read from any thread.
+class AudioLatencyMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::uint32_t WARMUP_CALLBACKS = 4;  // Device start-up jitter, not measured
+    static constexpr int UNDERRUN_FACTOR = 2;  // A gap of two periods empties SDL's double buffer
+    static constexpr int BUFFERED_PERIODS = 2;  // One buffer playing while the next is mixed
+
+    struct Report {
+        int bufferFrames = 0;        // Requested from Mix_OpenAudio
+        int framesPerCallback = 0;   // Measured queue depth of one callback
+        double periodMs = 0.0;       // Measured time between callbacks
+        double latencyMs = 0.0;      // Mixed sample to speaker, BUFFERED_PERIODS measured periods
+        std::uint32_t callbacks = 0;
+        std::uint32_t underruns = 0;
+        bool calibrated = false;     // Enough callbacks for the numbers to mean something
+    };
+
+    // A newly opened device, call while no callback can run
+    void reset(int bufferFrames, int sampleRate, int bytesPerFrame);
+
+    // From the mixer callback, `bytes` is the size of the buffer it filled
+    void onCallback(Clock::time_point now, int bytes);
+
+    Report report() const;
+    std::uint32_t underruns() const { return underruns_.load(std::memory_order_relaxed); }
+
+    static void print(std::ostream& out, const Report& report);
+
+private:
+    Clock::time_point lastCallback_{};  // Callback thread only
+
+    // The device may be reopened by another thread while report() runs
+    std::atomic<int> bufferFrames_{0};
+    std::atomic<int> sampleRate_{1};
+    std::atomic<int> bytesPerFrame_{1};
+    std::atomic<std::uint32_t> callbacks_{0};
+    std::atomic<std::uint32_t> underruns_{0};
+    std::atomic<std::int64_t> periodNs_{0};  // Moving average of the callback interval
+    std::atomic<int> bytesPerCallback_{0};
+};
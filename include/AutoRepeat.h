@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "Constants.h"
+
+// Held movement keys, timed from the SDL timestamps of their key down and
+// key up events instead of the OS key repeat. A press acts once at the time
+// it happened, a held left or right repeats every ARR after DAS has charged,
+// and a held soft drop repeats at a fraction of the fall interval. The game
+// loop takes the due actions with next() and applies each at its own time,
+// so repeat rates do not depend on the machine or on when the loop wakes.
+class AutoRepeat {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Key : std::uint8_t { Left, Right, SoftDrop };
+    static constexpr std::size_t KEY_COUNT = 3;
+
+    struct Settings {
+        Clock::duration das = DAS_DELAY;
+        Clock::duration arr = ARR_INTERVAL;      // Zero shifts to the wall once DAS has charged
+        int softDropFactor = SOFT_DROP_FACTOR;
+    };
+
+    // Settings from TETRIS_DAS_MS, TETRIS_ARR_MS and TETRIS_SOFT_DROP_FACTOR
+    // style strings, null or invalid ones keep their default
+    static Settings settingsFrom(const char* das, const char* arr, const char* softDropFactor);
+
+    struct Action {
+        Key key;
+        Clock::time_point at;  // When the press happened or the repeat fell due
+        bool repeat;           // From holding the key rather than pressing it
+        bool toWall;           // ARR 0: as far as the piece can go
+    };
+
+    AutoRepeat();
+    explicit AutoRepeat(Settings settings);
+
+    const Settings& settings() const { return settings_; }
+
+    // From key events, `at` is the event's own time. Presses of a key that is
+    // already down (OS repeats) are ignored.
+    void press(Key key, Clock::time_point at);
+    void release(Key key, Clock::time_point at);
+    void releaseAll();  // Focus lost, paused or the game ended: forget every key
+    bool isHeld(Key key) const { return keys_[index(key)].held; }
+
+    // The oldest action due by `now`, call until it returns nothing
+    std::optional<Action> next(Clock::time_point now, Clock::duration fallInterval);
+
+    // When the next action falls due, to bound the loop's sleep
+    std::optional<Clock::time_point> nextDue(Clock::duration fallInterval) const;
+
+    // With ARR 0 and DAS charged the piece stays against the wall, new pieces included
+    std::optional<Key> heldAgainstWall() const;
+
+    Clock::duration softDropInterval(Clock::duration fallInterval) const;
+
+private:
+    struct KeyState {
+        bool held = false;
+        bool tapPending = false;  // Pressed, and the press not yet acted on
+        Clock::time_point pressedAt{};
+        Clock::time_point nextRepeat{};  // Horizontal: DAS charge, then each ARR. Soft drop: the last drop
+    };
+
+    Settings settings_;
+    std::array<KeyState, KEY_COUNT> keys_{};
+    std::optional<Key> shifting_;  // The horizontal key that repeats, the last one pressed
+    bool charged_ = false;         // DAS of shifting_ has elapsed
+
+    static constexpr std::size_t index(Key key) { return static_cast<std::size_t>(key); }
+    static constexpr bool isHorizontal(Key key) { return key != Key::SoftDrop; }
+
+    // When `key` next acts, ignoring how late that already is
+    std::optional<Clock::time_point> dueTime(Key key, Clock::duration fallInterval) const;
+    Clock::duration repeatInterval(Key key, Clock::duration fallInterval) const;
+};
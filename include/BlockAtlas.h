@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Constants.h"
+#include "TetrominoType.h"
+
+class SoftwareRasterizer;
+
+// The seven coloured blocks, the empty grid cell and the ghost outline drawn
+// once into a single texture. Cells are queued into a batch and each layer
+// (board, active piece, ghost, preview) goes out as one SDL_RenderGeometry call.
+class BlockAtlas {
+public:
+    static constexpr int SPRITE_SIZE = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
+    static constexpr int BLOCK_SPRITE_COUNT = static_cast<int>(TetrominoType::COUNT);
+    static constexpr int EMPTY_CELL_SPRITE = BLOCK_SPRITE_COUNT;
+    static constexpr int GHOST_SPRITE = BLOCK_SPRITE_COUNT + 1;
+    static constexpr int SPRITE_COUNT = BLOCK_SPRITE_COUNT + 2;
+    static constexpr int ATLAS_WIDTH = SPRITE_COUNT * BLOCK_SIZE;  // One pixel gap between sprites
+    static constexpr int ATLAS_HEIGHT = SPRITE_SIZE;
+    static constexpr int BYTES_PER_PIXEL = 4;
+    static constexpr SDL_Color NO_TINT = {255, 255, 255, 255};
+
+    BlockAtlas() = default;
+    ~BlockAtlas();
+
+    BlockAtlas(const BlockAtlas&) = delete;
+    BlockAtlas& operator=(const BlockAtlas&) = delete;
+
+    // Upload the sprites, replacing any earlier texture. Without a texture
+    // flush() falls back to rectangles.
+    bool build(SDL_Renderer* renderer);
+    bool isBuilt() const { return texture_ != nullptr; }
+
+    static int blockSprite(TetrominoType type) { return static_cast<int>(type); }
+    static SDL_Rect spriteRect(int sprite);
+
+    // RGBA bytes of the whole atlas, ATLAS_WIDTH x ATLAS_HEIGHT
+    static std::vector<std::uint8_t> renderPixels();
+
+    // Queue a sprite with its top-left at (x, y); the tint multiplies its colour
+    void add(int sprite, int x, int y, SDL_Color tint = NO_TINT);
+    std::size_t queued() const { return quads_.size(); }
+
+    // Vertices and indices for everything queued, filled by buildGeometry()
+    void buildGeometry();
+    std::span<const SDL_Vertex> vertices() const { return vertices_; }
+    std::span<const int> indices() const { return indices_; }
+
+    // Draw everything queued and empty the batch, returns the number of draw calls
+    int flush(SDL_Renderer* renderer);
+
+    // Blend everything queued into a CPU frame and empty the batch
+    void flush(SoftwareRasterizer& raster);
+
+private:
+    struct Quad {
+        int sprite;
+        int x;
+        int y;
+        SDL_Color tint;
+    };
+
+    SDL_Texture* texture_ = nullptr;
+    bool geometrySupported_ = true;
+
+    // Reused between frames so batching does not allocate once warmed up
+    std::vector<Quad> quads_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+
+    int flushWithCopies(SDL_Renderer* renderer);
+    int flushWithRects(SDL_Renderer* renderer);
+};
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "Rules.h"
+
+// One tetromino orientation as row bitmasks (bit 0 = leftmost column of the 4x4 box)
+struct PieceMask {
+    std::array<std::uint16_t, TETROMINO_GRID_SIZE> rows;
+    int minX;    // First occupied column inside the 4x4 box
+    int maxX;    // Last occupied column inside the 4x4 box
+    int top;     // First occupied row inside the 4x4 box
+    int bottom;  // Last occupied row inside the 4x4 box
+};
+
+// Landing rows for every column of one orientation, see Board::landingRows()
+struct ColumnLandings {
+    std::uint16_t columns;                // Bit c set when a placement exists in column c
+    std::array<int, GRID_WIDTH> y;        // Resting y of the 4x4 box, valid where columns has a bit
+};
+
+constexpr PieceMask makePieceMask(const TetrominoShape& shape) {
+    PieceMask mask{{}, TETROMINO_GRID_SIZE, -1, TETROMINO_GRID_SIZE, -1};
+    for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
+        for (int x = 0; x < TETROMINO_GRID_SIZE; x++) {
+            if (shape[y][x]) {
+                mask.rows[y] |= static_cast<std::uint16_t>(1U << x);
+                mask.minX = std::min(mask.minX, x);
+                mask.maxX = std::max(mask.maxX, x);
+                mask.top = std::min(mask.top, y);
+                mask.bottom = std::max(mask.bottom, y);
+            }
+        }
+    }
+    return mask;
+}
+
+inline constexpr auto PIECE_MASKS = [] {
+    std::array<std::array<PieceMask, TETROMINO_ROTATION_COUNT>, static_cast<std::size_t>(TetrominoType::COUNT)> masks{};
+    for (std::size_t type = 0; type < masks.size(); type++) {
+        for (int rotation = 0; rotation < TETROMINO_ROTATION_COUNT; rotation++) {
+            masks[type][rotation] = makePieceMask(rotatedShape(static_cast<TetrominoType>(type), rotation));
+        }
+    }
+    return masks;
+}();
+
+// Mask for a tetromino type in a rotation, matching Tetromino::getRotatedShape()
+constexpr const PieceMask& pieceMask(TetrominoType type, int rotation) {
+    return PIECE_MASKS[static_cast<std::size_t>(type)][rotation % TETROMINO_ROTATION_COUNT];
+}
+
+// Compact bitboard copy of the playfield used by placement search and tooling.
+// Game::grid_ keeps the cell colours and Game mirrors it in a Board, so runtime
+// collision and line clears run the same code as the compile-time rules.
+// Everything except fromGrid() is constexpr so rules can be evaluated at compile time.
+class Board {
+public:
+    using Row = std::uint16_t;
+    static constexpr Row FULL_ROW = static_cast<Row>((1U << GRID_WIDTH) - 1);
+
+    constexpr Board() : rows_{} {}
+    static Board fromGrid(const std::vector<std::vector<std::optional<TetrominoType>>>& grid);
+
+    constexpr bool isOccupied(int x, int y) const {
+        if (x < 0 || x >= GRID_WIDTH || y >= GRID_HEIGHT) {
+            return true;
+        }
+
+        // Above the grid is free
+        if (y < 0) {
+            return false;
+        }
+
+        return (rows_[y] >> x) & 1U;
+    }
+
+    constexpr void setOccupied(int x, int y) { rows_[y] |= static_cast<Row>(1U << x); }
+    constexpr Row row(int y) const { return rows_[y]; }
+
+    // Collision check with the same rules as Game::isPositionFree (above the grid is free)
+    constexpr bool fits(const PieceMask& mask, int x, int y) const {
+        if (x + mask.minX < 0 || x + mask.maxX >= GRID_WIDTH) {
+            return false;
+        }
+
+        for (int r = mask.top; r <= mask.bottom; r++) {
+            int gridY = y + r;
+            if (gridY < 0) {
+                continue;
+            }
+            if (gridY >= GRID_HEIGHT || (rows_[gridY] & shiftRow(mask.rows[r], x)) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Lowest y the piece reaches when dropped straight down from (x, y)
+    constexpr int dropY(const PieceMask& mask, int x, int y) const {
+        while (fits(mask, x, y + MOVE_DOWN)) {
+            y += MOVE_DOWN;
+        }
+        return y;
+    }
+
+    // Columns are indexed by the piece's leftmost cell: bit c means box x = c - mask.minX.
+    // Bit c of legalColumns() is set when the piece fits there with its box at row y.
+    constexpr std::uint16_t legalColumns(const PieceMask& mask, int y) const {
+        // Columns where the piece stays inside the walls
+        int width = mask.maxX - mask.minX + 1;
+        auto legal = static_cast<std::uint16_t>((1U << (GRID_WIDTH - width + 1)) - 1);
+
+        for (int r = mask.top; r <= mask.bottom; r++) {
+            int gridY = y + r;
+            if (gridY < 0) {
+                continue;
+            }
+            if (gridY >= GRID_HEIGHT) {
+                return 0;
+            }
+
+            // A column is blocked if any piece cell lands on a filled cell: OR the board
+            // row shifted right by each cell offset to test all columns in one word
+            Row blocked = 0;
+            for (unsigned cells = mask.rows[r] >> mask.minX; cells != 0; cells &= cells - 1) {
+                blocked |= static_cast<Row>(rows_[gridY] >> std::countr_zero(cells));
+            }
+            legal &= static_cast<std::uint16_t>(~blocked);
+        }
+
+        return legal;
+    }
+
+    // Landing row in every column for a straight drop from startY, computed for all
+    // columns at once one row at a time
+    constexpr ColumnLandings landingRows(const PieceMask& mask, int startY) const {
+        ColumnLandings landings{legalColumns(mask, startY), {}};
+
+        std::uint16_t falling = landings.columns;
+        for (int y = startY; falling != 0; y++) {
+            std::uint16_t stillFalling = falling & legalColumns(mask, y + MOVE_DOWN);
+
+            for (unsigned landed = falling & ~stillFalling; landed != 0; landed &= landed - 1) {
+                landings.y[std::countr_zero(landed)] = y;
+            }
+            falling = stillFalling;
+        }
+
+        return landings;
+    }
+
+    // Lock a piece into the board and clear completed lines, returns lines cleared
+    constexpr int place(const PieceMask& mask, int x, int y) {
+        for (int r = mask.top; r <= mask.bottom; r++) {
+            int gridY = y + r;
+            if (gridY >= 0 && gridY < GRID_HEIGHT) {
+                rows_[gridY] |= shiftRow(mask.rows[r], x);
+            }
+        }
+        return clearLines();
+    }
+
+    constexpr int clearLines() {
+        std::uint32_t lines = fullLines();
+        removeLines(rows_, lines, Row{0});
+        return std::popcount(lines);
+    }
+
+    // Bit y set for every complete row
+    constexpr std::uint32_t fullLines() const {
+        std::uint32_t lines = 0;
+        for (int y = 0; y < GRID_HEIGHT; y++) {
+            if (rows_[y] == FULL_ROW) {
+                lines |= 1U << y;
+            }
+        }
+        return lines;
+    }
+
+    // Removes the rows set in `lines` and moves the rows above them down, with
+    // `empty` shifted in at the top. Game::grid_ is cleared through this too.
+    template <typename Rows, typename EmptyRow>
+    static constexpr void removeLines(Rows& rows, std::uint32_t lines, const EmptyRow& empty) {
+        int writeY = GRID_HEIGHT - 1;
+        for (int y = GRID_HEIGHT - 1; y >= 0; y--) {
+            if (!((lines >> y) & 1U)) {
+                if (writeY != y) {
+                    rows[writeY] = std::move(rows[y]);
+                }
+                writeY--;
+            }
+        }
+
+        for (; writeY >= 0; writeY--) {
+            rows[writeY] = empty;
+        }
+    }
+
+    constexpr int columnHeight(int x) const {
+        for (int y = 0; y < GRID_HEIGHT; y++) {
+            if ((rows_[y] >> x) & 1U) {
+                return GRID_HEIGHT - y;
+            }
+        }
+        return 0;
+    }
+
+    constexpr std::array<int, GRID_WIDTH> columnHeights() const {
+        std::array<int, GRID_WIDTH> heights{};
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            heights[x] = columnHeight(x);
+        }
+        return heights;
+    }
+
+    constexpr int holeCount() const {
+        // A hole is an empty cell with a filled cell somewhere above it
+        int holes = 0;
+        Row covered = 0;
+        for (int y = 0; y < GRID_HEIGHT; y++) {
+            holes += std::popcount(static_cast<Row>(covered & ~rows_[y]));
+            covered |= rows_[y];
+        }
+        return holes;
+    }
+
+    // Whether a new piece of this type has room at the spawn position
+    constexpr bool canSpawn(TetrominoType type) const {
+        return fits(pieceMask(type, 0), SPAWN_X, spawnY(type));
+    }
+
+    constexpr bool operator==(const Board& other) const = default;
+
+private:
+    std::array<Row, GRID_HEIGHT> rows_;
+
+    static constexpr Row shiftRow(std::uint16_t pieceRow, int x) {
+        return static_cast<Row>(x >= 0 ? pieceRow << x : pieceRow >> -x);
+    }
+};
+
+static_assert(GRID_HEIGHT <= 32, "Board::fullLines() keeps one bit per row");
+
+static_assert([] {
+    for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+        if (!Board().canSpawn(static_cast<TetrominoType>(type))) {
+            return false;
+        }
+    }
+    return true;
+}(), "Every piece must fit at the spawn position of an empty board");
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include "Constants.h"
+
+// The locked cells rendered once into a target texture and copied to the screen
+// every frame. The texture is redrawn only when the board version changes or
+// its contents were lost. Renderers without target support draw directly.
+class BoardLayer {
+public:
+    static constexpr int WIDTH = GRID_WIDTH * BLOCK_SIZE;
+    static constexpr int HEIGHT = GRID_HEIGHT * BLOCK_SIZE;
+
+    explicit BoardLayer(SDL_Renderer* renderer);
+    ~BoardLayer();
+
+    BoardLayer(const BoardLayer&) = delete;
+    BoardLayer& operator=(const BoardLayer&) = delete;
+
+    // Composite the board; redraw() paints it and is only called when needed.
+    // Returns the draw calls issued by the layer itself, not by redraw().
+    template <typename Redraw>
+    int draw(std::uint64_t version, Redraw&& redraw) {
+        if (!texture_ && !create()) {
+            redraw();
+            return 0;
+        }
+
+        int drawCalls = 0;
+        if (needsRedraw(version)) {
+            SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer_);
+            if (SDL_SetRenderTarget(renderer_, texture_) != 0) {
+                // Target became unusable, stop caching
+                disable();
+                redraw();
+                return 0;
+            }
+
+            SDL_SetRenderDrawColor(renderer_, SCREEN_CLEAR_COLOR_R, SCREEN_CLEAR_COLOR_G,
+                                   SCREEN_CLEAR_COLOR_B, SCREEN_CLEAR_COLOR_A);
+            SDL_RenderClear(renderer_);
+            drawCalls++;
+            redraw();
+            SDL_SetRenderTarget(renderer_, previousTarget);
+
+            version_ = version;
+            dirty_ = false;
+            redrawCount_++;
+        }
+
+        SDL_Rect destination = {0, 0, WIDTH, HEIGHT};
+        SDL_RenderCopy(renderer_, texture_, nullptr, &destination);
+        return drawCalls + 1;
+    }
+
+    bool needsRedraw(std::uint64_t version) const { return dirty_ || version != version_; }
+
+    // Texture contents were lost (SDL_RENDER_TARGETS_RESET)
+    void invalidate() { dirty_ = true; }
+
+    // The texture itself was lost (SDL_RENDER_DEVICE_RESET)
+    void recreate();
+
+    bool isCached() const { return texture_ != nullptr; }
+    std::uint64_t getRedrawCount() const { return redrawCount_; }
+
+private:
+    bool create();
+    void disable();
+
+    SDL_Renderer* renderer_; // Non-owning pointer
+    SDL_Texture* texture_ = nullptr;
+    bool supported_;
+    bool dirty_ = true;
+    std::uint64_t version_ = 0;
+    std::uint64_t redrawCount_ = 0;
+};
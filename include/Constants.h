@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 using namespace std::chrono_literals;
 
@@ -10,9 +12,8 @@ constexpr int GRID_WIDTH = 10;
 constexpr int GRID_HEIGHT = 20;
 constexpr int WINDOW_WIDTH = BLOCK_SIZE * (GRID_WIDTH + 6);
 constexpr int WINDOW_HEIGHT = BLOCK_SIZE * GRID_HEIGHT;
-constexpr auto INITIAL_FALL_SPEED = 500ms;
 constexpr int LINES_PER_LEVEL = 10;
-constexpr int MAX_LEVEL = 15;
+constexpr int MAX_LEVEL = 20;  // Gravity reaches 20G at level 19, see Gravity.h
 
 // Graphics constants
 constexpr int ALPHA_OPAQUE = 255;
@@ -81,12 +82,61 @@ constexpr int INITIAL_LEVEL = 1;
 // Helper value for renderer
 constexpr int RENDERER_DEFAULT_INDEX = -1;
 
-// Fall speed calculation
-constexpr double LEVEL_SPEED_FACTOR = 0.1;
+// Simulation ticks: gravity advances in whole ticks whatever the frame rate
+constexpr int SIMULATION_RATE = 60;  // Ticks per second
+constexpr std::chrono::nanoseconds SIMULATION_TICK{1'000'000'000 / SIMULATION_RATE + 1};  // Rounded up, 16.67 ms
+constexpr auto SIMULATION_MAX_CATCH_UP = 250ms;  // Ticks older than this after a stall are dropped, not replayed
+constexpr int LOCK_DELAY_TICKS = 30;  // A grounded piece locks after half a second without moving
+constexpr int LOCK_RESET_LIMIT = 15;  // Moves and rotations that restart the lock delay before it stops waiting
 
 // Font rendering
 constexpr int FONT_SIZE = 24;
+constexpr int LARGE_FONT_SIZE = FONT_SIZE * 2;
 
 // Frame timing
-constexpr auto TARGET_FRAME_TIME = 16ms;  // ~60 FPS
-constexpr int MICROSECONDS_PER_MILLISECOND = 1000;
+constexpr auto BLINK_INTERVAL = 500ms;  // "PRESS START" on the start screen
+constexpr int WAIT_FOREVER = -1;        // SDL_WaitEventTimeout without a deadline
+constexpr auto STARTUP_TARGET = 100ms;  // Launch to first presented frame
+constexpr bool PREFER_VSYNC = true;     // Let SDL_RenderPresent pace frames when the driver supports it
+// SDL's render API is only safe on the thread that pumps events on every
+// backend, so presenting from a thread of its own is TETRIS_RENDER_THREAD=1
+constexpr bool USE_RENDER_THREAD = false;
+
+// Held keys, timed by AutoRepeat from SDL event timestamps rather than OS key repeat
+constexpr auto DAS_DELAY = 133ms;          // Delayed auto-shift: hold this long before repeats start, TETRIS_DAS_MS
+constexpr auto ARR_INTERVAL = 33ms;        // Auto-repeat rate once DAS has charged, 0 moves straight to the wall, TETRIS_ARR_MS
+constexpr int SOFT_DROP_FACTOR = 20;       // Held soft drop falls this many times faster than gravity, TETRIS_SOFT_DROP_FACTOR
+constexpr auto AUTO_REPEAT_MAX_LAG = 100ms;  // Repeats older than this after a stall are skipped, not replayed
+
+// Trace zones (Trace.h), compiled in with the TETRIS_TRACING CMake option
+constexpr std::size_t TRACE_RING_SIZE = 1 << 15;  // Newest zones kept per thread, a power of two
+constexpr const char* TRACE_DEFAULT_FILE = "tetris-trace.json";  // Unless TETRIS_TRACE names one
+
+// Frame-timing HUD
+constexpr int HUD_X = 10;
+constexpr int HUD_Y = 10;
+constexpr int HUD_WIDTH = 380;
+constexpr int HUD_LINE_HEIGHT = 26;
+constexpr int HUD_BACKGROUND_ALPHA = 200;
+constexpr int HUD_LINE_LENGTH = 64;
+constexpr auto HUD_REFRESH_INTERVAL = 250ms;  // Longest an open HUD goes without new numbers, even when idle
+
+// Audio output, sounds in the asset archive are stored in this format
+constexpr int AUDIO_SAMPLE_RATE = 44100;
+constexpr int AUDIO_CHANNELS = 2;
+constexpr int AUDIO_CHUNK_SIZE = 2048;  // Sample frames per mixer callback, the largest buffer we back off to
+constexpr int AUDIO_MIN_CHUNK_SIZE = 256;
+constexpr int AUDIO_LOW_LATENCY_CHUNK_SIZE = 512;  // ~12 ms, TETRIS_AUDIO_BUFFER=256..2048 overrides
+constexpr bool AUDIO_LOW_LATENCY = true;
+constexpr int AUDIO_UNDERRUN_LIMIT = 3;  // Underruns on one buffer size before doubling it
+constexpr std::uint32_t AUDIO_CALIBRATION_CALLBACKS = 32;  // Callbacks measured before the latency is reported
+constexpr int SOUND_QUEUE_SIZE = 64;    // Sound events one frame can queue before extras are dropped
+constexpr bool SYNTHESIZE_MISSING_SOUNDS = true;  // SoundSynth fills in for WAVs that are not there
+
+// Background music, streamed from music/*.wav in the asset archive
+constexpr int MUSIC_RING_SAMPLES = 32768;  // ~370 ms of 44.1 kHz stereo between the decode thread and the mixer
+constexpr int MUSIC_DECODE_FRAMES = 1024;  // Frames rendered per step of the decode thread
+constexpr auto MUSIC_DECODE_INTERVAL = 20ms;  // Decode thread sleep while the ring is full
+constexpr int MUSIC_VOLUME = 48;           // Of MIX_MAX_VOLUME, under the effects
+constexpr int MUSIC_LEVELS_PER_TRACK = 5;  // Levels before the next track
+constexpr double MUSIC_TEMPO_STEP = 0.04;  // Faster by this much each level within a track
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include "Board.h"
+#include "PlacementGenerator.h"
+
+// Single key presses as the game interprets them. A held left or right
+// (DAS, AutoRepeat) is one press that shifts the piece to the wall.
+enum class FinesseInput : std::uint8_t {
+    MoveLeft,
+    MoveRight,
+    Rotate,
+    SoftDrop,
+    HardDrop,
+    DasLeft,
+    DasRight
+};
+
+constexpr int FINESSE_MAX_INPUTS = 32;
+
+struct FinesseSequence {
+    std::array<FinesseInput, FINESSE_MAX_INPUTS> inputs{};
+    int length = 0;
+
+    // Presses that count towards finesse: moves, shifts and rotations, not drops
+    constexpr int movementCount() const {
+        int count = 0;
+        for (int i = 0; i < length; i++) {
+            if (inputs[i] != FinesseInput::SoftDrop && inputs[i] != FinesseInput::HardDrop) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+// Shortest key sequences from spawn to a placement, under the movement rules
+// of TetrominoManager and the kicks of Tetromino::rotate.
+class Finesse {
+public:
+    // Compile-time sequence for an empty board; length is 0 if the placement
+    // cannot be reached. x is the 4x4 box column, as in Tetromino::x().
+    static const FinesseSequence& emptyBoardSequence(TetrominoType type, int rotation, int x);
+
+    // Uses the table when its sequence still works on this board, otherwise
+    // searches the board (including soft drops for tucks)
+    static std::optional<FinesseSequence> sequenceFor(const Board& board, const Placement& placement);
+
+    // Breadth-first search over (x, y, rotation) on an obstructed board
+    static std::optional<FinesseSequence> search(const Board& board, const Placement& placement);
+
+    // Plays a sequence from spawn and returns where the piece locks
+    static std::optional<Placement> simulate(const Board& board, TetrominoType type, const FinesseSequence& sequence);
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include <map>
+#include <span>
+#include <string>
+#include <utility>
+
+// Owns every open font. Each (face file, point size) pair is opened once and
+// the handle is reused, so drawing never touches the filesystem. Failed opens
+// are remembered too, so a missing size is not retried every frame.
+class FontManager {
+public:
+    FontManager() = default;
+    virtual ~FontManager();
+
+    FontManager(const FontManager&) = delete;
+    FontManager& operator=(const FontManager&) = delete;
+
+    // Opens the first candidate that loads at this size and remembers its path
+    // as the face for get(size)
+    bool resolve(std::span<const char* const> candidates, int size);
+
+    // Same, but first tries the face remembered in cacheFile by an earlier
+    // run and remembers the one found for the next
+    bool resolve(std::span<const char* const> candidates, int size, const std::string& cacheFile);
+
+    // Use a face held in memory (an asset archive entry), name stands in for
+    // its path. The bytes must stay valid until closeAll().
+    bool resolveMemory(const std::string& name, std::span<const std::byte> data, int size);
+
+    // Cached handle for the resolved face at a point size, nullptr if it cannot be opened
+    TTF_Font* get(int size);
+    TTF_Font* get(const std::string& path, int size);
+
+    const std::string& getPath() const { return path_; }
+    bool isResolved() const { return !path_.empty(); }
+    std::size_t openCount() const;
+
+    // Close every font; must run before TTF_Quit
+    void closeAll();
+
+protected:
+    // Made virtual for testing
+    virtual TTF_Font* openFont(const std::string& path, int size);
+    virtual TTF_Font* openFontMemory(std::span<const std::byte> data, int size);
+    virtual void closeFont(TTF_Font* font);
+
+private:
+    std::string path_;
+    std::span<const std::byte> memory_;  // Face data when path_ names a memory font
+    std::map<std::pair<std::string, int>, TTF_Font*> fonts_;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <chrono>
+#include "FrameStats.h"
+
+// Presents frames on a grid of the display's refresh interval. Without vsync
+// it sleeps with SDL_Delay until shortly before the slot and spins for the
+// rest, with vsync SDL_RenderPresent does the waiting. Either way the time
+// between presents is recorded for mean/variance/p99 reporting.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int DEFAULT_REFRESH_RATE = 60;
+    static constexpr auto SPIN_MARGIN = std::chrono::microseconds(1500);  // SDL_Delay oversleeps by up to ~1ms
+    static constexpr int IDLE_FRAMES = 4;  // Longer gaps between presents are idle time, not frame time
+
+    explicit FramePacer(int refreshRate = DEFAULT_REFRESH_RATE, bool vsync = false);
+    virtual ~FramePacer() = default;
+
+    // Refresh rate of the display the window is on, DEFAULT_REFRESH_RATE if unknown
+    static int detectRefreshRate(SDL_Window* window);
+
+    void setRefreshRate(int refreshRate);
+    int getRefreshRate() const { return refreshRate_; }
+    void setVSync(bool vsync) { vsync_ = vsync; }
+    bool hasVSync() const { return vsync_; }
+    Clock::duration frameInterval() const { return interval_; }
+
+    // Block until the next frame slot, returns immediately with vsync or after idle
+    void waitForNextFrame();
+
+    // Record the present that just completed and schedule the next slot
+    void framePresented();
+
+    const FrameStats& stats() const { return stats_; }
+
+protected:
+    // Made virtual for testing
+    virtual Clock::time_point now() const { return Clock::now(); }
+    virtual void sleepFor(Clock::duration duration);
+    virtual void spinUntil(Clock::time_point deadline);
+
+private:
+    int refreshRate_;
+    bool vsync_;
+    Clock::duration interval_;
+    Clock::time_point nextFrame_{};
+    Clock::time_point lastPresent_{};
+    bool presented_ = false;
+    FrameStats stats_;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include "FrameStats.h"
+
+// Phases of one pass through Game::run, rendering split by layer
+enum class FramePhase {
+    Input,
+    Update,
+    InputLag,  // Key press to the game acting on it, not a pass through the loop
+    Board,
+    Pieces,
+    Sidebar,
+    Overlay,  // Start, pause and game over screens
+    Hud,
+    Present,
+    COUNT
+};
+
+// Rolling timings for each frame phase plus the draw calls and texture
+// uploads of the last rendered frame, shown by the frame-timing HUD.
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(FramePhase::COUNT);
+
+    // Records the time from construction to destruction against a phase
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, FramePhase phase)
+            : profiler_(profiler), phase_(phase), start_(Clock::now()) {}
+        ~Scope() { profiler_.record(phase_, Clock::now() - start_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler& profiler_;
+        FramePhase phase_;
+        Clock::time_point start_;
+    };
+
+    Scope measure(FramePhase phase) { return Scope(*this, phase); }
+    void record(FramePhase phase, Clock::duration duration);
+
+    const FrameStats& phase(FramePhase phase) const { return phases_[static_cast<std::size_t>(phase)]; }
+    static const char* phaseName(FramePhase phase);
+
+    // Recorded by the simulation; the rest are recorded where frames are drawn
+    static constexpr bool isSimulationPhase(FramePhase phase) {
+        return phase == FramePhase::Input || phase == FramePhase::Update || phase == FramePhase::InputLag;
+    }
+
+    void setFrameCounts(int drawCalls, int textureUploads);
+    int getDrawCalls() const { return drawCalls_; }
+    int getTextureUploads() const { return textureUploads_; }
+
+private:
+    std::array<FrameStats, PHASE_COUNT> phases_;
+    int drawCalls_ = 0;
+    int textureUploads_ = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "AudioLatencyMonitor.h"
+#include "FrameProfiler.h"
+#include "FrameStats.h"
+#include "GameState.h"
+#include "Tetromino.h"
+
+class Game;
+class TetrominoManager;
+
+// Everything one frame shows, copied out of the game by the simulation so
+// the renderer never reads live game state. Snapshots are reused: capturing
+// into one that already holds a board does not allocate.
+struct FrameSnapshot {
+    using Grid = std::vector<std::vector<std::optional<TetrominoType>>>;
+    using Percentiles = std::array<FrameStats::Duration, 3>;  // p50, p95, p99
+
+    std::uint64_t sequence = 0;
+    GameState state = GameState::StartScreen;
+    Grid grid;
+    std::uint64_t boardVersion = 0;
+    std::optional<Tetromino> piece;
+    std::optional<Tetromino> ghost;  // Landing position, empty when the piece already rests there
+    TetrominoType next = TetrominoType::I;
+    int score = 0;
+    int level = 0;
+    int lines = 0;
+    int finesseFaults = 0;
+    bool blinkOn = false;
+
+    // Filled in by Game rather than capture()
+    bool hudVisible = false;
+    std::uint64_t renderResets = 0;  // Running counts, the renderer handles each new one once
+    std::uint64_t deviceResets = 0;
+    int refreshRate = 0;
+    std::array<Percentiles, FrameProfiler::PHASE_COUNT> simulationTimings{};  // Simulation phases, HUD only
+    AudioLatencyMonitor::Report audio;  // HUD only
+
+    void capture(const Game& game, const TetrominoManager& tetrominoManager, Uint32 ticks);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// The most recent CAPACITY durations in a fixed ring buffer. Adding a sample
+// never allocates, the summary functions work on the window only.
+class FrameStats {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    static constexpr std::size_t CAPACITY = 256;
+
+    void add(Duration sample);
+    void reset();
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    Duration last() const;
+
+    Duration mean() const;
+    Duration max() const;
+    double variance() const;  // In squared milliseconds
+    double stddev() const;    // In milliseconds
+
+    // Nearest-rank percentile, p in [0, 100]
+    Duration percentile(double p) const;
+
+private:
+    std::array<Duration, CAPACITY> samples_{};
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+};
@@ -8,10 +8,22 @@
 #include <random>
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include "AssetArchive.h"
+#include "AutoRepeat.h"
+#include "Board.h"
 #include "TetrominoManager.h"
 #include "InputHandler.h"
 #include "GameRenderer.h"
 #include "SoundManager.h"
+#include "FontManager.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+#include "FrameSnapshot.h"
+#include "Gravity.h"
+#include "RenderThread.h"
+#include "StartupProfiler.h"
+#include "Trace.h"
 #include "GameState.h"
 #include "Constants.h"
 
@@ -30,23 +42,71 @@ public:
     virtual int getScore() const { return score_; }
     virtual int getLevel() const { return level_; }
     virtual int getLinesCleared() const { return linesCleared_; }
+    virtual int getFinesseFaults() const { return finesseFaults_; }
+    virtual std::uint64_t getBoardVersion() const { return boardVersion_; }
     
     // Game state modifiers
-    virtual void startGame() { gameState_ = GameState::Playing; }
+    virtual void startGame() { 
+        gameState_ = GameState::Playing; 
+        autoRepeat_.releaseAll();
+    }
     virtual void pauseGame() { 
         if (gameState_ == GameState::Playing) { 
             gameState_ = GameState::Paused; 
         } else if (gameState_ == GameState::Paused) {
             gameState_ = GameState::Playing;
 }
+        autoRepeat_.releaseAll();  // Keys let go while paused never send their key up to us
     }
     virtual void resetGame();
     virtual void setGameOver() { 
         gameState_ = GameState::GameOver; 
+        autoRepeat_.releaseAll();
         playGameOverSound(); 
+        soundManager_->pauseMusic();
     }
     virtual void increaseScore(int points) { score_ += points; }
     virtual void incrementLinesCleared(int lines); 
+    virtual void addFinesseFault() { finesseFaults_++; }
+    virtual void markBoardChanged() {  // Locked cells in grid_ changed
+        boardVersion_++;
+        board_ = Board::fromGrid(grid_);
+    }
+    virtual void resetGravity() { gravity_.reset(); }  // A new piece spawned, however the last one locked
+    
+    // Render targets or the whole device were lost and must be redrawn
+    virtual void handleRenderReset(bool deviceReset);
+    
+    // The window needs repainting although no game state changed (expose, resize)
+    virtual void requestRedraw();
+    
+    // The window moved to a display that may have a different refresh rate
+    virtual void handleDisplayChanged();
+    
+    // Show or hide the frame-timing HUD
+    virtual void toggleHud();
+    bool isHudVisible() const { return hudVisible_; }
+    
+    // Start recording trace zones, or stop and write them as Chrome trace JSON
+    virtual void toggleTrace();
+    
+    // A key press with this SDL timestamp has just been acted on
+    void recordInputLatency(Uint32 eventTimestamp);
+    void recordInputLatency(std::chrono::steady_clock::duration latency);
+    
+    // Held movement keys, fed by InputHandler and applied in updateGameState
+    AutoRepeat& autoRepeat() { return autoRepeat_; }
+    
+    // Applies the held key moves due by `at` now, so a key that acts at once
+    // (rotate, hard drop) comes after the moves pressed before it
+    void applyPendingInput(std::chrono::steady_clock::time_point at);
+    
+    // How long the main loop may block waiting for input, in milliseconds:
+    // until the next gravity step while playing, the next blink toggle on the
+    // start screen, otherwise WAIT_FOREVER; never longer than
+    // HUD_REFRESH_INTERVAL while the HUD is open
+    static int eventWaitTimeout(GameState state, std::chrono::steady_clock::duration untilFall, Uint32 ticks,
+                                bool hudVisible);
     
     // Sound methods
     virtual void playMoveSound() { soundManager_->playSound(SoundEffect::Move); }
@@ -71,22 +131,55 @@ protected:
     int score_;
     int level_;
     int linesCleared_;
+    int finesseFaults_;  // Pieces placed with more inputs than the minimal sequence
+    std::uint64_t boardVersion_;
+    Board board_;  // Occupancy of grid_, rebuilt by markBoardChanged() for collision checks
+    AutoRepeat autoRepeat_;
+    Gravity gravity_;
 
 private:
+    StartupProfiler startup_;  // Clock starts as the game is constructed
+    
     // SDL Resources
     std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)> window_;
     std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> renderer_;
-    std::unique_ptr<TTF_Font, decltype(&TTF_CloseFont)> font_;
+    AssetArchive assets_;  // Packed fonts and sounds, mapped for the whole run
+    FontManager fontManager_;
+    FramePacer framePacer_;
+    FrameProfiler profiler_;
+    RenderBackend renderBackend_ = RenderBackend::Sdl;
+    int refreshRate_ = FramePacer::DEFAULT_REFRESH_RATE;
+    bool glContext_ = false;  // The renderer draws through OpenGL
+    
+    // Frames go from the simulation to the renderer as snapshots, drawn
+    // inline or handed to the render thread
+    std::unique_ptr<RenderThread> renderThread_;
+    FrameSnapshot snapshot_;  // Inline drawing only
+    std::optional<FrameKey> lastFrame_;
+    std::uint64_t frameSequence_ = 0;
+    bool redrawRequested_ = true;
+    bool hudVisible_ = false;
+    std::string tracePath_ = TRACE_DEFAULT_FILE;
+    std::uint64_t renderResets_ = 0;
+    std::uint64_t deviceResets_ = 0;
     
     // Initialization methods
     void initSDL();
+    void openAssets();
     void loadFont();
     
     // Game loop methods
     void updateGameState(const std::chrono::steady_clock::time_point& currentTime, 
-                         std::chrono::steady_clock::time_point& lastFallTime);
-    void capFrameRate(std::chrono::steady_clock::time_point& lastFrameTime);
+                         std::chrono::steady_clock::time_point& lastTickTime);
+    void applyGravity();  // One simulation tick: gravity, then lock delay
+    void waitForEvents(const std::chrono::steady_clock::time_point& lastTickTime);
+    void applyInput(const AutoRepeat::Action& action, std::chrono::steady_clock::time_point now);
+    
+    // Rendering
+    void startRenderThread();
+    void publishFrame();  // Capture and draw a snapshot if anything visible changed
+    void drawFrame(const FrameSnapshot& snapshot);
     
     // Game mechanics
-    std::chrono::milliseconds getFallSpeed() const;
+    std::chrono::nanoseconds getFallSpeed() const;  // Average time per row at this level
 };
@@ -2,30 +2,69 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include "Constants.h"
 #include "Renderer.h"
+#include "Tetromino.h"
+#include "FontManager.h"
+#include "FrameProfiler.h"
+#include "FrameSnapshot.h"
+#include "RenderCommand.h"
 #include "GameState.h"
 
 class Game;
 class TetrominoManager;
 
+// Everything the current screen depends on, a frame is only drawn when it changes
+struct FrameKey {
+    GameState state;
+    std::uint64_t boardVersion;
+    std::optional<Tetromino> piece;
+    TetrominoType next;
+    int score;
+    int level;
+    int lines;
+    int finesseFaults;
+    bool blinkOn;
+
+    bool operator==(const FrameKey&) const = default;
+};
+
+// Turns frame snapshots into a command list and draws it. Nothing here
+// touches the live game, so it can run on the simulation thread or on a
+// render thread of its own.
 class GameRenderer {
 public:
-    GameRenderer(Game& game, TetrominoManager& tetrominoManager, 
-                SDL_Renderer* renderer, TTF_Font* font);
+    GameRenderer(SDL_Renderer* renderer, FontManager& fonts, FrameProfiler& profiler,
+                 RenderBackend backend = RenderBackend::Sdl);
+    
+    // Draw and present one frame, on the thread that owns the SDL renderer
+    void render(const FrameSnapshot& snapshot);
+    
+    // The frame as draw commands grouped by layer, no renderer needed
+    static void buildCommands(const FrameSnapshot& snapshot, RenderCommandList& commands);
+    
+    static FrameKey frameKey(const Game& game, const TetrominoManager& tetrominoManager, Uint32 ticks);
+    
+    // Start screen blink phase and milliseconds until it next flips
+    static bool blinkOn(Uint32 ticks) { return (ticks / BLINK_INTERVAL.count()) % 2 == 0; }
+    static Uint32 untilBlinkToggle(Uint32 ticks) { return BLINK_INTERVAL.count() - ticks % BLINK_INTERVAL.count(); }
     
-    // Main rendering method
-    void render();
+    const Renderer& getRenderer() const { return *renderer_; }
     
 private:
-    Game& game_;
-    TetrominoManager& tetrominoManager_;
     std::unique_ptr<Renderer> renderer_;
+    FrameProfiler& profiler_;
+    RenderCommandList commands_;
+    std::uint64_t renderResets_ = 0;  // Reset counts already handled
+    std::uint64_t deviceResets_ = 0;
+    Uint32 presentDelay_ = 0;  // TETRIS_SLOW_PRESENT_MS, stretches every present for latency testing
     
-    // Helper rendering methods
-    void renderStartScreen();
-    void renderGame();
-    void renderPauseScreen();
-    void renderGameOver();
+    void execute(const FrameSnapshot& snapshot);
+    void draw(const FrameSnapshot& snapshot, const RenderCommand& command);
+    void drawValue(TextId label, int value, int x, int y);
+    void recordFrameCounts();
+    void renderHud(const FrameSnapshot& snapshot);
 };
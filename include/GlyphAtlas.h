@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class SoftwareRasterizer;
+
+// All glyphs the HUD needs (printable ASCII and the arrows in the sidebar)
+// rasterised once into one texture. Strings are laid out with per-glyph advance
+// and kerning and drawn as one SDL_RenderGeometry call, so text that changes
+// every frame (score, level, lines) never creates a surface or texture.
+class GlyphAtlas {
+public:
+    static constexpr char32_t FIRST_ASCII = U' ';
+    static constexpr char32_t LAST_ASCII = U'~';
+    static constexpr char32_t FIRST_ARROW = U'\u2190';  // LEFTWARDS ARROW
+    static constexpr char32_t LAST_ARROW = U'\u2193';   // DOWNWARDS ARROW
+    static constexpr int GLYPH_COUNT = (LAST_ASCII - FIRST_ASCII + 1) + (LAST_ARROW - FIRST_ARROW + 1);
+    static constexpr int ATLAS_WIDTH = 512;
+    static constexpr int GLYPH_PADDING = 1;
+    static constexpr int VERTICES_PER_GLYPH = 4;
+    static constexpr int INDICES_PER_GLYPH = 6;
+
+    struct Glyph {
+        SDL_Rect source;  // Where the glyph sits in the atlas
+        int advance;
+        bool present;
+    };
+
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Rasterise every glyph of the font into a single texture, replacing any earlier one.
+    // Without a renderer the atlas is kept as CPU pixels for the software rasteriser.
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    bool isBuilt() const { return texture_ != nullptr || !pixels_.empty(); }
+
+    // Builds the vertices and indices for a string with its top-left at (x, y).
+    // Glyphs missing from the atlas are skipped. Returns the width of the string.
+    int layout(std::string_view text, int x, int y, SDL_Color color);
+    std::span<const SDL_Vertex> vertices() const { return vertices_; }
+    std::span<const int> indices() const { return indices_; }
+
+    // Lay out and draw a string in one draw call, false if nothing could be drawn
+    bool draw(SDL_Renderer* renderer, std::string_view text, int x, int y, SDL_Color color);
+    bool draw(SoftwareRasterizer& raster, std::string_view text, int x, int y, SDL_Color color);
+
+    static std::optional<int> glyphIndex(char32_t codepoint);
+
+protected:
+    // Made protected for testing layout without a font
+    void setGlyph(char32_t codepoint, const Glyph& glyph);
+    void setKerning(char32_t previous, char32_t codepoint, int kerning);
+    void setAtlasSize(int width, int height);
+
+private:
+    std::array<Glyph, GLYPH_COUNT> glyphs_{};
+    std::vector<std::int8_t> kerning_ = std::vector<std::int8_t>(GLYPH_COUNT * GLYPH_COUNT);
+    SDL_Texture* texture_ = nullptr;
+    std::vector<std::uint32_t> pixels_;  // ARGB8888 atlas, software rasteriser only
+    int atlasWidth_ = 0;
+    int atlasHeight_ = 0;
+    bool geometrySupported_ = true;
+
+    // Reused between calls so drawing does not allocate once warmed up
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+
+    // Calls visit(glyph, penX) for each glyph in the atlas, returns the final pen position
+    template <typename Visitor>
+    int forEachGlyph(std::string_view text, int x, Visitor&& visit) const;
+
+    void drawWithCopies(SDL_Renderer* renderer, std::string_view text, int x, int y, SDL_Color color);
+};
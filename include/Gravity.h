@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "Constants.h"
+
+// Gravity in fixed-point rows per simulation tick. Every tick adds the
+// level's rate to an accumulator and the whole rows in it fall, so the
+// speed is the same at any frame rate and a tick costs the same at any
+// level. From 20G (GRID_HEIGHT rows a tick) a piece reaches the floor in
+// the tick it appears.
+class Gravity {
+public:
+    using Fixed = std::uint32_t;  // Rows per tick, 16.16
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr Fixed ONE_ROW = Fixed{1} << FRACTION_BITS;
+    static constexpr Fixed TWENTY_G = GRID_HEIGHT * ONE_ROW;
+
+    // Seconds per row are (0.8 - (level - 1) * 0.007) ^ (level - 1), the
+    // modern guideline curve: one row a second at level 1, 20G at 19
+    static constexpr std::array<Fixed, MAX_LEVEL + 1> TABLE = [] {
+        std::array<Fixed, MAX_LEVEL + 1> table{};
+        for (int level = INITIAL_LEVEL; level <= MAX_LEVEL; level++) {
+            double base = 0.8 - (level - 1) * 0.007;
+            double secondsPerRow = 1.0;
+            for (int i = 1; i < level; i++) {
+                secondsPerRow *= base;
+            }
+            double rate = ONE_ROW / (secondsPerRow * SIMULATION_RATE);
+            table[level] = rate >= TWENTY_G ? TWENTY_G : static_cast<Fixed>(rate);
+        }
+        table[0] = table[INITIAL_LEVEL];
+        return table;
+    }();
+
+    static constexpr Fixed rowsPerTick(int level) {
+        return TABLE[std::clamp(level, INITIAL_LEVEL, MAX_LEVEL)];
+    }
+
+    // Average time per row, less than a tick above 1G
+    static std::chrono::nanoseconds rowInterval(int level);
+
+    // One tick: the whole rows the piece should fall, GRID_HEIGHT at 20G
+    int step(int level);
+
+    // Ticks until step() next returns a row, at least 1
+    int ticksUntilRow(int level) const;
+
+    // A new piece starts without the fraction the last one built up
+    void reset() { accumulated_ = 0; }
+
+private:
+    Fixed accumulated_ = 0;  // Below ONE_ROW between steps
+};
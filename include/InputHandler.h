@@ -1,7 +1,10 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include "AutoRepeat.h"
 #include "GameState.h"
 
 class Game;
@@ -14,12 +17,22 @@ public:
     // Event handling
     bool processEvents();
     
+    // The steady clock time of an SDL event timestamp, given SDL_GetTicks()
+    // and the steady clock read at the same moment
+    static std::chrono::steady_clock::time_point eventTime(Uint32 timestamp, Uint32 ticks,
+                                                            std::chrono::steady_clock::time_point now);
+    
+    // Keys whose hold repeats through AutoRepeat rather than the OS
+    static std::optional<AutoRepeat::Key> heldKey(SDL_Keycode key);
+    
 private:
     Game& game_;
     TetrominoManager& tetrominoManager_;
     bool quit_;
     
     // Input processing
+    static bool windowNeedsRedraw(Uint8 windowEvent);
+    void handleHeldKey(const SDL_KeyboardEvent& event, AutoRepeat::Key key);
     void handleKeyPress(SDL_Keycode key);
     void handleStartScreenInput(SDL_Keycode key);
     void handlePlayingInput(SDL_Keycode key);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Constants.h"
+
+// Lock delay with move reset, counted in simulation ticks only. A piece on
+// the ground locks after LOCK_DELAY_TICKS grounded ticks. A move or rotation
+// after it has touched down starts the delay again, LOCK_RESET_LIMIT times;
+// after that it locks as soon as it is on the ground. Reaching a row lower
+// than any before gives the resets back. Nothing here reads a clock, so the
+// same ticks and inputs always lock on the same tick.
+class LockDelay {
+public:
+    // A new piece, spawned with its box at `y`
+    void reset(int y);
+
+    // The piece moved sideways or rotated
+    void onMove();
+
+    // The piece is now at `y`, after falling or being kicked
+    void onFall(int y);
+
+    // One simulation tick. `grounded` comes from the drop distance cache.
+    // Returns true when the piece must lock now.
+    bool tick(bool grounded);
+
+    // Ticks left before a grounded piece locks
+    int ticksLeft() const;
+
+    int resets() const { return resets_; }
+
+private:
+    int groundedTicks_ = 0;  // Since touching down or the last reset
+    int resets_ = 0;
+    int lowestY_ = 0;
+    bool touchedDown_ = false;  // On the ground at some tick since reaching lowestY_
+};
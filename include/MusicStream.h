@@ -0,0 +1,94 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Constants.h"
+#include "MappedFile.h"
+#include "SpscQueue.h"
+#include "WavDecoder.h"
+
+// Background music. A decode thread turns the current track into device
+// samples a block at a time and writes them into a fixed ring, the mixer's
+// music hook (mix) copies them out. Memory use does not depend on track
+// length, tracks are read from the asset archive mapping or mapped files,
+// and the game only ever stores to atomics, so nothing here can hold up a
+// frame. Tracks loop without a gap: the decoder rewinds in the middle of a
+// block and the resampler carries on.
+class MusicStream {
+public:
+    struct Selection {
+        std::size_t track;
+        double tempo;  // Playback speed, 1 is as recorded
+    };
+
+    // Tracks change every MUSIC_LEVELS_PER_TRACK levels and get faster in between
+    static Selection forLevel(int level, std::size_t trackCount);
+
+    MusicStream() = default;
+    ~MusicStream();
+
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+
+    // Before start(): WAV data that outlives the stream, or a file to map
+    bool addTrack(std::span<const std::byte> wav);
+    bool addTrackFile(const std::string& path);
+    std::size_t trackCount() const { return tracks_.size(); }
+
+    // Output format of the device, before start()
+    void setOutput(int sampleRate, int channels);
+    void start();
+    void stop();
+
+    // Any thread, never blocks. Level 0 pauses.
+    void play(int level) { level_.store(level, std::memory_order_relaxed); }
+    void pause() { play(0); }
+    void setMuted(bool muted) { muted_.store(muted, std::memory_order_relaxed); }
+
+    // Mix_HookMusic callback, fills `stream` from the ring, silence when it runs dry
+    static void mix(void* musicStream, Uint8* stream, int length);
+
+    // Decode thread: the next device samples of the current track at the
+    // current tempo, always whole frames. Public for testing.
+    std::size_t render(std::span<std::int16_t> out);
+
+    std::uint64_t underflows() const { return underflows_.load(std::memory_order_relaxed); }
+
+private:
+    using Frame = std::array<std::int32_t, 2>;  // Left, right
+
+    std::vector<WavDecoder> tracks_;
+    std::vector<std::unique_ptr<MappedFile>> files_;
+    int outputRate_ = AUDIO_SAMPLE_RATE;
+    int outputChannels_ = AUDIO_CHANNELS;
+
+    SpscQueue<std::int16_t, MUSIC_RING_SAMPLES> ring_;
+    std::thread decoder_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> level_{0};
+    std::atomic<bool> muted_{false};
+    std::atomic<std::uint64_t> underflows_{0};
+
+    // Decode thread only
+    int playingLevel_ = 0;
+    WavDecoder* track_ = nullptr;
+    double step_ = 1.0;  // Input frames per output frame
+    double phase_ = 0.0;
+    Frame previous_{};
+    Frame current_{};
+    std::array<std::int16_t, MUSIC_DECODE_FRAMES * WavDecoder::MAX_CHANNELS> input_{};
+    std::size_t inputSize_ = 0;
+    std::size_t inputRead_ = 0;
+
+    void run();
+    void select(int level);
+    Frame nextFrame();
+};
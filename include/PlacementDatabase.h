@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "PlacementGenerator.h"
+
+// On-disk layout (native endianness). The file is a header followed by
+// records sorted by key, so a reader can binary-search the mapping directly.
+struct PlacementDatabaseHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t maxStep;       // Largest column height difference encoded in a surface signature
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+    std::uint64_t recordCount;
+};
+
+struct PlacementRecord {
+    std::uint32_t key;       // PlacementDatabase::makeKey(surface, piece, next)
+    std::uint8_t rotation;
+    std::int8_t x;
+    std::uint16_t reserved;
+};
+
+static_assert(sizeof(PlacementDatabaseHeader) == 32, "Placement database header layout changed");
+static_assert(sizeof(PlacementRecord) == 8, "Placement database record layout changed");
+
+// Precomputed best placements keyed by (top surface, piece, next piece).
+// The surface is the list of neighbouring column height differences, so the
+// answer does not depend on how high the stack is or on holes beneath it.
+class PlacementDatabase {
+public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr int DEFAULT_MAX_STEP = 1;
+    static constexpr int MAX_SUPPORTED_STEP = 3;  // Keeps keys within 32 bits
+
+    // Signature of the board surface, or nothing if a step exceeds maxStep
+    static std::optional<std::uint32_t> surfaceSignature(const Board& board, int maxStep);
+    static std::uint32_t surfaceCount(int maxStep);
+
+    // Smallest hole-free board with the given surface, used by the generator.
+    // Nothing if the surface is taller than the playfield, which only larger
+    // steps can produce; those signatures get no record.
+    static std::optional<Board> surfaceBoard(std::uint32_t signature, int maxStep);
+
+    static std::uint32_t makeKey(std::uint32_t signature, TetrominoType piece, TetrominoType next);
+
+    // Sorts the records and writes a database file
+    static bool write(const std::string& path, int maxStep, std::vector<PlacementRecord> records);
+
+    // Maps a database file; only the header is validated, records are used in place
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return records_ != nullptr; }
+
+    std::size_t size() const { return recordCount_; }
+    int maxStep() const { return maxStep_; }
+
+    // O(log n) lookup; the landing row is resolved against the actual board
+    std::optional<Placement> lookup(const Board& board, TetrominoType piece, TetrominoType next) const;
+
+private:
+    MappedFile file_;
+    const PlacementRecord* records_ = nullptr;
+    std::size_t recordCount_ = 0;
+    int maxStep_ = 0;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+#include "Board.h"
+#include "TetrominoType.h"
+
+// A resting position for a piece: rotation and top-left of its 4x4 box
+struct Placement {
+    TetrominoType type;
+    int rotation;
+    int x;
+    int y;
+
+    bool operator==(const Placement& other) const = default;
+};
+
+// Upper bound on placements of one piece: every rotation in every column
+constexpr int MAX_PLACEMENTS = TETROMINO_ROTATION_COUNT * GRID_WIDTH;
+
+// Enumerates hard-drop placements (straight drop from the top, no tucks or spins)
+class PlacementGenerator {
+public:
+    static std::vector<Placement> generate(const Board& board, TetrominoType type);
+
+    // Appends to caller storage instead, so search code can keep it in an arena
+    static void generate(const Board& board, TetrominoType type, std::pmr::vector<Placement>& placements);
+
+    // Reference version testing each (rotation, x) separately; kept for tests and perft
+    static std::vector<Placement> generateByColumn(const Board& board, TetrominoType type);
+
+    // Rotations that produce a distinct shape (O has one, I/S/Z have two)
+    static const std::vector<int>& distinctRotations(TetrominoType type);
+};
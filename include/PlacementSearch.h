@@ -0,0 +1,23 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include "PlacementGenerator.h"
+
+// Searches over hard-drop placements. Working memory comes from the calling
+// thread's SearchArena, which is reset at the start of every search, so after
+// the first search on a thread no search touches the global allocator.
+class PlacementSearch {
+public:
+    // Heuristic value of a board after a placement, higher is better
+    static int evaluate(const Board& board, int linesCleared);
+
+    // Best placement of current, judged by the best follow-up placement of next
+    // Greedy two-piece lookahead used by the placement database generator.
+    static std::optional<Placement> findBest(const Board& board, TetrominoType current, TetrominoType next);
+
+    // Best first placement for a queue of pieces, keeping only the beamWidth best boards at each depth.
+    // With a beam wide enough to keep every board and two pieces it agrees with
+    // findBest whenever the second piece fits. Memory grows with beamWidth.
+    static std::optional<Placement> beamSearch(const Board& board, std::span<const TetrominoType> pieces, int beamWidth);
+};
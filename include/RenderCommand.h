@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "FrameProfiler.h"
+
+// What a command draws. Bulky data (board, pieces) is read from the
+// snapshot the list was built from, everything else is inline.
+enum class RenderOp : std::uint8_t {
+    Board,      // Locked cells through the board layer
+    Piece,      // Falling piece
+    Ghost,      // Falling piece at its landing position
+    Preview,    // Tetromino of type `id` centred in a preview box at (x, y)
+    Text,       // Static string `id`
+    LargeText,  // Static string `id` in the large font
+    Value,      // Static label `id` followed by `value`
+    Fill,       // Rectangle (x, y, w, h) in `color`
+    Hud         // Frame-timing overlay
+};
+
+// Strings the game screens are made of, see textFor()
+enum class TextId : std::uint8_t {
+    Title,
+    MoveHelp,
+    HardDropHelp,
+    PauseHelp,
+    SoundHelp,
+    QuitHelp,
+    StartHelp,
+    PressStart,
+    Version,
+    Next,
+    Score,
+    Level,
+    Lines,
+    Controls,
+    MoveKeys,
+    RotateKey,
+    SoftDropKey,
+    HardDropKey,
+    Paused,
+    ContinueHelp,
+    QuitPausedHelp,
+    GameOver,
+    FinalScore,
+    FinesseFaults,
+    RestartHelp,
+    COUNT
+};
+
+const char* textFor(TextId id);
+
+struct RenderCommand {
+    RenderOp op;
+    std::uint8_t id;    // TextId or TetrominoType, depending on op
+    FramePhase layer;   // Profiler phase the command is timed under
+    std::int16_t x;
+    std::int16_t y;
+    std::int16_t w;
+    std::int16_t h;
+    SDL_Color color;
+    std::int32_t value;
+};
+
+// One frame of draw commands in fixed storage, building it never allocates
+class RenderCommandList {
+public:
+    static constexpr std::size_t CAPACITY = 64;
+
+    void clear() { size_ = 0; }
+    bool push(const RenderCommand& command);  // False when full, the command is dropped
+
+    std::span<const RenderCommand> commands() const { return {commands_.data(), size_}; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    std::array<RenderCommand, CAPACITY> commands_{};
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include "FrameSnapshot.h"
+#include "TripleBuffer.h"
+
+// Draws frame snapshots on a thread of its own. The simulation captures into
+// beginFrame() and publishes it without ever waiting; the render thread
+// always draws the newest snapshot, so a slow present drops stale frames
+// instead of holding up input handling and gravity.
+class RenderThread {
+public:
+    using Draw = std::function<void(const FrameSnapshot&)>;
+    using Release = std::function<void()>;
+    using Pace = std::function<void()>;
+
+    // release runs on the render thread just before it exits, to hand back
+    // state bound to it (such as a GL context); pace runs before each frame
+    // is picked, so a wait for the next display slot never holds a stale one
+    explicit RenderThread(Draw draw, Release release = {}, Pace pace = {});
+    ~RenderThread();  // Finishes the frame being drawn and joins
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Simulation side
+    FrameSnapshot& beginFrame() { return frames_.back(); }
+    void publish();
+
+    std::uint64_t getFramesDrawn() const { return framesDrawn_.load(std::memory_order_relaxed); }
+
+private:
+    TripleBuffer<FrameSnapshot> frames_;
+    std::atomic<std::uint64_t> published_{0};  // Waited on by the render thread
+    std::atomic<std::uint64_t> framesDrawn_{0};
+    std::atomic<bool> stopping_{false};
+    Draw draw_;
+    Release release_;
+    Pace pace_;
+    std::thread thread_;  // Last, it starts once everything above exists
+
+    void run();
+};
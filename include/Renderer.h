@@ -2,17 +2,38 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include "Tetromino.h"
 #include "Constants.h"
+#include "TextCache.h"
+#include "FontManager.h"
+#include "GlyphAtlas.h"
+#include "BlockAtlas.h"
+#include "BoardLayer.h"
+#include "SoftwareRasterizer.h"
 
-class Game;
+// Work issued by the renderer since the last resetCounters()
+struct RenderCounters {
+    int drawCalls = 0;
+    int textureUploads = 0;  // Strings rasterised and copied into new textures
+};
+
+// Sdl issues SDL render calls per layer. Software rasterises the frame on
+// the CPU and uploads it once per present; with no SDL_Renderer it runs
+// headless and the frame is only available through getFrame().
+enum class RenderBackend {
+    Sdl,
+    Software
+};
 
 class Renderer {
 public:
-    Renderer(SDL_Renderer* renderer, TTF_Font* font);
+    Renderer(SDL_Renderer* renderer, FontManager& fonts, RenderBackend backend = RenderBackend::Sdl);
+    ~Renderer();
     
     // Core rendering functions
     void clear();
@@ -20,18 +41,47 @@ public:
     
     // Game element rendering functions
     void drawGrid(const std::vector<std::vector<std::optional<TetrominoType>>>& grid);
+    void drawBoard(const std::vector<std::vector<std::optional<TetrominoType>>>& grid, std::uint64_t boardVersion);
     void drawTetromino(const Tetromino& tetromino);
-    void drawGhostPiece(const Game& game, const Tetromino& tetromino);
-    void drawSidebar(const Game& game, TetrominoType nextTetrominoType);
+    void drawGhost(const Tetromino& landing);  // Outline of the piece where it would land
     void drawNextTetromino(TetrominoType type, int x, int y);
-    void drawText(const std::string& text, int x, int y);
-    void drawLargeText(const std::string& text, int x, int y);
+    void drawText(std::string_view text, int x, int y);
+    void drawDynamicText(std::string_view text, int x, int y);  // For text that changes often
+    void drawLargeText(std::string_view text, int x, int y);
     void drawGameOver(int score);
+    void fillRect(const SDL_Rect& rect, SDL_Color color);
+    
+    // Per-frame draw call and upload counts for the timing HUD
+    void resetCounters();
+    RenderCounters getCounters() const;
+    
+    // Textures lost on SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET
+    void handleRenderReset(bool deviceReset);
     
     // Accessor for the renderer (used for direct drawing in some cases)
     SDL_Renderer* getRenderer() const { return renderer_; }
+    const TextCache& getTextCache() const { return textCache_; }
+    RenderBackend getBackend() const { return backend_; }
+    const SoftwareRasterizer* getFrame() const { return raster_.get(); }  // Software backend only
     
 private:
     SDL_Renderer* renderer_; // Non-owning pointer
-    TTF_Font* font_;         // Non-owning pointer
+    TTF_Font* font_;         // Non-owning, cached by FontManager
+    TTF_Font* largeFont_;    // Non-owning, cached by FontManager
+    TextCache textCache_;    // Textures for strings drawn with drawText
+    GlyphAtlas glyphAtlas_;  // Glyphs for strings drawn with drawDynamicText
+    GlyphAtlas largeGlyphAtlas_;  // drawLargeText on the software backend
+    BlockAtlas blockAtlas_;  // Block sprites, one batched draw per layer
+    BoardLayer boardLayer_;  // Locked cells, redrawn when the board version changes
+    RenderCounters counters_;
+    std::uint64_t missesAtReset_ = 0;  // Text cache misses before this frame
+    
+    RenderBackend backend_;
+    std::unique_ptr<SoftwareRasterizer> raster_;  // Software backend only
+    SDL_Texture* frameTexture_ = nullptr;         // Streaming texture the CPU frame is uploaded to
+    
+    void createFrameTexture();
+    void drawOutline(const SDL_Rect& rect, SDL_Color color);
+    void flushBlocks();
+    void drawAtlasText(GlyphAtlas& atlas, std::string_view text, int x, int y, SDL_Color color);
 };
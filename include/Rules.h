@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
+#include "Constants.h"
+#include "TetrominoType.h"
+
+// Core game rules as constexpr data. The runtime game and the lookup tables
+// generated at compile time (piece masks, finesse) both read them from here.
+
+using TetrominoShape = std::array<std::array<bool, TETROMINO_GRID_SIZE>, TETROMINO_GRID_SIZE>;
+
+// Rotates a shape clockwise by 90 degrees per step
+constexpr TetrominoShape rotateShape(TetrominoShape shape, int rotation) {
+    for (int r = 0; r < rotation; r++) {
+        TetrominoShape rotated{};
+        for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
+            for (int x = 0; x < TETROMINO_GRID_SIZE; x++) {
+                rotated[x][TETROMINO_GRID_MAX_INDEX - y] = shape[y][x];
+            }
+        }
+        shape = rotated;
+    }
+    return shape;
+}
+
+inline constexpr auto ROTATED_SHAPES = [] {
+    std::array<std::array<TetrominoShape, TETROMINO_ROTATION_COUNT>, static_cast<std::size_t>(TetrominoType::COUNT)> shapes{};
+    for (std::size_t type = 0; type < shapes.size(); type++) {
+        for (int rotation = 0; rotation < TETROMINO_ROTATION_COUNT; rotation++) {
+            shapes[type][rotation] = rotateShape(SHAPES[type], rotation);
+        }
+    }
+    return shapes;
+}();
+
+constexpr const TetrominoShape& rotatedShape(TetrominoType type, int rotation) {
+    return ROTATED_SHAPES[static_cast<std::size_t>(type)][rotation % TETROMINO_ROTATION_COUNT];
+}
+
+// SRS (Super Rotation System) kick data: offsets tested in order when
+// rotating clockwise out of each rotation
+using KickOffset = std::pair<int, int>;
+constexpr int KICK_TEST_COUNT = 5;
+using KickTests = std::array<std::array<KickOffset, KICK_TEST_COUNT>, TETROMINO_ROTATION_COUNT>;
+
+// Kick table for J, L, S, T, Z pieces
+inline constexpr KickTests JLSTZ_KICKS = {{
+    // 0->1
+    {{{0, 0}, {MOVE_LEFT, 0}, {MOVE_LEFT, MOVE_LEFT}, {0, HALF}, {MOVE_LEFT, HALF}}},
+    // 1->2
+    {{{0, 0}, {MOVE_RIGHT, 0}, {MOVE_RIGHT, MOVE_RIGHT}, {0, -HALF}, {MOVE_RIGHT, -HALF}}},
+    // 2->3
+    {{{0, 0}, {MOVE_RIGHT, 0}, {MOVE_RIGHT, MOVE_LEFT}, {0, HALF}, {MOVE_RIGHT, HALF}}},
+    // 3->0
+    {{{0, 0}, {MOVE_LEFT, 0}, {MOVE_LEFT, MOVE_RIGHT}, {0, -HALF}, {MOVE_LEFT, -HALF}}}
+}};
+
+// Kick table for I piece
+inline constexpr KickTests I_KICKS = {{
+    // 0->1
+    {{{0, 0}, {-HALF, 0}, {MOVE_RIGHT, 0}, {-HALF, MOVE_RIGHT}, {MOVE_RIGHT, -HALF}}},
+    // 1->2
+    {{{0, 0}, {MOVE_LEFT, 0}, {HALF, 0}, {MOVE_LEFT, -HALF}, {HALF, MOVE_RIGHT}}},
+    // 2->3
+    {{{0, 0}, {HALF, 0}, {MOVE_LEFT, 0}, {HALF, MOVE_LEFT}, {MOVE_LEFT, HALF}}},
+    // 3->0
+    {{{0, 0}, {MOVE_RIGHT, 0}, {-HALF, 0}, {MOVE_RIGHT, HALF}, {-HALF, MOVE_LEFT}}}
+}};
+
+// No kicks for O piece since it's symmetric
+inline constexpr std::array<KickOffset, 1> O_KICKS = {{{0, 0}}};
+
+// Tried after the table kicks, helps with pieces that get stuck on walls
+inline constexpr std::array<KickOffset, 8> EXTRA_KICKS = {{
+    {-HALF, 0}, {HALF, 0},   // farther left/right
+    {0, -HALF}, {0, HALF},   // farther up/down
+    {-HALF, MOVE_LEFT}, {HALF, MOVE_LEFT}, // diagonal kicks
+    {-HALF, MOVE_RIGHT}, {HALF, MOVE_RIGHT}    // diagonal kicks
+}};
+
+constexpr std::span<const KickOffset> kickTests(TetrominoType type, int fromRotation) {
+    if (type == TetrominoType::I) {
+        return I_KICKS[fromRotation];
+    }
+    if (type == TetrominoType::O) {
+        return O_KICKS;
+    }
+    return JLSTZ_KICKS[fromRotation];
+}
+
+// Spawn position of the 4x4 box
+constexpr int SPAWN_X = GRID_WIDTH / HALF - HALF;
+
+constexpr int spawnY(TetrominoType type) {
+    return (type == TetrominoType::I) ? MOVE_LEFT : NO_MOVE;
+}
+
+// Scoring and level progression
+inline constexpr std::array<int, TETROMINO_GRID_SIZE> LINE_CLEAR_SCORES = {100, 300, 500, 800};
+
+constexpr int lineClearScore(int linesCleared, int level) {
+    return LINE_CLEAR_SCORES[std::min(linesCleared, TETROMINO_GRID_SIZE) - 1] * level;
+}
+
+constexpr int levelForLines(int linesCleared) {
+    return std::min(INITIAL_LEVEL + linesCleared / LINES_PER_LEVEL, MAX_LEVEL);
+}
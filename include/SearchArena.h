@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Monotonic arena for search code. Allocation is a pointer bump, deallocation
+// is a no-op, and reset() rewinds to the start while keeping the blocks, so a
+// search that has been run once never returns to the upstream allocator.
+class SearchArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit SearchArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE,
+                         std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~SearchArena() override;
+
+    SearchArena(const SearchArena&) = delete;
+    SearchArena& operator=(const SearchArena&) = delete;
+
+    // Forget every allocation but keep the blocks for reuse
+    void reset();
+
+    // Return all blocks to the upstream resource
+    void release();
+
+    std::size_t bytesInUse() const { return bytesInUse_; }
+    std::size_t peakBytes() const { return peakBytes_; }
+    std::size_t capacity() const { return capacity_; }
+    std::size_t allocationCount() const { return allocationCount_; }
+    std::size_t upstreamAllocationCount() const { return upstreamAllocationCount_; }
+    void resetStatistics();
+
+    // Arena owned by the calling thread, shared by all searches on it
+    static SearchArena& threadLocal();
+
+private:
+    // Blocks form a singly linked list with the header at the start of each
+    struct Block {
+        Block* next;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    bool tryBump(std::size_t bytes, std::size_t alignment, void*& result);
+    Block* allocateBlock(std::size_t minimumSize);
+
+    std::size_t blockSize_;
+    std::pmr::memory_resource* upstream_;
+    Block* head_ = nullptr;
+    Block* current_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+
+    std::size_t bytesInUse_ = 0;
+    std::size_t peakBytes_ = 0;
+    std::size_t capacity_ = 0;
+    std::size_t allocationCount_ = 0;
+    std::size_t upstreamAllocationCount_ = 0;
+};
+
+// Fixed-size node pool on top of a memory resource. Released nodes go on a
+// free list and are handed out again before any new memory is requested.
+// Nodes must be trivially destructible so the whole pool can be dropped at once.
+template <typename T>
+class NodePool {
+    static_assert(std::is_trivially_destructible_v<T>, "Pooled nodes are dropped without running destructors");
+
+public:
+    explicit NodePool(std::pmr::memory_resource* resource) : resource_(resource) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        void* memory;
+        if (freeList_ != nullptr) {
+            memory = freeList_;
+            freeList_ = freeList_->next;
+        } else {
+            memory = resource_->allocate(sizeof(Slot), alignof(Slot));
+        }
+        liveCount_++;
+        return ::new (memory) T{std::forward<Args>(args)...};
+    }
+
+    void destroy(T* node) {
+        auto* slot = ::new (static_cast<void*>(node)) Slot;
+        slot->next = freeList_;
+        freeList_ = slot;
+        liveCount_--;
+    }
+
+    // Drop every node at once, the memory goes when the resource is reset
+    void reset() {
+        freeList_ = nullptr;
+        liveCount_ = 0;
+    }
+
+    std::size_t liveCount() const { return liveCount_; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::pmr::memory_resource* resource_;
+    Slot* freeList_ = nullptr;
+    std::size_t liveCount_ = 0;
+};
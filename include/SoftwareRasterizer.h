@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// A whole frame drawn on the CPU into ARGB8888 pixels. Rectangle fills are
+// SIMD span stores and sprites/glyphs are alpha blended rows, so a frame is a
+// few hundred tight loops instead of a few hundred SDL calls. The result is
+// uploaded with one SDL_UpdateTexture, or read directly when running headless.
+//
+// Fills ignore alpha like SDL's default draw blend mode, blits blend like a
+// texture with SDL_BLENDMODE_BLEND. SIMD and scalar paths give identical pixels.
+class SoftwareRasterizer {
+public:
+    static constexpr int BYTES_PER_PIXEL = 4;
+
+    SoftwareRasterizer(int width, int height);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int pitch() const { return width_ * BYTES_PER_PIXEL; }
+    std::span<const std::uint32_t> pixels() const { return pixels_; }
+    std::uint32_t pixel(int x, int y) const { return pixels_[static_cast<std::size_t>(y) * width_ + x]; }
+
+    static constexpr std::uint32_t pack(SDL_Color color) {
+        return (std::uint32_t{color.a} << 24) | (std::uint32_t{color.r} << 16) |
+               (std::uint32_t{color.g} << 8) | std::uint32_t{color.b};
+    }
+
+    // RGBA32 bytes (as SDL_PIXELFORMAT_RGBA32 surfaces store them) to packed ARGB8888
+    static std::vector<std::uint32_t> fromRgba32(std::span<const std::uint8_t> bytes);
+
+    void clear(SDL_Color color);
+    void fillRect(const SDL_Rect& rect, SDL_Color color);
+    void drawRect(const SDL_Rect& rect, SDL_Color color);  // One pixel outline
+
+    // Blend part of an ARGB8888 image with its top-left at (x, y). The tint
+    // multiplies every channel, alpha included, like texture colour/alpha mod.
+    void blit(std::span<const std::uint32_t> source, int sourceWidth, const SDL_Rect& sourceRect,
+              int x, int y, SDL_Color tint);
+
+    // FNV-1a over the pixels, for comparing frames in benchmarks and tests
+    std::uint64_t checksum() const;
+
+private:
+    int width_;
+    int height_;
+    std::vector<std::uint32_t> pixels_;
+
+    // Intersect with the frame, false when nothing is left
+    bool clip(SDL_Rect& rect) const;
+};
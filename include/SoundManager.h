@@ -1,19 +1,19 @@
 #pragma once
 
 #include <SDL2/SDL_mixer.h>
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
 #include <string>
 #include <memory>
-
-// Sound effect types
-enum class SoundEffect {
-    Move,
-    Rotate,
-    Drop,
-    LineClear,
-    LevelUp,
-    GameOver
-};
+#include <mutex>
+#include <span>
+#include <vector>
+#include "AssetArchive.h"
+#include "AudioLatencyMonitor.h"
+#include "MusicStream.h"
+#include "SoundQueue.h"
 
 class SoundManager {
 public:
@@ -23,18 +23,46 @@ public:
     // Initialize the audio system
     virtual bool initialize();
     
+    // Sounds are taken from the archive when it has them, loose files otherwise
+    void setArchive(const AssetArchive* archive) { archive_ = archive; }
+    
     // Load sounds from files
     virtual bool loadSounds();
     
-    // Play a specific sound effect
+    // loadSounds() on a background thread, effects are silent until it finishes
+    virtual void loadSoundsAsync();
+    bool soundsReady() const { return soundsReady_.load(std::memory_order_acquire); }
+    
+    // Queue a sound effect for the audio thread, never blocks. The effect
+    // starts after the next endFrame(), once however often it was queued.
     virtual void playSound(SoundEffect effect);
     
+    // Called by the game loop once per frame, hands the frame's sounds to the audio thread
+    void endFrame();
+    
+    std::size_t droppedSounds() const { return queue_.dropped(); }
+    
+    // Background music for a level, tracks and tempo follow MusicStream::forLevel
+    virtual void playMusic(int level) { music_.play(level); }
+    virtual void pauseMusic() { music_.pause(); }
+    
     // Set sound volume (0-100)
     virtual void setVolume(int volume);
     
     // Mute/unmute all sounds
     virtual void toggleMute();
     bool isMuted() const { return muted_; }
+    
+    // Measured output latency of the open device
+    AudioLatencyMonitor::Report audioLatency() const { return monitor_.report(); }
+    
+    // Mixer buffer in sample frames: TETRIS_AUDIO_BUFFER if it is a power of
+    // two from AUDIO_MIN_CHUNK_SIZE to AUDIO_CHUNK_SIZE, else the default
+    static int requestedBufferFrames(const char* setting);
+
+protected:
+    // Plays on one of the effect's channels, restarting its oldest voice when all are busy
+    virtual bool startVoice(SoundEffect effect);
 
 private:
     // Custom deleter for Mix_Chunk
@@ -44,13 +72,50 @@ private:
         }
     };
     
-    // Sound effects container
-    std::unordered_map<SoundEffect, std::unique_ptr<Mix_Chunk, MixChunkDeleter>> sounds_;
+    // Sound effects indexed by SoundEffect
+    std::array<std::unique_ptr<Mix_Chunk, MixChunkDeleter>, SOUND_EFFECT_COUNT> sounds_;
     
     bool initialized_;
     bool muted_;
     int volume_; // 0-128 (SDL_mixer range)
     
-    // Helper method to load a single sound
+    const AssetArchive* archive_ = nullptr;  // Non-owning, must outlive the loaded sounds
+    std::vector<std::vector<Uint8>> converted_;  // Archive samples resampled for an unexpected device format
+    std::vector<std::vector<std::int16_t>> synthesized_;  // SoundSynth output in the device format
+    
+    std::thread loader_;
+    std::atomic<bool> soundsReady_{false};  // sounds_ is complete and no longer written
+    
+    SoundQueue queue_;
+    std::thread mixer_;
+    std::atomic<std::uint32_t> frame_{0};  // Bumped by endFrame(), the audio thread waits on it
+    std::atomic<bool> stopping_{false};
+    
+    void startMixer();
+    void stopMixer();
+    void mixFrame();  // Audio thread: plays the sounds queued since the last call
+    
+    // Output latency: the mixer callback is timed, and when the device keeps
+    // running dry the audio thread reopens it with twice the buffer
+    int bufferFrames_ = AUDIO_CHUNK_SIZE;
+    AudioLatencyMonitor monitor_;
+    std::mutex deviceMutex_;     // Held while the audio thread reopens the device or music is set up for it
+    bool deviceLost_ = false;    // Audio thread only, a reopen failed
+    bool latencyLogged_ = false; // Audio thread only
+    
+    // Streamed by its own decode thread, started by the loader once the tracks are found
+    MusicStream music_;
+    bool musicHooked_ = false;  // Guarded by deviceMutex_
+    
+    void loadMusic();
+    void configureDevice();
+    void checkDevice();
+    bool reopenDevice(int bufferFrames);
+    static void postMix(void* manager, Uint8* stream, int length);
+    
+    // Helper methods to load a single sound
     bool loadSound(SoundEffect effect, const std::string& filename);
+    bool loadSound(SoundEffect effect, const AssetArchive::Asset& asset);
+    Mix_Chunk* loadPcm(std::span<const std::byte> samples);
+    bool synthesize(SoundEffect effect);
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Constants.h"
+#include "SpscQueue.h"
+
+// Sound effect types
+enum class SoundEffect : std::uint8_t {
+    Move,
+    Rotate,
+    Drop,
+    LineClear,
+    LevelUp,
+    GameOver
+};
+
+constexpr std::size_t SOUND_EFFECT_COUNT = 6;
+
+// Mixer channels reserved for each effect. When all of an effect's voices
+// are busy the oldest one is restarted instead of taking another channel.
+constexpr std::array<int, SOUND_EFFECT_COUNT> SOUND_VOICE_LIMITS = {
+    2,  // Move, a DAS burst repeats it every few frames
+    2,  // Rotate
+    2,  // Drop
+    1,  // LineClear
+    1,  // LevelUp
+    1   // GameOver
+};
+
+// Sound requests from game logic to the audio thread. Logic pushes events
+// without locking or touching SDL_mixer, the audio thread drains them once
+// per frame and each effect plays at most once per frame however often it
+// was pushed.
+class SoundQueue {
+public:
+    // How many times each effect was pushed since the last drain
+    using Batch = std::array<std::uint16_t, SOUND_EFFECT_COUNT>;
+
+    // Producer side, false when the ring is full and the event was dropped
+    bool push(SoundEffect effect);
+    std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Consumer side
+    Batch drain();
+
+private:
+    struct Event {
+        SoundEffect effect;
+    };
+
+    SpscQueue<Event, SOUND_QUEUE_SIZE> events_;
+    std::atomic<std::size_t> dropped_{0};
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "SoundQueue.h"
+
+// Generates the sound effects from a few oscillator notes, so the game has
+// sound with no WAV files and no disk reads at all. Oscillators and
+// envelopes run four samples at a time with SSE2 where available; the
+// result is converted once to the mixer's 16-bit format and kept.
+class SoundSynth {
+public:
+    enum class Wave : std::uint8_t {
+        Square,
+        Triangle,
+        Saw,
+        Noise  // White, ignores the pitch
+    };
+
+    struct Note {
+        Wave wave;
+        float start;     // Seconds into the effect
+        float duration;  // Seconds
+        float fromHz;    // Pitch slides linearly from fromHz to toHz
+        float toHz;
+        float volume;    // Peak, 0-1
+        float duty;      // Square only, fraction of the period spent high
+        float decay;     // Seconds for the level to fall to 1/e, 0 holds it
+    };
+
+    static constexpr float ATTACK = 0.002f;   // Seconds, fades every note in and out so
+    static constexpr float RELEASE = 0.005f;  // nothing clicks
+
+    static std::span<const Note> patch(SoundEffect effect);
+
+    // The effect as mono samples in [-1, 1]
+    static std::vector<float> render(SoundEffect effect, int sampleRate);
+
+    // Adds one note into `out`, which starts at the note's start
+    static void renderNote(const Note& note, int sampleRate, std::span<float> out);
+
+    // Interleaved 16-bit samples with the mono signal on every channel
+    static std::vector<std::int16_t> toPcm(std::span<const float> samples, int channels);
+};
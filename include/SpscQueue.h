@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+// Bounded lock-free single-producer single-consumer ring. Nothing waits:
+// push() fails when the ring is full and pop() when it is empty, write()
+// and read() move as many values as fit. Capacity must be a power of two.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T& value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == Capacity) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == Capacity) {
+                return false;
+            }
+        }
+        slots_[tail & MASK] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side, copies as many of `values` as fit and returns how many
+    std::size_t write(std::span<const T> values) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (Capacity - (tail - headCache_) < values.size()) {
+            headCache_ = head_.load(std::memory_order_acquire);
+        }
+        std::size_t count = std::min(Capacity - (tail - headCache_), values.size());
+        for (std::size_t i = 0; i < count; i++) {
+            slots_[(tail + i) & MASK] = values[i];
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Producer side, room for at least this many values
+    std::size_t writable() const {
+        return Capacity - (tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire));
+    }
+
+    // Consumer side
+    bool pop(T& value) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        value = slots_[head & MASK];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, fills as much of `values` as the ring holds and returns how many
+    std::size_t read(std::span<T> values) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (tailCache_ - head < values.size()) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+        }
+        std::size_t count = std::min(tailCache_ - head, values.size());
+        for (std::size_t i = 0; i < count; i++) {
+            values[i] = slots_[(head + i) & MASK];
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+    static constexpr std::size_t LINE = 64;  // Keeps the two sides off each other's cache line
+
+    // Each side caches the other's index and only reloads it when the ring
+    // looks full or empty
+    alignas(LINE) std::atomic<std::size_t> tail_{0};
+    std::size_t headCache_ = 0;  // Producer only
+    alignas(LINE) std::atomic<std::size_t> head_{0};
+    std::size_t tailCache_ = 0;  // Consumer only
+    alignas(LINE) std::array<T, Capacity> slots_{};
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+
+// Wall-clock cost of each cold-start step and the time from construction to
+// the first presented frame. Steps are recorded while the game is set up on
+// the main thread; the first frame may be marked from the render thread.
+class StartupProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::size_t MAX_PHASES = 16;
+
+    struct Phase {
+        const char* name;
+        Clock::duration duration;
+    };
+
+    // Records the time from construction to destruction as a startup step
+    class Scope {
+    public:
+        Scope(StartupProfiler& profiler, const char* name)
+            : profiler_(profiler), name_(name), start_(Clock::now()) {}
+        ~Scope() { profiler_.record(name_, Clock::now() - start_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StartupProfiler& profiler_;
+        const char* name_;
+        Clock::time_point start_;
+    };
+
+    StartupProfiler() : start_(Clock::now()) {}
+
+    Scope measure(const char* name) { return Scope(*this, name); }
+    void record(const char* name, Clock::duration duration);  // Dropped past MAX_PHASES
+    std::span<const Phase> phases() const { return {phases_.data(), count_}; }
+
+    // Only the first call counts, it returns true
+    bool markFirstFrame() { return markFirstFrame(Clock::now()); }
+    bool markFirstFrame(Clock::time_point presented);
+    std::optional<Clock::duration> getTimeToFirstFrame() const;
+
+    // One line of steps, then time to first frame against STARTUP_TARGET
+    void report(std::ostream& out) const;
+
+private:
+    Clock::time_point start_;
+    std::array<Phase, MAX_PHASES> phases_{};
+    std::size_t count_ = 0;
+    std::atomic<Clock::rep> firstFrame_{-1};  // Ticks after start_, -1 until presented
+};
@@ -2,43 +2,84 @@
 
 #include <array>
 #include "TetrominoType.h"
+#include "Board.h"
 
 // Forward declaration
 class Game;
 
 class Tetromino {
 public:
-    Tetromino(TetrominoType type, int x, int y);
+    constexpr Tetromino(TetrominoType type, int x, int y)
+        : type_(type), x_(x), y_(y), rotation_(0) {}
     
     void rotate(const Game& game);
     void moveLeft(const Game& game);
     void moveRight(const Game& game);
     void moveDown(const Game& game);
+
+    // Same movement and kick rules against a Board snapshot (search, finesse,
+    // compile-time tables)
+    constexpr void rotate(const Board& board) { rotateOn(board); }
+    constexpr void moveLeft(const Board& board) { moveOn(board, MOVE_LEFT, NO_MOVE); }
+    constexpr void moveRight(const Board& board) { moveOn(board, MOVE_RIGHT, NO_MOVE); }
+    constexpr void moveDown(const Board& board) { moveOn(board, NO_MOVE, MOVE_DOWN); }
+    
+    constexpr TetrominoType type() const { return type_; }
+    constexpr int x() const { return x_; }
+    constexpr int y() const { return y_; }
+    constexpr int rotation() const { return rotation_; }
     
-    TetrominoType type() const { return type_; }
-    int x() const { return x_; }
-    int y() const { return y_; }
-    int rotation() const { return rotation_; }
+    constexpr bool operator==(const Tetromino&) const = default;
 
     bool isOccupying(int x, int y) const;
-    std::array<std::array<bool, 4>, 4> getRotatedShape() const;
+    constexpr const TetrominoShape& getRotatedShape() const { return rotatedShape(type_, rotation_); }
     
     // Direct state manipulation methods
-    void setPosition(int x, int y) {
+    constexpr void setPosition(int x, int y) {
         x_ = x;
         y_ = y;
     }
     
-    void rotateWithoutWallKick() {
+    constexpr void rotateWithoutWallKick() {
         rotation_ = (rotation_ + 1) % 4;
     }
     
     // Made protected for testing
     bool isValidPosition(const Game& game, int newX, int newY, int newRotation) const;
+    constexpr bool isValidPosition(const Board& board, int newX, int newY, int newRotation) const {
+        return board.fits(pieceMask(type_, newRotation), newX, newY);
+    }
 
 private:
     TetrominoType type_;
     int x_;
     int y_;
     int rotation_;  // 0, 1, 2, or 3 (90-degree increments)
+
+    template <typename Playfield>
+    constexpr void rotateOn(const Playfield& playfield) {
+        int newRotation = (rotation_ + MOVE_RIGHT) % TETROMINO_ROTATION_COUNT;
+        
+        // Try each test position from the kick table, then the extra kicks
+        for (auto kicks : {kickTests(type_, rotation_), std::span<const KickOffset>(EXTRA_KICKS)}) {
+            for (const auto& [dx, dy] : kicks) {
+                if (isValidPosition(playfield, x_ + dx, y_ + dy, newRotation)) {
+                    x_ += dx;
+                    y_ += dy;
+                    rotation_ = newRotation;
+                    return;
+                }
+            }
+        }
+        
+        // If we get here, rotation is not possible
+    }
+
+    template <typename Playfield>
+    constexpr void moveOn(const Playfield& playfield, int dx, int dy) {
+        if (isValidPosition(playfield, x_ + dx, y_ + dy, rotation_)) {
+            x_ += dx;
+            y_ += dy;
+        }
+    }
 };
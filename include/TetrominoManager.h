@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <vector>
 #include <optional>
+#include "LockDelay.h"
 #include "Tetromino.h"
 #include "Constants.h"
 
@@ -15,9 +17,20 @@ public:
     
     // Tetromino control
     bool moveTetromino(int dx, int dy);
+    int shiftTetromino(int dx, int steps);  // Auto-repeat moves, not counted as inputs; returns steps taken
     void rotateTetromino();
     void softDrop();
     void hardDrop();
+    int dropTetromino(int rows);  // Gravity: up to `rows` down, returns how far it fell
+    
+    // Rows the current piece can fall before it rests. Computed once per
+    // column, rotation and board, then O(1) while the piece only falls.
+    int dropDistance() const;
+    bool isGrounded() const { return dropDistance() == 0; }
+    
+    // One simulation tick of lock delay, true when the piece must lock now
+    bool tickLockDelay();
+    int ticksUntilLock() const;  // Only meaningful while grounded
     
     // Game mechanics
     void lockTetromino();
@@ -27,18 +40,39 @@ public:
     // Accessors
     const Tetromino* getCurrentTetromino() const { return currentTetromino_.get(); }
     TetrominoType getNextTetrominoType() const { return nextTetrominoType_; }
+
+    // Where new pieces of a type appear
+    static constexpr Tetromino spawnTetromino(TetrominoType type) {
+        return Tetromino(type, SPAWN_X, spawnY(type));
+    }
     
 private:
     Game& game_;
     std::unique_ptr<Tetromino> currentTetromino_;
     TetrominoType nextTetrominoType_;
     std::mt19937 rng_;
+    int pieceInputs_;  // Move and rotate presses spent on the current piece
+    LockDelay lockDelay_;
+    
+    // Where the current piece lands from where dropDistance() last looked
+    struct DropCache {
+        bool valid = false;
+        TetrominoType type{};
+        int x = 0;
+        int rotation = 0;
+        int fromY = 0;
+        int landingY = 0;
+        std::uint64_t boardVersion = 0;
+    };
+    mutable DropCache dropCache_;
     
     // Helper methods
     bool isValidPosition(const Tetromino& tetromino) const;
+    bool canMove(int dx, int dy) const;  // The current piece, offset and in its rotation
     bool canPlaceNewTetromino() const;
     void generateNextTetrominoType();
     void initRng();
     void calculateScoreAndUpdateLevel(int linesCleared);
+    void checkFinesse();
 };
 // TetrominoManager.h
@@ -9,7 +9,7 @@ enum class TetrominoType {
 };
 
 // Tetromino shapes
-const std::array<std::array<std::array<bool, 4>, 4>, static_cast<std::size_t>(TetrominoType::COUNT)> SHAPES = {{
+inline constexpr std::array<std::array<std::array<bool, 4>, 4>, static_cast<std::size_t>(TetrominoType::COUNT)> SHAPES = {{
     // I
     {{
         {false, false, false, false},
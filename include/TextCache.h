@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Keeps rendered strings as textures, keyed by (text, font, colour), so text that
+// does not change is rasterised once. Least recently used entries are dropped
+// when the textures would exceed the byte budget.
+class TextCache {
+public:
+    static constexpr std::size_t DEFAULT_BYTE_BUDGET = 4 * 1024 * 1024;
+    static constexpr std::size_t BYTES_PER_PIXEL = 4;
+
+    struct Entry {
+        SDL_Texture* texture;
+        int width;
+        int height;
+    };
+
+    explicit TextCache(SDL_Renderer* renderer, std::size_t byteBudget = DEFAULT_BYTE_BUDGET);
+    virtual ~TextCache();
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // Texture for the string, rendered on a miss. nullptr if rendering failed.
+    const Entry* get(std::string_view text, TTF_Font* font, SDL_Color color);
+
+    // Destroy every texture, e.g. before the fonts they were made from close
+    void clear();
+
+    std::uint64_t hits() const { return hits_; }
+    std::uint64_t misses() const { return misses_; }
+    std::uint64_t evictions() const { return evictions_; }
+    std::size_t bytes() const { return bytes_; }
+    std::size_t size() const { return entries_.size(); }
+
+protected:
+    // Made virtual for testing
+    virtual bool render(std::string_view text, TTF_Font* font, SDL_Color color, Entry& entry);
+    virtual void destroy(Entry& entry);
+
+private:
+    struct Key {
+        std::string text;
+        TTF_Font* font;
+        std::uint32_t color;
+    };
+
+    // Lets lookups use a string_view so that hits never copy the text
+    struct KeyView {
+        std::string_view text;
+        TTF_Font* font;
+        std::uint32_t color;
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(const KeyView& key) const;
+        std::size_t operator()(const Key& key) const { return (*this)(KeyView{key.text, key.font, key.color}); }
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+        static KeyView view(const Key& key) { return {key.text, key.font, key.color}; }
+        static KeyView view(const KeyView& key) { return key; }
+
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) const {
+            KeyView left = view(a);
+            KeyView right = view(b);
+            return left.font == right.font && left.color == right.color && left.text == right.text;
+        }
+    };
+
+    struct Node {
+        Key key;
+        Entry entry;
+    };
+
+    static std::uint32_t packColor(SDL_Color color);
+    static std::size_t entryBytes(const Entry& entry);
+    void evictToBudget();
+
+    SDL_Renderer* renderer_; // Non-owning pointer
+    std::size_t byteBudget_;
+    std::size_t bytes_ = 0;
+
+    // Most recently used first
+    std::list<Node> entries_;
+    std::unordered_map<Key, std::list<Node>::iterator, KeyHash, KeyEqual> index_;
+
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+    std::uint64_t evictions_ = 0;
+};
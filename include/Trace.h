@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "Constants.h"
+
+// Scoped trace zones, written out as Chrome trace JSON for chrome://tracing
+// or ui.perfetto.dev. Each thread records into a ring of its own, so zones
+// never take a lock and never wait for the thread that writes the file; the
+// ring keeps the newest TRACE_RING_SIZE zones of each thread.
+//
+// TRACE_ZONE("name") times the rest of the enclosing scope. Names must be
+// string literals, only the pointer is stored. While tracing is off a zone
+// costs one well-predicted branch. Built without TETRIS_TRACING the macro
+// expands to nothing at all.
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+#ifdef TETRIS_TRACING
+    static constexpr bool COMPILED_IN = true;
+#else
+    static constexpr bool COMPILED_IN = false;
+#endif
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    // The track title for the calling thread, a literal like the zone names
+    static void setThreadName(const char* name);
+
+    static void record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+    // Every thread's zones as one JSON document. Safe while other threads
+    // keep recording, zones they overwrite during the copy are left out, as
+    // is the oldest zone of a full ring since its slot is written next.
+    static void writeChromeJson(std::ostream& out);
+    static bool writeChromeJson(const std::string& path);
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) : name_(enabled() ? name : nullptr) {
+            if (name_) {
+                begin_ = Clock::now();
+            }
+        }
+        ~Zone() {
+            if (name_) {
+                record(name_, begin_, Clock::now());
+            }
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* name_;
+        Clock::time_point begin_;
+    };
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+#ifdef TETRIS_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#define TRACE_ZONE(name) static_cast<void>(0)
+#endif
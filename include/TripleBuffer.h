@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer single-consumer triple buffer. The writer fills
+// back() and publishes it, the reader swaps in the newest published value
+// with update(). Neither side ever waits for the other: values published
+// between two reads are overwritten, the reader only sees the latest.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side
+    T& back() { return buffers_[back_]; }
+    void publish() {
+        back_ = middle_.exchange(static_cast<std::uint8_t>(back_ | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader side, true when front() now holds a newer value
+    bool update() {
+        if ((middle_.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& front() const { return buffers_[front_]; }
+
+private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;  // Middle holds a value the reader has not taken
+
+    std::array<T, 3> buffers_{};
+    std::atomic<std::uint8_t> middle_{1};
+    std::uint8_t back_ = 0;   // Writer only
+    std::uint8_t front_ = 2;  // Reader only
+};
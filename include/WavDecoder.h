@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Decodes a WAV file held in memory a block at a time, so a track of any
+// length costs one block of samples. Reads 16-bit PCM and IMA ADPCM, the
+// 4:1 compressed WAV format SDL can also play; music is stored as ADPCM to
+// keep the archive small. The data is not copied and must outlive the decoder.
+class WavDecoder {
+public:
+    static constexpr std::uint16_t FORMAT_PCM = 0x0001;
+    static constexpr std::uint16_t FORMAT_IMA_ADPCM = 0x0011;
+    static constexpr int MAX_CHANNELS = 2;
+
+    bool open(std::span<const std::byte> wav);
+    bool isOpen() const { return !data_.empty(); }
+
+    int sampleRate() const { return sampleRate_; }
+    int channels() const { return channels_; }
+
+    // Fills `out` with interleaved samples, whole frames only. Returns the
+    // number of samples written, 0 at the end of the data.
+    std::size_t decode(std::span<std::int16_t> out);
+
+    // Back to the first sample
+    void rewind();
+
+private:
+    std::span<const std::byte> data_;  // The "data" chunk
+    std::uint16_t format_ = 0;
+    int sampleRate_ = 0;
+    int channels_ = 0;
+    std::size_t blockAlign_ = 0;
+    std::size_t position_ = 0;  // Byte offset into data_
+
+    // ADPCM: the current block, decoded
+    std::vector<std::int16_t> block_;
+    std::size_t blockSamples_ = 0;
+    std::size_t blockRead_ = 0;
+
+    std::size_t decodePcm(std::span<std::int16_t> out);
+    bool decodeBlock();
+};
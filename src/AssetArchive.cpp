@@ -0,0 +1,134 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+std::string_view entryName(const AssetArchive::Entry& entry) {
+    return {entry.name, strnlen(entry.name, AssetArchive::NAME_LENGTH)};
+}
+
+std::size_t alignUp(std::size_t offset) {
+    return (offset + AssetArchive::ALIGNMENT - 1) / AssetArchive::ALIGNMENT * AssetArchive::ALIGNMENT;
+}
+
+} // namespace
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+
+    if (!file_.open(path)) {
+        return false;
+    }
+
+    bytes_ = {file_.data(), file_.size()};
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool AssetArchive::openMemory(std::span<const std::byte> bytes) {
+    close();
+    bytes_ = bytes;
+    if (!validate()) {
+        bytes_ = {};
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    file_.close();
+    bytes_ = {};
+}
+
+bool AssetArchive::validate() const {
+    if (bytes_.size() < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, bytes_.data(), sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION ||
+        header.count > (bytes_.size() - sizeof(Header)) / sizeof(Entry)) {
+        return false;
+    }
+
+    // Entries are read in place, so the table must be aligned for them
+    if (reinterpret_cast<std::uintptr_t>(bytes_.data()) % alignof(Entry) != 0) {
+        return false;
+    }
+
+    return std::all_of(entries().begin(), entries().end(), [this](const Entry& entry) {
+        return entry.offset <= bytes_.size() && entry.size <= bytes_.size() - entry.offset;
+    });
+}
+
+std::span<const AssetArchive::Entry> AssetArchive::entries() const {
+    if (bytes_.empty()) {
+        return {};
+    }
+
+    Header header;
+    std::memcpy(&header, bytes_.data(), sizeof(header));
+    return {reinterpret_cast<const Entry*>(bytes_.data() + sizeof(Header)), header.count};
+}
+
+AssetArchive::Asset AssetArchive::assetAt(const Entry& entry) const {
+    return {entryName(entry), entry.kind, bytes_.subspan(entry.offset, entry.size)};
+}
+
+std::optional<AssetArchive::Asset> AssetArchive::find(std::string_view name) const {
+    auto table = entries();
+    auto found = std::lower_bound(table.begin(), table.end(), name,
+                                  [](const Entry& entry, std::string_view key) { return entryName(entry) < key; });
+    if (found == table.end() || entryName(*found) != name) {
+        return std::nullopt;
+    }
+    return assetAt(*found);
+}
+
+std::optional<AssetArchive::Asset> AssetArchive::findFirst(std::string_view prefix) const {
+    auto table = entries();
+    auto found = std::lower_bound(table.begin(), table.end(), prefix,
+                                  [](const Entry& entry, std::string_view key) { return entryName(entry) < key; });
+    if (found == table.end() || !entryName(*found).starts_with(prefix)) {
+        return std::nullopt;
+    }
+    return assetAt(*found);
+}
+
+std::optional<std::vector<std::byte>> AssetArchive::pack(std::vector<Input> inputs) {
+    std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) { return a.name < b.name; });
+
+    std::size_t offset = alignUp(sizeof(Header) + inputs.size() * sizeof(Entry));
+    std::vector<Entry> table;
+    for (const Input& input : inputs) {
+        if (input.name.empty() || input.name.size() >= NAME_LENGTH) {
+            return std::nullopt;
+        }
+
+        Entry entry{};
+        std::memcpy(entry.name, input.name.data(), input.name.size());
+        entry.kind = input.kind;
+        entry.offset = static_cast<std::uint32_t>(offset);
+        entry.size = static_cast<std::uint32_t>(input.data.size());
+        table.push_back(entry);
+        offset = alignUp(offset + input.data.size());
+    }
+
+    std::vector<std::byte> image(offset);
+    Header header = {MAGIC, VERSION, static_cast<std::uint32_t>(inputs.size()), 0};
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + sizeof(Header), table.data(), table.size() * sizeof(Entry));
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        std::copy(inputs[i].data.begin(), inputs[i].data.end(), image.begin() + table[i].offset);
+    }
+    return image;
+}
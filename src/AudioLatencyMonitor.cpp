@@ -0,0 +1,63 @@
+#include "AudioLatencyMonitor.h"
+#include "Constants.h"
+
+void AudioLatencyMonitor::reset(int bufferFrames, int sampleRate, int bytesPerFrame) {
+    bufferFrames_.store(bufferFrames, std::memory_order_relaxed);
+    sampleRate_.store(sampleRate > 0 ? sampleRate : 1, std::memory_order_relaxed);
+    bytesPerFrame_.store(bytesPerFrame > 0 ? bytesPerFrame : 1, std::memory_order_relaxed);
+    lastCallback_ = {};
+    callbacks_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    periodNs_.store(0, std::memory_order_relaxed);
+    bytesPerCallback_.store(0, std::memory_order_relaxed);
+}
+
+void AudioLatencyMonitor::onCallback(Clock::time_point now, int bytes) {
+    std::uint32_t callbacks = callbacks_.load(std::memory_order_relaxed) + 1;
+    Clock::time_point last = lastCallback_;
+    lastCallback_ = now;
+    bytesPerCallback_.store(bytes, std::memory_order_relaxed);
+    callbacks_.store(callbacks, std::memory_order_relaxed);
+    if (callbacks <= WARMUP_CALLBACKS) {
+        return;
+    }
+
+    // The period the device asked for, a gap far beyond it left the output silent
+    std::int64_t frames = bytes / bytesPerFrame_.load(std::memory_order_relaxed);
+    std::int64_t nominal = frames * 1'000'000'000 / sampleRate_.load(std::memory_order_relaxed);
+    std::int64_t interval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+    if (nominal > 0 && interval > nominal * UNDERRUN_FACTOR) {
+        underruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::int64_t period = periodNs_.load(std::memory_order_relaxed);
+    period = period == 0 ? interval : period + (interval - period) / 8;
+    periodNs_.store(period, std::memory_order_relaxed);
+}
+
+AudioLatencyMonitor::Report AudioLatencyMonitor::report() const {
+    int sampleRate = sampleRate_.load(std::memory_order_relaxed);
+    Report report;
+    report.bufferFrames = bufferFrames_.load(std::memory_order_relaxed);
+    report.framesPerCallback = bytesPerCallback_.load(std::memory_order_relaxed) /
+                               bytesPerFrame_.load(std::memory_order_relaxed);
+    report.callbacks = callbacks_.load(std::memory_order_relaxed);
+    report.underruns = underruns_.load(std::memory_order_relaxed);
+    report.calibrated = report.callbacks >= AUDIO_CALIBRATION_CALLBACKS;
+
+    // Until the interval is measured, what the device was asked for
+    double periodNs = static_cast<double>(periodNs_.load(std::memory_order_relaxed));
+    if (periodNs == 0.0) {
+        int frames = report.framesPerCallback > 0 ? report.framesPerCallback : report.bufferFrames;
+        periodNs = frames * 1e9 / sampleRate;
+    }
+    report.periodMs = periodNs / 1e6;
+    report.latencyMs = report.periodMs * BUFFERED_PERIODS;
+    return report;
+}
+
+void AudioLatencyMonitor::print(std::ostream& out, const Report& report) {
+    out << "Audio: " << report.bufferFrames << " frame buffer, " << report.framesPerCallback
+        << " frames per callback every " << report.periodMs << " ms, output latency ~" << report.latencyMs
+        << " ms, " << report.underruns << " underruns in " << report.callbacks << " callbacks\n";
+}
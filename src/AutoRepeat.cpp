@@ -0,0 +1,169 @@
+#include "AutoRepeat.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+// A whole number of at least `minimum`, or nothing
+std::optional<int> parseSetting(const char* name, const char* setting, int minimum) {
+    if (!setting) {
+        return std::nullopt;
+    }
+
+    char* end = nullptr;
+    long value = std::strtol(setting, &end, 10);
+    if (end == setting || *end != '\0' || value < minimum || value > 10000) {
+        std::cerr << "Ignoring " << name << "=" << setting << ", expected a whole number from "
+                  << minimum << " to 10000" << std::endl;
+        return std::nullopt;
+    }
+    return static_cast<int>(value);
+}
+
+} // namespace
+
+AutoRepeat::Settings AutoRepeat::settingsFrom(const char* das, const char* arr, const char* softDropFactor) {
+    Settings settings;
+    if (auto ms = parseSetting("TETRIS_DAS_MS", das, 0)) {
+        settings.das = std::chrono::milliseconds(*ms);
+    }
+    if (auto ms = parseSetting("TETRIS_ARR_MS", arr, 0)) {
+        settings.arr = std::chrono::milliseconds(*ms);
+    }
+    if (auto factor = parseSetting("TETRIS_SOFT_DROP_FACTOR", softDropFactor, 1)) {
+        settings.softDropFactor = *factor;
+    }
+    return settings;
+}
+
+AutoRepeat::AutoRepeat() : AutoRepeat(Settings{}) {
+}
+
+AutoRepeat::AutoRepeat(Settings settings) : settings_(settings) {
+}
+
+void AutoRepeat::press(Key key, Clock::time_point at) {
+    KeyState& state = keys_[index(key)];
+    if (state.held) {
+        return;
+    }
+
+    state.held = true;
+    state.tapPending = true;
+    state.pressedAt = at;
+    state.nextRepeat = isHorizontal(key) ? at + settings_.das : at;
+
+    if (isHorizontal(key)) {
+        // The newest direction wins and charges DAS from scratch
+        shifting_ = key;
+        charged_ = false;
+    }
+}
+
+void AutoRepeat::release(Key key, Clock::time_point at) {
+    KeyState& state = keys_[index(key)];
+    if (!state.held) {
+        return;
+    }
+    state.held = false;
+
+    if (shifting_ == key) {
+        // Back to the other direction if it is still held, as if pressed again now
+        Key other = key == Key::Left ? Key::Right : Key::Left;
+        charged_ = false;
+        if (keys_[index(other)].held) {
+            shifting_ = other;
+            keys_[index(other)].nextRepeat = at + settings_.das;
+        } else {
+            shifting_.reset();
+        }
+    }
+}
+
+void AutoRepeat::releaseAll() {
+    keys_ = {};
+    shifting_.reset();
+    charged_ = false;
+}
+
+AutoRepeat::Clock::duration AutoRepeat::softDropInterval(Clock::duration fallInterval) const {
+    return std::max<Clock::duration>(fallInterval / std::max(settings_.softDropFactor, 1), 1ms);
+}
+
+AutoRepeat::Clock::duration AutoRepeat::repeatInterval(Key key, Clock::duration fallInterval) const {
+    return isHorizontal(key) ? settings_.arr : softDropInterval(fallInterval);
+}
+
+std::optional<AutoRepeat::Clock::time_point> AutoRepeat::dueTime(Key key, Clock::duration fallInterval) const {
+    const KeyState& state = keys_[index(key)];
+    if (state.tapPending) {
+        return state.pressedAt;
+    }
+    if (!state.held) {
+        return std::nullopt;
+    }
+
+    if (key == Key::SoftDrop) {
+        return state.nextRepeat + softDropInterval(fallInterval);
+    }
+    if (shifting_ != key || (charged_ && settings_.arr == Clock::duration::zero())) {
+        return std::nullopt;  // Not the repeating direction, or already at the wall
+    }
+    return state.nextRepeat;
+}
+
+std::optional<AutoRepeat::Action> AutoRepeat::next(Clock::time_point now, Clock::duration fallInterval) {
+    std::optional<Key> earliest;
+    Clock::time_point earliestDue{};
+    for (Key key : {Key::Left, Key::Right, Key::SoftDrop}) {
+        auto due = dueTime(key, fallInterval);
+        if (due && *due <= now && (!earliest || *due < earliestDue)) {
+            earliest = key;
+            earliestDue = *due;
+        }
+    }
+    if (!earliest) {
+        return std::nullopt;
+    }
+
+    Key key = *earliest;
+    KeyState& state = keys_[index(key)];
+    if (state.tapPending) {
+        state.tapPending = false;
+        return Action{key, earliestDue, false, false};
+    }
+
+    // After a stall, skip whole intervals rather than replaying every repeat
+    Clock::duration interval = repeatInterval(key, fallInterval);
+    if (now - earliestDue > AUTO_REPEAT_MAX_LAG && interval > Clock::duration::zero()) {
+        earliestDue += (now - AUTO_REPEAT_MAX_LAG - earliestDue) / interval * interval;
+    }
+
+    if (key == Key::SoftDrop) {
+        state.nextRepeat = earliestDue;
+        return Action{key, earliestDue, true, false};
+    }
+
+    charged_ = true;
+    state.nextRepeat = earliestDue + interval;
+    return Action{key, earliestDue, true, settings_.arr == Clock::duration::zero()};
+}
+
+std::optional<AutoRepeat::Clock::time_point> AutoRepeat::nextDue(Clock::duration fallInterval) const {
+    std::optional<Clock::time_point> earliest;
+    for (Key key : {Key::Left, Key::Right, Key::SoftDrop}) {
+        auto due = dueTime(key, fallInterval);
+        if (due && (!earliest || *due < *earliest)) {
+            earliest = due;
+        }
+    }
+    return earliest;
+}
+
+std::optional<AutoRepeat::Key> AutoRepeat::heldAgainstWall() const {
+    if (charged_ && settings_.arr == Clock::duration::zero()) {
+        return shifting_;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,192 @@
+#include "BlockAtlas.h"
+#include "Color.h"
+#include "SoftwareRasterizer.h"
+#include <iostream>
+
+namespace {
+
+struct Rgba {
+    std::uint8_t r, g, b, a;
+};
+
+constexpr Rgba TRANSPARENT = {0, 0, 0, 0};
+constexpr Rgba GHOST_OUTLINE = {COLOR_MAX, COLOR_MAX, COLOR_MAX, ALPHA_OPAQUE};
+constexpr Rgba EMPTY_OUTLINE = {EMPTY_CELL_COLOR, EMPTY_CELL_COLOR, EMPTY_CELL_COLOR, ALPHA_OPAQUE};
+
+bool isEdge(int x, int y) {
+    return x == 0 || y == 0 || x == BlockAtlas::SPRITE_SIZE - 1 || y == BlockAtlas::SPRITE_SIZE - 1;
+}
+
+// Sprite pixels matching the old FillRect plus darker DrawRect look
+Rgba spritePixel(int sprite, int x, int y) {
+    if (sprite == BlockAtlas::EMPTY_CELL_SPRITE) {
+        return isEdge(x, y) ? EMPTY_OUTLINE : TRANSPARENT;
+    }
+    if (sprite == BlockAtlas::GHOST_SPRITE) {
+        return isEdge(x, y) ? GHOST_OUTLINE : TRANSPARENT;
+    }
+
+    const Color& color = COLORS[sprite];
+    if (isEdge(x, y)) {
+        return {static_cast<std::uint8_t>(color.r / HALF), static_cast<std::uint8_t>(color.g / HALF),
+                static_cast<std::uint8_t>(color.b / HALF), ALPHA_OPAQUE};
+    }
+    return {color.r, color.g, color.b, ALPHA_OPAQUE};
+}
+
+} // namespace
+
+BlockAtlas::~BlockAtlas() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+    }
+}
+
+bool BlockAtlas::build(SDL_Renderer* renderer) {
+    if (!renderer) {
+        return false;
+    }
+
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+    }
+    texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, ATLAS_WIDTH, ATLAS_HEIGHT);
+    if (!texture_) {
+        std::cerr << "Could not create block atlas, drawing cells as rectangles: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> pixels = renderPixels();
+    SDL_UpdateTexture(texture_, nullptr, pixels.data(), ATLAS_WIDTH * BYTES_PER_PIXEL);
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+SDL_Rect BlockAtlas::spriteRect(int sprite) {
+    return {sprite * BLOCK_SIZE, 0, SPRITE_SIZE, SPRITE_SIZE};
+}
+
+std::vector<std::uint8_t> BlockAtlas::renderPixels() {
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(ATLAS_WIDTH) * ATLAS_HEIGHT * BYTES_PER_PIXEL);
+
+    for (int sprite = 0; sprite < SPRITE_COUNT; sprite++) {
+        SDL_Rect rect = spriteRect(sprite);
+        for (int y = 0; y < rect.h; y++) {
+            for (int x = 0; x < rect.w; x++) {
+                Rgba pixel = spritePixel(sprite, x, y);
+                std::size_t offset = (static_cast<std::size_t>(y) * ATLAS_WIDTH + rect.x + x) * BYTES_PER_PIXEL;
+                pixels[offset] = pixel.r;
+                pixels[offset + 1] = pixel.g;
+                pixels[offset + 2] = pixel.b;
+                pixels[offset + 3] = pixel.a;
+            }
+        }
+    }
+
+    return pixels;
+}
+
+void BlockAtlas::add(int sprite, int x, int y, SDL_Color tint) {
+    quads_.push_back({sprite, x, y, tint});
+}
+
+void BlockAtlas::buildGeometry() {
+    vertices_.clear();
+    indices_.clear();
+
+    for (const Quad& quad : quads_) {
+        SDL_Rect source = spriteRect(quad.sprite);
+        auto first = static_cast<int>(vertices_.size());
+        float left = static_cast<float>(quad.x);
+        float top = static_cast<float>(quad.y);
+        float right = left + SPRITE_SIZE;
+        float bottom = top + SPRITE_SIZE;
+        float u0 = static_cast<float>(source.x) / ATLAS_WIDTH;
+        float u1 = static_cast<float>(source.x + source.w) / ATLAS_WIDTH;
+
+        vertices_.push_back({{left, top}, quad.tint, {u0, 0.0f}});
+        vertices_.push_back({{right, top}, quad.tint, {u1, 0.0f}});
+        vertices_.push_back({{right, bottom}, quad.tint, {u1, 1.0f}});
+        vertices_.push_back({{left, bottom}, quad.tint, {u0, 1.0f}});
+
+        for (int corner : {0, 1, 2, 0, 2, 3}) {
+            indices_.push_back(first + corner);
+        }
+    }
+}
+
+int BlockAtlas::flush(SDL_Renderer* renderer) {
+    if (quads_.empty()) {
+        return 0;
+    }
+
+    int drawCalls = 0;
+    if (!texture_) {
+        drawCalls = flushWithRects(renderer);
+    } else if (geometrySupported_) {
+        buildGeometry();
+        if (SDL_RenderGeometry(renderer, texture_, vertices_.data(), static_cast<int>(vertices_.size()),
+                               indices_.data(), static_cast<int>(indices_.size())) == 0) {
+            drawCalls = 1;
+        } else {
+            // Renderers before SDL 2.0.18 have no geometry support
+            std::cerr << "SDL_RenderGeometry failed, drawing blocks one by one: " << SDL_GetError() << std::endl;
+            geometrySupported_ = false;
+            drawCalls = flushWithCopies(renderer);
+        }
+    } else {
+        drawCalls = flushWithCopies(renderer);
+    }
+
+    quads_.clear();
+    return drawCalls;
+}
+
+void BlockAtlas::flush(SoftwareRasterizer& raster) {
+    // Same sprites as the texture, converted once for the CPU path
+    static const std::vector<std::uint32_t> spritePixels = SoftwareRasterizer::fromRgba32(renderPixels());
+
+    for (const Quad& quad : quads_) {
+        raster.blit(spritePixels, ATLAS_WIDTH, spriteRect(quad.sprite), quad.x, quad.y, quad.tint);
+    }
+    quads_.clear();
+}
+
+int BlockAtlas::flushWithCopies(SDL_Renderer* renderer) {
+    for (const Quad& quad : quads_) {
+        SDL_Rect source = spriteRect(quad.sprite);
+        SDL_Rect destination = {quad.x, quad.y, SPRITE_SIZE, SPRITE_SIZE};
+        SDL_SetTextureColorMod(texture_, quad.tint.r, quad.tint.g, quad.tint.b);
+        SDL_SetTextureAlphaMod(texture_, quad.tint.a);
+        SDL_RenderCopy(renderer, texture_, &source, &destination);
+    }
+
+    SDL_SetTextureColorMod(texture_, NO_TINT.r, NO_TINT.g, NO_TINT.b);
+    SDL_SetTextureAlphaMod(texture_, NO_TINT.a);
+    return static_cast<int>(quads_.size());
+}
+
+int BlockAtlas::flushWithRects(SDL_Renderer* renderer) {
+    int drawCalls = 0;
+    for (const Quad& quad : quads_) {
+        SDL_Rect rect = {quad.x, quad.y, SPRITE_SIZE, SPRITE_SIZE};
+
+        if (quad.sprite == EMPTY_CELL_SPRITE) {
+            SDL_SetRenderDrawColor(renderer, EMPTY_CELL_COLOR, EMPTY_CELL_COLOR, EMPTY_CELL_COLOR, ALPHA_OPAQUE);
+        } else if (quad.sprite == GHOST_SPRITE) {
+            SDL_SetRenderDrawColor(renderer, quad.tint.r, quad.tint.g, quad.tint.b, quad.tint.a);
+        } else {
+            const Color& color = COLORS[quad.sprite];
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, ALPHA_OPAQUE);
+            SDL_RenderFillRect(renderer, &rect);
+            drawCalls++;
+
+            // Add 3D effect with darker borders
+            SDL_SetRenderDrawColor(renderer, color.r / HALF, color.g / HALF, color.b / HALF, ALPHA_OPAQUE);
+        }
+
+        SDL_RenderDrawRect(renderer, &rect);
+        drawCalls++;
+    }
+    return drawCalls;
+}
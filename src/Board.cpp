@@ -0,0 +1,13 @@
+#include "Board.h"
+
+Board Board::fromGrid(const std::vector<std::vector<std::optional<TetrominoType>>>& grid) {
+    Board board;
+    for (int y = 0; y < GRID_HEIGHT; y++) {
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            if (grid[y][x].has_value()) {
+                board.setOccupied(x, y);
+            }
+        }
+    }
+    return board;
+}
@@ -0,0 +1,50 @@
+#include "BoardLayer.h"
+#include <iostream>
+
+BoardLayer::BoardLayer(SDL_Renderer* renderer)
+    : renderer_(renderer),
+      supported_(renderer != nullptr && SDL_RenderTargetSupported(renderer) == SDL_TRUE) {
+    if (renderer_ && !supported_) {
+        std::cout << "Render targets not supported, drawing the board every frame" << std::endl;
+    }
+}
+
+BoardLayer::~BoardLayer() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+    }
+}
+
+void BoardLayer::recreate() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    dirty_ = true;
+}
+
+bool BoardLayer::create() {
+    if (!supported_) {
+        return false;
+    }
+
+    texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, WIDTH, HEIGHT);
+    if (!texture_) {
+        std::cerr << "Could not create board layer texture: " << SDL_GetError() << std::endl;
+        disable();
+        return false;
+    }
+
+    // The layer is opaque, copying it replaces what is underneath
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_NONE);
+    dirty_ = true;
+    return true;
+}
+
+void BoardLayer::disable() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    supported_ = false;
+}
@@ -0,0 +1,240 @@
+#include "Finesse.h"
+#include "Tetromino.h"
+#include "TetrominoManager.h"
+
+namespace {
+
+// Box positions reachable by moves and kicks, shifted to be non-negative
+constexpr int STATE_OFFSET_X = TETROMINO_GRID_MAX_INDEX;
+constexpr int STATE_OFFSET_Y = TETROMINO_GRID_SIZE;
+constexpr int STATE_WIDTH = GRID_WIDTH + STATE_OFFSET_X;
+constexpr int STATE_HEIGHT = GRID_HEIGHT + STATE_OFFSET_Y;
+constexpr int STATE_COUNT = STATE_WIDTH * STATE_HEIGHT * TETROMINO_ROTATION_COUNT;
+constexpr int NOT_VISITED = -1;
+
+using FinesseTable = std::array<std::array<std::array<FinesseSequence, STATE_WIDTH>, TETROMINO_ROTATION_COUNT>,
+                                static_cast<std::size_t>(TetrominoType::COUNT)>;
+
+constexpr int stateIndex(const Tetromino& tetromino) {
+    int x = tetromino.x() + STATE_OFFSET_X;
+    int y = tetromino.y() + STATE_OFFSET_Y;
+    if (x < 0 || x >= STATE_WIDTH || y < 0 || y >= STATE_HEIGHT) {
+        return NOT_VISITED;
+    }
+    return (tetromino.rotation() * STATE_HEIGHT + y) * STATE_WIDTH + x;
+}
+
+constexpr Tetromino stateTetromino(TetrominoType type, int index) {
+    Tetromino tetromino(type, index % STATE_WIDTH - STATE_OFFSET_X,
+                        (index / STATE_WIDTH) % STATE_HEIGHT - STATE_OFFSET_Y);
+    for (int r = 0; r < index / (STATE_WIDTH * STATE_HEIGHT); r++) {
+        tetromino.rotateWithoutWallKick();
+    }
+    return tetromino;
+}
+
+// One press, as TetrominoManager and AutoRepeat play it
+constexpr void applyInput(Tetromino& tetromino, const Board& board, FinesseInput input) {
+    switch (input) {
+        case FinesseInput::MoveLeft:  tetromino.moveLeft(board); break;
+        case FinesseInput::MoveRight: tetromino.moveRight(board); break;
+        case FinesseInput::Rotate:    tetromino.rotate(board); break;
+        case FinesseInput::SoftDrop:  tetromino.moveDown(board); break;
+        case FinesseInput::HardDrop:  break;
+        case FinesseInput::DasLeft:
+        case FinesseInput::DasRight:
+            for (Tetromino before = tetromino;; before = tetromino) {
+                if (input == FinesseInput::DasLeft) {
+                    tetromino.moveLeft(board);
+                } else {
+                    tetromino.moveRight(board);
+                }
+                if (tetromino == before) {
+                    break;  // At the wall
+                }
+            }
+            break;
+    }
+}
+
+// Cells a piece covers once dropped, so that different rotations and box
+// positions ending in the same place compare equal
+constexpr std::uint64_t restingCells(const Board& board, TetrominoType type, int rotation, int x, int y) {
+    const PieceMask& mask = pieceMask(type, rotation);
+    int restY = board.dropY(mask, x, y);
+
+    auto key = static_cast<std::uint64_t>(restY + mask.top + STATE_OFFSET_Y);
+    for (int r = mask.top; r < mask.top + TETROMINO_GRID_SIZE; r++) {
+        std::uint64_t row = r < TETROMINO_GRID_SIZE ? mask.rows[r] : 0;
+        row = x >= 0 ? row << x : row >> -x;
+        key = (key << GRID_WIDTH) | row;
+    }
+    return key;
+}
+
+// Breadth-first search from spawn; onVisit sees states in order of input count
+// and returns true to stop. Returns the index of the state it stopped on.
+template <typename Visitor>
+constexpr int breadthFirst(const Board& board, TetrominoType type, bool allowSoftDrop,
+                 std::array<int, STATE_COUNT>& parent, std::array<FinesseInput, STATE_COUNT>& input,
+                 Visitor&& onVisit) {
+    parent.fill(NOT_VISITED);
+
+    Tetromino spawn = TetrominoManager::spawnTetromino(type);
+    int root = stateIndex(spawn);
+    if (root == NOT_VISITED || !spawn.isValidPosition(board, spawn.x(), spawn.y(), spawn.rotation())) {
+        return NOT_VISITED;
+    }
+
+    std::array<int, STATE_COUNT> queue{};
+    int head = 0;
+    int tail = 0;
+    parent[root] = root;
+    queue[tail++] = root;
+
+    while (head < tail) {
+        int index = queue[head++];
+        Tetromino current = stateTetromino(type, index);
+        if (onVisit(current, index)) {
+            return index;
+        }
+
+        // Taps before shifts, so a single column is a tap
+        for (FinesseInput move : {FinesseInput::MoveLeft, FinesseInput::MoveRight, FinesseInput::Rotate,
+                                  FinesseInput::SoftDrop, FinesseInput::DasLeft, FinesseInput::DasRight}) {
+            if (move == FinesseInput::SoftDrop && !allowSoftDrop) {
+                continue;
+            }
+            Tetromino next = current;
+            applyInput(next, board, move);
+
+            int nextIndex = stateIndex(next);
+            if (nextIndex != NOT_VISITED && parent[nextIndex] == NOT_VISITED) {
+                parent[nextIndex] = index;
+                input[nextIndex] = move;
+                queue[tail++] = nextIndex;
+            }
+        }
+    }
+
+    return NOT_VISITED;
+}
+
+constexpr std::optional<FinesseSequence> pathTo(int index, const std::array<int, STATE_COUNT>& parent,
+                                      const std::array<FinesseInput, STATE_COUNT>& input) {
+    std::array<FinesseInput, STATE_COUNT> reversed{};
+    int length = 0;
+    for (; parent[index] != index; index = parent[index]) {
+        reversed[length++] = input[index];
+    }
+
+    // Room for the final hard drop
+    if (length >= FINESSE_MAX_INPUTS) {
+        return std::nullopt;
+    }
+
+    FinesseSequence sequence;
+    for (int i = length - 1; i >= 0; i--) {
+        sequence.inputs[sequence.length++] = reversed[i];
+    }
+    sequence.inputs[sequence.length++] = FinesseInput::HardDrop;
+    return sequence;
+}
+
+constexpr FinesseTable buildEmptyBoardTable() {
+    FinesseTable table{};
+    Board empty;
+    std::array<int, STATE_COUNT> parent{};
+    std::array<FinesseInput, STATE_COUNT> input{};
+
+    for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+        auto pieceType = static_cast<TetrominoType>(type);
+
+        // Resting positions in visit order, so the first match for a position
+        // is its cheapest state. Soft drops never help on an empty board, so
+        // leave them out.
+        std::array<std::uint64_t, STATE_COUNT> resting{};
+        std::array<int, STATE_COUNT> visited{};
+        int visitCount = 0;
+        breadthFirst(empty, pieceType, false, parent, input, [&](const Tetromino& state, int index) {
+            resting[visitCount] = restingCells(empty, pieceType, state.rotation(), state.x(), state.y());
+            visited[visitCount++] = index;
+            return false;
+        });
+
+        for (int rotation = 0; rotation < TETROMINO_ROTATION_COUNT; rotation++) {
+            const PieceMask& mask = pieceMask(pieceType, rotation);
+            for (int x = -mask.minX; x + mask.maxX < GRID_WIDTH; x++) {
+                std::uint64_t target = restingCells(empty, pieceType, rotation, x, -mask.top);
+                for (int i = 0; i < visitCount; i++) {
+                    if (resting[i] == target) {
+                        auto sequence = pathTo(visited[i], parent, input);
+                        if (sequence) {
+                            table[type][rotation][x + STATE_OFFSET_X] = *sequence;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+// Built by the compiler from the same movement and kick code the game runs
+constexpr FinesseTable EMPTY_BOARD_TABLE = buildEmptyBoardTable();
+
+} // namespace
+
+const FinesseSequence& Finesse::emptyBoardSequence(TetrominoType type, int rotation, int x) {
+    static constexpr FinesseSequence unreachable{};
+
+    if (x + STATE_OFFSET_X < 0 || x + STATE_OFFSET_X >= STATE_WIDTH) {
+        return unreachable;
+    }
+    return EMPTY_BOARD_TABLE[static_cast<std::size_t>(type)][rotation % TETROMINO_ROTATION_COUNT][x + STATE_OFFSET_X];
+}
+
+std::optional<FinesseSequence> Finesse::sequenceFor(const Board& board, const Placement& placement) {
+    const FinesseSequence& cached = emptyBoardSequence(placement.type, placement.rotation, placement.x);
+    if (cached.length > 0) {
+        auto reached = simulate(board, placement.type, cached);
+        if (reached &&
+            restingCells(board, reached->type, reached->rotation, reached->x, reached->y) ==
+            restingCells(board, placement.type, placement.rotation, placement.x, placement.y)) {
+            return cached;
+        }
+    }
+
+    return search(board, placement);
+}
+
+std::optional<FinesseSequence> Finesse::search(const Board& board, const Placement& placement) {
+    std::array<int, STATE_COUNT> parent{};
+    std::array<FinesseInput, STATE_COUNT> input{};
+    std::uint64_t target = restingCells(board, placement.type, placement.rotation, placement.x, placement.y);
+
+    int found = breadthFirst(board, placement.type, true, parent, input, [&](const Tetromino& state, int) {
+        return restingCells(board, placement.type, state.rotation(), state.x(), state.y()) == target;
+    });
+
+    if (found == NOT_VISITED) {
+        return std::nullopt;
+    }
+    return pathTo(found, parent, input);
+}
+
+std::optional<Placement> Finesse::simulate(const Board& board, TetrominoType type, const FinesseSequence& sequence) {
+    Tetromino tetromino = TetrominoManager::spawnTetromino(type);
+    if (!tetromino.isValidPosition(board, tetromino.x(), tetromino.y(), tetromino.rotation())) {
+        return std::nullopt;
+    }
+
+    for (int i = 0; i < sequence.length && sequence.inputs[i] != FinesseInput::HardDrop; i++) {
+        applyInput(tetromino, board, sequence.inputs[i]);
+    }
+
+    const PieceMask& mask = pieceMask(type, tetromino.rotation());
+    return Placement{type, tetromino.rotation(), tetromino.x(), board.dropY(mask, tetromino.x(), tetromino.y())};
+}
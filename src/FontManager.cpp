@@ -0,0 +1,110 @@
+#include "FontManager.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+FontManager::~FontManager() {
+    // closeFont() is not dispatched virtually from here, close directly
+    for (auto& [key, font] : fonts_) {
+        if (font) {
+            TTF_CloseFont(font);
+        }
+    }
+}
+
+bool FontManager::resolve(std::span<const char* const> candidates, int size) {
+    for (const char* path : candidates) {
+        std::cout << "Trying font: " << path << '\n';
+
+        if (get(path, size)) {
+            path_ = path;
+            memory_ = {};
+            std::cout << "Successfully loaded font: " << path << '\n';
+            return true;
+        }
+
+        std::cerr << "Failed to load font from " << path << ": " << TTF_GetError() << std::endl;
+    }
+
+    return false;
+}
+
+bool FontManager::resolve(std::span<const char* const> candidates, int size, const std::string& cacheFile) {
+    std::string cached;
+    if (std::ifstream in(cacheFile); in && std::getline(in, cached) && !cached.empty() && get(cached, size)) {
+        path_ = cached;
+        memory_ = {};
+        std::cout << "Using cached font: " << path_ << '\n';
+        return true;
+    }
+
+    if (!resolve(candidates, size)) {
+        return false;
+    }
+
+    if (std::ofstream out(cacheFile); out) {
+        out << path_ << '\n';
+    }
+    return true;
+}
+
+bool FontManager::resolveMemory(const std::string& name, std::span<const std::byte> data, int size) {
+    path_ = name;
+    memory_ = data;
+    if (get(size)) {
+        std::cout << "Loaded font from memory: " << name << '\n';
+        return true;
+    }
+
+    std::cerr << "Failed to load font " << name << " from memory: " << TTF_GetError() << std::endl;
+    path_.clear();
+    memory_ = {};
+    return false;
+}
+
+TTF_Font* FontManager::get(int size) {
+    if (path_.empty()) {
+        return nullptr;
+    }
+    return get(path_, size);
+}
+
+TTF_Font* FontManager::get(const std::string& path, int size) {
+    auto key = std::make_pair(path, size);
+    auto found = fonts_.find(key);
+    if (found != fonts_.end()) {
+        return found->second;
+    }
+
+    TTF_Font* font = !memory_.empty() && path == path_ ? openFontMemory(memory_, size) : openFont(path, size);
+    fonts_.emplace(std::move(key), font);
+    return font;
+}
+
+std::size_t FontManager::openCount() const {
+    return static_cast<std::size_t>(std::count_if(fonts_.begin(), fonts_.end(),
+                                                  [](const auto& entry) { return entry.second != nullptr; }));
+}
+
+void FontManager::closeAll() {
+    for (auto& [key, font] : fonts_) {
+        if (font) {
+            closeFont(font);
+        }
+    }
+    fonts_.clear();
+}
+
+TTF_Font* FontManager::openFont(const std::string& path, int size) {
+    return TTF_OpenFont(path.c_str(), size);
+}
+
+TTF_Font* FontManager::openFontMemory(std::span<const std::byte> data, int size) {
+    // Each font reads through its own RWops, freed when the font is closed
+    SDL_RWops* stream = SDL_RWFromConstMem(data.data(), static_cast<int>(data.size()));
+    return stream ? TTF_OpenFontRW(stream, 1, size) : nullptr;
+}
+
+void FontManager::closeFont(TTF_Font* font) {
+    TTF_CloseFont(font);
+}
@@ -0,0 +1,80 @@
+#include "FramePacer.h"
+#include <iostream>
+#include <thread>
+
+FramePacer::FramePacer(int refreshRate, bool vsync)
+    : refreshRate_(DEFAULT_REFRESH_RATE), vsync_(vsync), interval_() {
+    setRefreshRate(refreshRate);
+}
+
+int FramePacer::detectRefreshRate(SDL_Window* window) {
+    if (!window) {
+        return DEFAULT_REFRESH_RATE;
+    }
+
+    int display = SDL_GetWindowDisplayIndex(window);
+    SDL_DisplayMode mode;
+    if (display < 0 || SDL_GetCurrentDisplayMode(display, &mode) != 0) {
+        std::cerr << "Could not query display mode, assuming " << DEFAULT_REFRESH_RATE << " Hz: " << SDL_GetError() << std::endl;
+        return DEFAULT_REFRESH_RATE;
+    }
+
+    // Some drivers report 0 for "unspecified"
+    return mode.refresh_rate > 0 ? mode.refresh_rate : DEFAULT_REFRESH_RATE;
+}
+
+void FramePacer::setRefreshRate(int refreshRate) {
+    refreshRate_ = refreshRate > 0 ? refreshRate : DEFAULT_REFRESH_RATE;
+    interval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / refreshRate_;
+}
+
+void FramePacer::waitForNextFrame() {
+    if (vsync_ || !presented_) {
+        return;
+    }
+
+    Clock::time_point current = now();
+    if (current >= nextFrame_) {
+        return;
+    }
+
+    Clock::duration remaining = nextFrame_ - current;
+    if (remaining > SPIN_MARGIN) {
+        sleepFor(remaining - SPIN_MARGIN);
+    }
+    spinUntil(nextFrame_);
+}
+
+void FramePacer::framePresented() {
+    Clock::time_point current = now();
+
+    if (presented_) {
+        Clock::duration frameTime = current - lastPresent_;
+        if (frameTime <= interval_ * IDLE_FRAMES) {
+            stats_.add(frameTime);
+        }
+    }
+
+    // Stay on the grid while keeping up, start a new one after idle or a missed slot
+    if (!presented_ || nextFrame_ + interval_ < current) {
+        nextFrame_ = current + interval_;
+    } else {
+        nextFrame_ += interval_;
+    }
+
+    lastPresent_ = current;
+    presented_ = true;
+}
+
+void FramePacer::sleepFor(Clock::duration duration) {
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+    if (milliseconds.count() > 0) {
+        SDL_Delay(static_cast<Uint32>(milliseconds.count()));
+    }
+}
+
+void FramePacer::spinUntil(Clock::time_point deadline) {
+    while (now() < deadline) {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,26 @@
+#include "FrameProfiler.h"
+
+void FrameProfiler::record(FramePhase phase, Clock::duration duration) {
+    phases_[static_cast<std::size_t>(phase)].add(std::chrono::duration_cast<FrameStats::Duration>(duration));
+}
+
+const char* FrameProfiler::phaseName(FramePhase phase) {
+    switch (phase) {
+        case FramePhase::Input: return "Input";
+        case FramePhase::Update: return "Update";
+        case FramePhase::InputLag: return "Inp lag";
+        case FramePhase::Board: return "Board";
+        case FramePhase::Pieces: return "Pieces";
+        case FramePhase::Sidebar: return "Sidebar";
+        case FramePhase::Overlay: return "Overlay";
+        case FramePhase::Hud: return "HUD";
+        case FramePhase::Present: return "Present";
+        case FramePhase::COUNT: break;
+    }
+    return "?";
+}
+
+void FrameProfiler::setFrameCounts(int drawCalls, int textureUploads) {
+    drawCalls_ = drawCalls;
+    textureUploads_ = textureUploads;
+}
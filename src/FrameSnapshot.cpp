@@ -0,0 +1,33 @@
+#include "FrameSnapshot.h"
+#include "Game.h"
+#include "GameRenderer.h"
+#include "TetrominoManager.h"
+
+void FrameSnapshot::capture(const Game& game, const TetrominoManager& tetrominoManager, Uint32 ticks) {
+    state = game.getGameState();
+
+    // Only copy the board when it changed, rows keep their capacity
+    if (grid.empty() || boardVersion != game.getBoardVersion()) {
+        grid = game.getGrid();
+        boardVersion = game.getBoardVersion();
+    }
+
+    piece.reset();
+    ghost.reset();
+    if (const Tetromino* current = tetrominoManager.getCurrentTetromino()) {
+        piece = *current;
+        // Where a hard drop would put it, from the same cache gravity uses
+        if (int distance = tetrominoManager.dropDistance(); distance > 0) {
+            ghost = *current;
+            ghost->setPosition(current->x(), current->y() + distance);
+        }
+    }
+
+    next = tetrominoManager.getNextTetrominoType();
+    score = game.getScore();
+    level = game.getLevel();
+    lines = game.getLinesCleared();
+    finesseFaults = game.getFinesseFaults();
+    blinkOn = state == GameState::StartScreen && GameRenderer::blinkOn(ticks);
+}
+
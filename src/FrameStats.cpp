@@ -0,0 +1,83 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+double toMilliseconds(FrameStats::Duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+void FrameStats::add(Duration sample) {
+    samples_[next_] = sample;
+    next_ = (next_ + 1) % CAPACITY;
+    count_ = std::min(count_ + 1, CAPACITY);
+}
+
+void FrameStats::reset() {
+    next_ = 0;
+    count_ = 0;
+}
+
+FrameStats::Duration FrameStats::last() const {
+    if (empty()) {
+        return Duration::zero();
+    }
+    return samples_[(next_ + CAPACITY - 1) % CAPACITY];
+}
+
+FrameStats::Duration FrameStats::mean() const {
+    if (empty()) {
+        return Duration::zero();
+    }
+
+    Duration total = Duration::zero();
+    for (std::size_t i = 0; i < count_; i++) {
+        total += samples_[i];
+    }
+    return total / static_cast<Duration::rep>(count_);
+}
+
+FrameStats::Duration FrameStats::max() const {
+    if (empty()) {
+        return Duration::zero();
+    }
+    return *std::max_element(samples_.begin(), samples_.begin() + static_cast<std::ptrdiff_t>(count_));
+}
+
+double FrameStats::variance() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+
+    double average = toMilliseconds(mean());
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count_; i++) {
+        double delta = toMilliseconds(samples_[i]) - average;
+        sum += delta * delta;
+    }
+    return sum / static_cast<double>(count_ - 1);
+}
+
+double FrameStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+FrameStats::Duration FrameStats::percentile(double p) const {
+    if (empty()) {
+        return Duration::zero();
+    }
+
+    // Sorted copy on the stack, the ring itself keeps arrival order
+    std::array<Duration, CAPACITY> sorted;
+    auto end = std::copy_n(samples_.begin(), count_, sorted.begin());
+
+    double clamped = std::clamp(p, 0.0, 100.0);
+    auto rank = static_cast<std::size_t>(std::ceil(clamped / 100.0 * static_cast<double>(count_)));
+    std::size_t index = rank == 0 ? 0 : rank - 1;
+
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), end);
+    return sorted[index];
+}
@@ -1,6 +1,7 @@
 #include "Game.h"
 #include <iostream>
 #include <algorithm>
+#include <string_view>
 
 Game::Game(bool test_mode) : 
     tetrominoManager_(nullptr),
@@ -13,24 +14,34 @@ Game::Game(bool test_mode) :
     score_(0),
     level_(INITIAL_LEVEL),
     linesCleared_(0),
+    finesseFaults_(0),
+    boardVersion_(0),
+    autoRepeat_(AutoRepeat::settingsFrom(SDL_getenv("TETRIS_DAS_MS"), SDL_getenv("TETRIS_ARR_MS"),
+                                         SDL_getenv("TETRIS_SOFT_DROP_FACTOR"))),
     window_(nullptr, SDL_DestroyWindow),
-    renderer_(nullptr, SDL_DestroyRenderer),
-    font_(nullptr, TTF_CloseFont) {
+    renderer_(nullptr, SDL_DestroyRenderer) {
     
     if (!test_mode) {
         initSDL();
         
         soundManager_ = std::make_unique<SoundManager>();
-        if (!soundManager_->initialize()) {
-            std::cerr << "Warning: Sound system could not be initialized. Continuing without sound." << std::endl;
-        } else if (!soundManager_->loadSounds()) {
-            std::cerr << "Warning: Some sound effects could not be loaded." << std::endl;
+        {
+            auto scope = startup_.measure("audio");
+            if (!soundManager_->initialize()) {
+                std::cerr << "Warning: Sound system could not be initialized. Continuing without sound." << std::endl;
+            } else {
+                if (assets_.isOpen()) {
+                    soundManager_->setArchive(&assets_);
+                }
+                soundManager_->loadSoundsAsync();
+            }
         }
         
         // Create component managers - order matters due to dependencies
+        auto scope = startup_.measure("game");
         tetrominoManager_ = std::make_unique<TetrominoManager>(*this);
         inputHandler_ = std::make_unique<InputHandler>(*this, *tetrominoManager_);
-        gameRenderer_ = std::make_unique<GameRenderer>(*this, *tetrominoManager_, renderer_.get(), font_.get());
+        gameRenderer_ = std::make_unique<GameRenderer>(renderer_.get(), fontManager_, profiler_, renderBackend_);
     } else {
         // Just create the tetromino manager for test mode
         soundManager_ = std::make_unique<SoundManager>();
@@ -41,6 +52,50 @@ Game::Game(bool test_mode) :
 }
 
 Game::~Game() {
+    if (window_ && !framePacer_.stats().empty()) {
+        const FrameStats& stats = framePacer_.stats();
+        auto toMilliseconds = [](FrameStats::Duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+        std::cout << "Frame pacing at " << framePacer_.getRefreshRate() << " Hz"
+                  << (framePacer_.hasVSync() ? " (vsync)" : "") << ": mean "
+                  << toMilliseconds(stats.mean()) << " ms, p99 " << toMilliseconds(stats.percentile(99))
+                  << " ms, stddev " << stats.stddev() << " ms over " << stats.size() << " frames\n";
+    }
+    
+    const FrameStats& inputLag = profiler_.phase(FramePhase::InputLag);
+    if (!inputLag.empty()) {
+        std::cout << "Input to logic: p50 " << std::chrono::duration<double, std::milli>(inputLag.percentile(50)).count()
+                  << " ms, p99 " << std::chrono::duration<double, std::milli>(inputLag.percentile(99)).count()
+                  << " ms over " << inputLag.size() << " key presses and repeats (DAS "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(autoRepeat_.settings().das).count()
+                  << " ms, ARR "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(autoRepeat_.settings().arr).count()
+                  << " ms, soft drop x" << autoRepeat_.settings().softDropFactor << ")\n";
+    }
+    
+    if (Trace::enabled()) {
+        toggleTrace();  // Stops and writes what was recorded
+    }
+    
+    AudioLatencyMonitor::Report audio = soundManager_->audioLatency();
+    if (audio.callbacks > 0) {
+        AudioLatencyMonitor::print(std::cout, audio);
+    }
+    
+    // The renderer's caches hold textures, release them while SDL is still up
+    renderThread_.reset();
+    if (gameRenderer_) {
+        const TextCache& textCache = gameRenderer_->getRenderer().getTextCache();
+        std::cout << "Text cache: " << textCache.hits() << " hits, " << textCache.misses() << " misses, "
+                  << textCache.evictions() << " evictions, " << textCache.bytes() << " bytes\n";
+    }
+    gameRenderer_.reset();
+    fontManager_.closeAll();
+    
+    // Sounds may play straight from the archive mapping
+    soundManager_.reset();
+    
     // Only quit SDL if window was initialized (not in test mode)
     if (window_) {
         TTF_Quit();
@@ -49,8 +104,16 @@ Game::~Game() {
 }
 
 void Game::initSDL() {
-    // First, try setting the video driver to X11 for WSL2
-    SDL_setenv("SDL_VIDEODRIVER", "x11", 1);
+    // Each step is timed for the startup report
+    auto step = StartupProfiler::Clock::now();
+    auto lap = [this, &step](const char* name) {
+        auto now = StartupProfiler::Clock::now();
+        startup_.record(name, now - step);
+        step = now;
+    };
+    
+    // First, try setting the video driver to X11 for WSL2, unless one was chosen
+    SDL_setenv("SDL_VIDEODRIVER", "x11", 0);
     
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cerr << "First SDL init attempt failed, trying fallback video drivers" << std::endl;
@@ -61,10 +124,10 @@ void Game::initSDL() {
         
         for (const char* driver : drivers) {
             SDL_setenv("SDL_VIDEODRIVER", driver, 1);
-            std::cout << "Trying SDL video driver: " << driver << std::endl;
+            std::cout << "Trying SDL video driver: " << driver << '\n';
             
             if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) >= 0) {
-                std::cout << "Successfully initialized SDL with driver: " << driver << std::endl;
+                std::cout << "Successfully initialized SDL with driver: " << driver << '\n';
                 success = true;
                 break;
             }
@@ -82,6 +145,10 @@ void Game::initSDL() {
         std::cerr << "SDL_ttf could not initialize! TTF_Error: " << TTF_GetError() << std::endl;
         exit(EXIT_FAILURE);
     }
+    lap("SDL");
+    
+    openAssets();
+    lap("assets");
 
     // Create window with additional flags for better compatibility
     window_.reset(SDL_CreateWindow("Tetris C++23", 
@@ -97,10 +164,16 @@ void Game::initSDL() {
     
     // Log window information
     std::cout << "Window created successfully with dimensions: " 
-              << WINDOW_WIDTH << "x" << WINDOW_HEIGHT << std::endl;
+              << WINDOW_WIDTH << "x" << WINDOW_HEIGHT << '\n';
+    lap("window");
 
-    // Try first with hardware acceleration
-    renderer_.reset(SDL_CreateRenderer(window_.get(), -1, SDL_RENDERER_ACCELERATED));
+    // Try first with hardware acceleration, synced to the display if possible
+    Uint32 vsyncFlag = PREFER_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0;
+    renderer_.reset(SDL_CreateRenderer(window_.get(), -1, SDL_RENDERER_ACCELERATED | vsyncFlag));
+    if (!renderer_ && vsyncFlag != 0) {
+        std::cerr << "Vsync renderer could not be created: " << SDL_GetError() << std::endl;
+        renderer_.reset(SDL_CreateRenderer(window_.get(), -1, SDL_RENDERER_ACCELERATED));
+    }
     
     // If hardware acceleration fails, try software rendering
     if (!renderer_) {
@@ -114,15 +187,62 @@ void Game::initSDL() {
             exit(EXIT_FAILURE);
         }
         
-        std::cout << "Successfully created software renderer" << std::endl;
+        std::cout << "Successfully created software renderer" << '\n';
+        
+        // SDL's software renderer goes through its generic path for every
+        // rectangle, drawing the frame ourselves and copying it once is faster
+        renderBackend_ = RenderBackend::Software;
     } else {
-        std::cout << "Successfully created hardware-accelerated renderer" << std::endl;
+        std::cout << "Successfully created hardware-accelerated renderer" << '\n';
     }
+    
+    const char* forceSoftware = SDL_getenv("TETRIS_SOFTWARE_RASTER");
+    if (forceSoftware && std::string_view(forceSoftware) == "1") {
+        renderBackend_ = RenderBackend::Software;
+    }
+    
+    // Drivers may ignore the vsync request, only trust what the renderer reports
+    SDL_RendererInfo info{};
+    bool haveInfo = SDL_GetRendererInfo(renderer_.get(), &info) == 0;
+    bool vsync = haveInfo && (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    framePacer_.setVSync(vsync);
+    refreshRate_ = FramePacer::detectRefreshRate(window_.get());
+    framePacer_.setRefreshRate(refreshRate_);
+    glContext_ = haveInfo && info.name && std::string_view(info.name).starts_with("opengl");
+    std::cout << "Pacing frames at " << framePacer_.getRefreshRate() << " Hz "
+              << (vsync ? "with vsync" : "with sleep and spin") << '\n';
+    lap("renderer");
 
     loadFont();
+    lap("fonts");
+}
+
+void Game::openAssets() {
+    // Built next to the executable, the working directory is the fallback
+    std::string path = "assets.pak";
+    if (char* basePath = SDL_GetBasePath()) {
+        path = std::string(basePath) + path;
+        SDL_free(basePath);
+    }
+    
+    if (assets_.open(path) || assets_.open("assets.pak")) {
+        std::cout << "Opened asset archive with " << assets_.entries().size() << " entries" << '\n';
+    } else {
+        std::cerr << "No asset archive at " << path << ", loading loose files from resources/" << std::endl;
+    }
 }
 
 void Game::loadFont() {
+    // A font packed with the game needs no searching at all
+    auto packed = assets_.find("fonts/Arial.ttf");
+    if (!packed) {
+        packed = assets_.findFirst("fonts/");
+    }
+    if (packed && fontManager_.resolveMemory(std::string(packed->name), packed->data, FONT_SIZE)) {
+        fontManager_.get(LARGE_FONT_SIZE);
+        return;
+    }
+    
     // List of fonts to try in order of preference
     // The system fonts are full paths, the game-provided ones are relative
     const char* fontPaths[] = {
@@ -137,98 +257,341 @@ void Game::loadFont() {
         "Arial.ttf"                                    // Current directory fallback
     };
     
-    std::cout << "Attempting to load a font..." << std::endl;
+    std::cout << "Attempting to load a font..." << '\n';
     
-    for (const char* path : fontPaths) {
-        std::cout << "Trying font: " << path << std::endl;
-        font_.reset(TTF_OpenFont(path, FONT_SIZE));
-        
-        if (font_) {
-            std::cout << "Successfully loaded font: " << path << std::endl;
-            break;
-        } else {
-            std::cerr << "Failed to load font from " << path << ": " << TTF_GetError() << std::endl;
-        }
+    // The face found last time is tried before probing the list
+    std::string cacheFile;
+    if (char* prefPath = SDL_GetPrefPath("CppTetris", "Tetris")) {
+        cacheFile = std::string(prefPath) + "font.cache";
+        SDL_free(prefPath);
+    }
+    
+    // Every size the renderer uses is opened once here, the renderer only
+    // ever receives cached handles
+    bool resolved = cacheFile.empty() ? fontManager_.resolve(fontPaths, FONT_SIZE)
+                                      : fontManager_.resolve(fontPaths, FONT_SIZE, cacheFile);
+    if (resolved && !fontManager_.get(LARGE_FONT_SIZE)) {
+        std::cerr << "Failed to load large font size from " << fontManager_.getPath() << std::endl;
     }
     
-    if (!font_) {
+    // The renderer's glyph atlases render every glyph up front, a broken
+    // font shows up there without a separate test render
+    if (!fontManager_.get(FONT_SIZE)) {
         std::cerr << "Failed to load any font! TTF_Error: " << TTF_GetError() << std::endl;
         std::cerr << "Will continue without font - using blocks for score display." << std::endl;
-    } else {
-        // Test font rendering with a simple string to make sure it's working
-        SDL_Color color = {255, 255, 255, 255};
-        SDL_Surface* testSurface = TTF_RenderText_Solid(font_.get(), "Test", color);
-        
-        if (!testSurface) {
-            std::cerr << "Font loaded but test rendering failed! TTF_Error: " << TTF_GetError() << std::endl;
-        } else {
-            std::cout << "Font rendering test successful." << std::endl;
-            SDL_FreeSurface(testSurface);
-        }
     }
 }
 
 void Game::run() {
-    auto lastFallTime = std::chrono::steady_clock::now();
-    auto lastFrameTime = std::chrono::steady_clock::now();
+    Trace::setThreadName("main");
+    if (const char* trace = SDL_getenv("TETRIS_TRACE")) {
+        tracePath_ = trace;
+        toggleTrace();
+    }
+    
+    const char* renderThread = SDL_getenv("TETRIS_RENDER_THREAD");
+    if (renderThread ? std::string_view(renderThread) == "1" : USE_RENDER_THREAD) {
+        startRenderThread();
+    }
+    
+    auto lastTickTime = std::chrono::steady_clock::now();
     
     while (!quit_) {
-        auto currentTime = std::chrono::steady_clock::now();
+        TRACE_ZONE("Game::run");
         
-        quit_ = inputHandler_->processEvents();
+        // Wait for the display slot before reading input, so the frame drawn
+        // below shows the state just simulated; the render thread paces itself
+        if (!renderThread_) {
+            framePacer_.waitForNextFrame();
+        }
+        
+        {
+            auto scope = profiler_.measure(FramePhase::Input);
+            quit_ = inputHandler_->processEvents();
+        }
+        
+        // After the events, so every key they pressed is already due
+        auto currentTime = std::chrono::steady_clock::now();
         
         if (gameState_ == GameState::Playing) {
-            updateGameState(currentTime, lastFallTime);
+            auto scope = profiler_.measure(FramePhase::Update);
+            updateGameState(currentTime, lastTickTime);
+        } else {
+            lastTickTime = currentTime;  // No ticks pile up while paused or on a menu
         }
         
-        gameRenderer_->render();
+        // Sounds queued by this frame's input and gravity start together
+        soundManager_->endFrame();
+        publishFrame();
         
-        capFrameRate(lastFrameTime);
+        if (!quit_) {
+            waitForEvents(lastTickTime);
+        }
+    }
+    
+    renderThread_.reset();
+}
+
+void Game::startRenderThread() {
+    // A GL context can only be current on one thread, let the render thread
+    // take it over and give it back when it stops
+    if (glContext_) {
+        SDL_GL_MakeCurrent(window_.get(), nullptr);
+    }
+    
+    SDL_Window* window = window_.get();
+    bool glContext = glContext_;
+    renderThread_ = std::make_unique<RenderThread>(
+        [this](const FrameSnapshot& snapshot) { drawFrame(snapshot); },
+        [window, glContext] {
+            if (glContext) {
+                SDL_GL_MakeCurrent(window, nullptr);
+            }
+        },
+        [this] { framePacer_.waitForNextFrame(); });
+    std::cout << "Rendering on a separate thread" << '\n';
+}
+
+void Game::publishFrame() {
+    // Nothing moved, the last presented frame is still correct
+    Uint32 ticks = SDL_GetTicks();
+    FrameKey key = GameRenderer::frameKey(*this, *tetrominoManager_, ticks);
+    if (!redrawRequested_ && lastFrame_ == key) {
+        return;
+    }
+    lastFrame_ = key;
+    redrawRequested_ = false;
+    
+    FrameSnapshot& snapshot = renderThread_ ? renderThread_->beginFrame() : snapshot_;
+    snapshot.capture(*this, *tetrominoManager_, ticks);
+    snapshot.sequence = ++frameSequence_;
+    snapshot.hudVisible = hudVisible_;
+    snapshot.renderResets = renderResets_;
+    snapshot.deviceResets = deviceResets_;
+    snapshot.refreshRate = refreshRate_;
+    
+    if (hudVisible_) {
+        for (std::size_t i = 0; i < FrameProfiler::PHASE_COUNT; i++) {
+            auto phase = static_cast<FramePhase>(i);
+            if (FrameProfiler::isSimulationPhase(phase)) {
+                const FrameStats& stats = profiler_.phase(phase);
+                snapshot.simulationTimings[i] = {stats.percentile(50), stats.percentile(95), stats.percentile(99)};
+            }
+        }
+        snapshot.audio = soundManager_->audioLatency();
+    }
+    
+    if (renderThread_) {
+        renderThread_->publish();
+    } else {
+        drawFrame(snapshot);
+    }
+}
+
+void Game::drawFrame(const FrameSnapshot& snapshot) {
+    // The pacer belongs to whichever thread draws, display changes reach it here
+    if (snapshot.refreshRate != framePacer_.getRefreshRate()) {
+        framePacer_.setRefreshRate(snapshot.refreshRate);
+        std::cout << "Display changed, pacing frames at " << framePacer_.getRefreshRate() << " Hz" << std::endl;
+    }
+    
+    gameRenderer_->render(snapshot);
+    framePacer_.framePresented();
+    
+    if (startup_.markFirstFrame()) {
+        startup_.report(std::cout);
+        std::cout.flush();
     }
 }
 
 void Game::updateGameState(const std::chrono::steady_clock::time_point& currentTime, 
-                          std::chrono::steady_clock::time_point& lastFallTime) {
-    auto fallSpeed = getFallSpeed();
-    if (currentTime - lastFallTime > fallSpeed) {
-        if (!tetrominoManager_->moveTetromino(NO_MOVE, MOVE_DOWN)) {
-            tetrominoManager_->lockTetromino();
-            tetrominoManager_->clearLines();
-            
-            if (!tetrominoManager_->createNewTetromino()) {
-                setGameOver();
+                          std::chrono::steady_clock::time_point& lastTickTime) {
+    TRACE_ZONE("Game::updateGameState");
+    if (currentTime - lastTickTime > SIMULATION_MAX_CATCH_UP) {
+        lastTickTime = currentTime - SIMULATION_MAX_CATCH_UP;
+    }
+    
+    // Every whole tick up to `until`, stopping if the game ends
+    auto runTicks = [&](std::chrono::steady_clock::time_point until) {
+        while (lastTickTime + SIMULATION_TICK <= until && gameState_ == GameState::Playing) {
+            lastTickTime += SIMULATION_TICK;
+            applyGravity();
+        }
+    };
+    
+    // Held and pressed keys in the order they happened, with the ticks before
+    // each one run first, so a move made just before the piece fell is
+    // applied before the fall
+    while (auto action = autoRepeat_.next(currentTime, getFallSpeed())) {
+        runTicks(action->at);
+        if (gameState_ != GameState::Playing) {
+            return;
+        }
+        applyInput(*action, currentTime);
+        if (gameState_ != GameState::Playing) {
+            return;
+        }
+    }
+    runTicks(currentTime);
+    
+    if (auto wall = autoRepeat_.heldAgainstWall(); wall && gameState_ == GameState::Playing) {
+        tetrominoManager_->shiftTetromino(*wall == AutoRepeat::Key::Left ? MOVE_LEFT : MOVE_RIGHT, GRID_WIDTH);
+    }
+}
+
+void Game::applyGravity() {
+    // Up to 20G in one step, through the cached drop distance
+    if (int rows = gravity_.step(level_); rows > 0) {
+        tetrominoManager_->dropTetromino(rows);
+    }
+    
+    if (tetrominoManager_->tickLockDelay()) {
+        tetrominoManager_->lockTetromino();
+        tetrominoManager_->clearLines();
+        
+        if (!tetrominoManager_->createNewTetromino()) {
+            setGameOver();
+        }
+    }
+}
+
+void Game::applyPendingInput(std::chrono::steady_clock::time_point at) {
+    while (gameState_ == GameState::Playing) {
+        auto action = autoRepeat_.next(at, getFallSpeed());
+        if (!action) {
+            break;
+        }
+        applyInput(*action, std::chrono::steady_clock::now());
+    }
+}
+
+void Game::applyInput(const AutoRepeat::Action& action, std::chrono::steady_clock::time_point now) {
+    switch (action.key) {
+        case AutoRepeat::Key::Left:
+        case AutoRepeat::Key::Right: {
+            int dx = action.key == AutoRepeat::Key::Left ? MOVE_LEFT : MOVE_RIGHT;
+            if (!action.repeat) {
+                tetrominoManager_->moveTetromino(dx, NO_MOVE);
+            } else {
+                tetrominoManager_->shiftTetromino(dx, action.toWall ? GRID_WIDTH : 1);
             }
+            break;
         }
-        lastFallTime = currentTime;
+            
+        case AutoRepeat::Key::SoftDrop:
+            tetrominoManager_->softDrop();
+            break;
+    }
+    
+    recordInputLatency(now - action.at);
+}
+
+void Game::waitForEvents(const std::chrono::steady_clock::time_point& lastTickTime) {
+    int ticks = gravity_.ticksUntilRow(level_);
+    if (tetrominoManager_->isGrounded()) {
+        ticks = std::min(ticks, tetrominoManager_->ticksUntilLock());
+    }
+    auto nextUpdate = lastTickTime + SIMULATION_TICK * ticks;
+    if (auto repeat = autoRepeat_.nextDue(getFallSpeed())) {
+        nextUpdate = std::min(nextUpdate, *repeat);
+    }
+    auto untilFall = nextUpdate - std::chrono::steady_clock::now();
+    int timeout = eventWaitTimeout(gameState_, untilFall, SDL_GetTicks(), hudVisible_);
+    
+    // A null event leaves whatever arrived in the queue for processEvents,
+    // so input wakes the loop immediately
+    if (!SDL_WaitEventTimeout(nullptr, timeout) && hudVisible_) {
+        // The HUD's numbers are not part of the frame key
+        requestRedraw();
     }
 }
 
-void Game::capFrameRate(std::chrono::steady_clock::time_point& lastFrameTime) {
-    auto frameTime = std::chrono::steady_clock::now() - lastFrameTime;
-    if (frameTime < TARGET_FRAME_TIME) {
-        SDL_Delay(static_cast<Uint32>((TARGET_FRAME_TIME - frameTime).count() / MICROSECONDS_PER_MILLISECOND));
+int Game::eventWaitTimeout(GameState state, std::chrono::steady_clock::duration untilFall, Uint32 ticks,
+                           bool hudVisible) {
+    int timeout = WAIT_FOREVER;
+    switch (state) {
+        case GameState::Playing: {
+            // Round up so the loop never wakes just before the step is due
+            auto wait = std::chrono::ceil<std::chrono::milliseconds>(untilFall);
+            timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(wait.count(), 0));
+            break;
+        }
+            
+        case GameState::StartScreen:
+            timeout = static_cast<int>(GameRenderer::untilBlinkToggle(ticks));
+            break;
+            
+        case GameState::Paused:
+        case GameState::GameOver:
+            break;
+    }
+    
+    if (hudVisible) {
+        auto refresh = static_cast<int>(std::chrono::milliseconds(HUD_REFRESH_INTERVAL).count());
+        timeout = timeout == WAIT_FOREVER ? refresh : std::min(timeout, refresh);
     }
-    lastFrameTime = std::chrono::steady_clock::now();
+    return timeout;
 }
 
-std::chrono::milliseconds Game::getFallSpeed() const {
-    // Speed increases with level
-    return std::chrono::milliseconds(
-        static_cast<int>(INITIAL_FALL_SPEED.count() / (1 + level_ * LEVEL_SPEED_FACTOR))
-    );
+std::chrono::nanoseconds Game::getFallSpeed() const {
+    return Gravity::rowInterval(level_);
 }
 
 bool Game::isPositionFree(int x, int y) const {
-    if (x < 0 || x >= GRID_WIDTH || y >= GRID_HEIGHT) {
-        return false;
+    // Walls and floor block, above the grid is free
+    return !board_.isOccupied(x, y);
+}
+
+void Game::handleRenderReset(bool deviceReset) {
+    if (deviceReset) {
+        deviceResets_++;
+    } else {
+        renderResets_++;
+    }
+    requestRedraw();
+}
+
+void Game::requestRedraw() {
+    redrawRequested_ = true;
+}
+
+void Game::toggleHud() {
+    hudVisible_ = !hudVisible_;
+    requestRedraw();
+}
+
+void Game::toggleTrace() {
+    if (!Trace::COMPILED_IN) {
+        std::cerr << "Tracing is not compiled in, configure with -DTETRIS_TRACING=ON" << std::endl;
+        return;
     }
     
-    // Above the grid is free
-    if (y < 0) {
-        return true;
+    if (!Trace::enabled()) {
+        Trace::setEnabled(true);
+        std::cout << "Tracing, press F4 again to write " << tracePath_ << '\n';
+        return;
     }
     
-    return !grid_[y][x].has_value();
+    Trace::setEnabled(false);
+    if (Trace::writeChromeJson(tracePath_)) {
+        std::cout << "Wrote " << tracePath_ << ", open it in chrome://tracing or ui.perfetto.dev" << '\n';
+    } else {
+        std::cerr << "Cannot write " << tracePath_ << std::endl;
+    }
+}
+
+void Game::recordInputLatency(Uint32 eventTimestamp) {
+    profiler_.record(FramePhase::InputLag, std::chrono::milliseconds(SDL_GetTicks() - eventTimestamp));
+}
+
+void Game::recordInputLatency(std::chrono::steady_clock::duration latency) {
+    profiler_.record(FramePhase::InputLag, std::max(latency, std::chrono::steady_clock::duration::zero()));
+}
+
+void Game::handleDisplayChanged() {
+    if (window_) {
+        refreshRate_ = FramePacer::detectRefreshRate(window_.get());
+    }
 }
 
 void Game::incrementLinesCleared(int lines) {
@@ -236,10 +599,11 @@ void Game::incrementLinesCleared(int lines) {
     
     // Check if we leveled up
     int oldLevel = level_;
-    level_ = std::min(INITIAL_LEVEL + linesCleared_ / LINES_PER_LEVEL, MAX_LEVEL);
+    level_ = levelForLines(linesCleared_);
     
     if (level_ > oldLevel) {
         playLevelUpSound();
+        soundManager_->playMusic(level_);
     }
 }
 
@@ -253,6 +617,9 @@ void Game::resetGame() {
     score_ = 0;
     level_ = INITIAL_LEVEL;
     linesCleared_ = 0;
+    finesseFaults_ = 0;
+    markBoardChanged();
+    soundManager_->playMusic(level_);
     
     // Create new tetromino
     tetrominoManager_->createNewTetromino();
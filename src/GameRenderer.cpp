@@ -1,119 +1,358 @@
 #include "GameRenderer.h"
 #include "Game.h"
 #include "TetrominoManager.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <format>
+#include <iostream>
 
-GameRenderer::GameRenderer(Game& game, TetrominoManager& tetrominoManager, 
-                           SDL_Renderer* renderer, TTF_Font* font)
-    : game_(game), tetrominoManager_(tetrominoManager) {
-    
-    renderer_ = std::make_unique<Renderer>(renderer, font);
+namespace {
+
+RenderCommand makeCommand(RenderOp op, FramePhase layer, int x = 0, int y = 0) {
+    return {op, 0, layer, static_cast<std::int16_t>(x), static_cast<std::int16_t>(y), 0, 0, {}, 0};
 }
 
-void GameRenderer::render() {
-    renderer_->clear();
-    
-    switch (game_.getGameState()) {
-        case GameState::StartScreen:
-            renderStartScreen();
-            break;
-            
-        case GameState::Playing:
-            renderGame();
-            break;
-            
-        case GameState::Paused:
-            renderGame();
-            renderPauseScreen();
-            break;
-            
-        case GameState::GameOver:
-            renderGame();
-            renderGameOver();
-            break;
-    }
-    
-    renderer_->present();
+void addText(RenderCommandList& commands, FramePhase layer, TextId id, int x, int y,
+             RenderOp op = RenderOp::Text) {
+    RenderCommand command = makeCommand(op, layer, x, y);
+    command.id = static_cast<std::uint8_t>(id);
+    commands.push(command);
+}
+
+void addValue(RenderCommandList& commands, FramePhase layer, TextId label, int value, int x, int y) {
+    RenderCommand command = makeCommand(RenderOp::Value, layer, x, y);
+    command.id = static_cast<std::uint8_t>(label);
+    command.value = value;
+    commands.push(command);
+}
+
+void addPreview(RenderCommandList& commands, FramePhase layer, TetrominoType type, int x, int y) {
+    RenderCommand command = makeCommand(RenderOp::Preview, layer, x, y);
+    command.id = static_cast<std::uint8_t>(type);
+    commands.push(command);
+}
+
+void addFill(RenderCommandList& commands, FramePhase layer, const SDL_Rect& rect, SDL_Color color) {
+    RenderCommand command = makeCommand(RenderOp::Fill, layer, rect.x, rect.y);
+    command.w = static_cast<std::int16_t>(rect.w);
+    command.h = static_cast<std::int16_t>(rect.h);
+    command.color = color;
+    commands.push(command);
 }
 
-void GameRenderer::renderStartScreen() {
+void buildStartScreen(const FrameSnapshot& snapshot, RenderCommandList& commands) {
+    constexpr FramePhase layer = FramePhase::Overlay;
+    
     // Set background color (slightly different from game background)
-    SDL_SetRenderDrawColor(renderer_->getRenderer(), 
-                          SCREEN_CLEAR_COLOR_R + 10, 
-                          SCREEN_CLEAR_COLOR_G + 10, 
-                          SCREEN_CLEAR_COLOR_B + 10, 
-                          SCREEN_CLEAR_COLOR_A);
     SDL_Rect fullScreen = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(renderer_->getRenderer(), &fullScreen);
+    addFill(commands, layer, fullScreen, {SCREEN_CLEAR_COLOR_R + 10, SCREEN_CLEAR_COLOR_G + 10,
+                                          SCREEN_CLEAR_COLOR_B + 10, SCREEN_CLEAR_COLOR_A});
     
     int titleY = 100;
-    renderer_->drawLargeText("C++23 TETRIS", WINDOW_WIDTH / 2 - 150, titleY);
+    addText(commands, layer, TextId::Title, WINDOW_WIDTH / 2 - 150, titleY, RenderOp::LargeText);
     
     int decorationY = titleY + 80;
     int spacing = 60;
     
     for (int i = 0; i < static_cast<int>(TetrominoType::COUNT); i++) {
-        TetrominoType type = static_cast<TetrominoType>(i);
         int x = (WINDOW_WIDTH / 2) - (static_cast<int>(TetrominoType::COUNT) * spacing) / 2 + i * spacing;
-        renderer_->drawNextTetromino(type, x, decorationY);
+        addPreview(commands, layer, static_cast<TetrominoType>(i), x, decorationY);
     }
     
     int instructionsY = decorationY + 120;
-    renderer_->drawText("Arrow Keys: Move and Rotate", WINDOW_WIDTH / 2 - 120, instructionsY);
-    renderer_->drawText("Space: Hard Drop", WINDOW_WIDTH / 2 - 120, instructionsY + 30);
-    renderer_->drawText("P: Pause Game", WINDOW_WIDTH / 2 - 120, instructionsY + 60);
-    renderer_->drawText("M: Toggle Sound", WINDOW_WIDTH / 2 - 120, instructionsY + 90);
-    renderer_->drawText("ESC: Quit Game", WINDOW_WIDTH / 2 - 120, instructionsY + 120);
+    addText(commands, layer, TextId::MoveHelp, WINDOW_WIDTH / 2 - 120, instructionsY);
+    addText(commands, layer, TextId::HardDropHelp, WINDOW_WIDTH / 2 - 120, instructionsY + 30);
+    addText(commands, layer, TextId::PauseHelp, WINDOW_WIDTH / 2 - 120, instructionsY + 60);
+    addText(commands, layer, TextId::SoundHelp, WINDOW_WIDTH / 2 - 120, instructionsY + 90);
+    addText(commands, layer, TextId::QuitHelp, WINDOW_WIDTH / 2 - 120, instructionsY + 120);
     
     int startY = instructionsY + 180;
-    renderer_->drawText("Press ENTER or SPACE to Start", WINDOW_WIDTH / 2 - 140, startY);
+    addText(commands, layer, TextId::StartHelp, WINDOW_WIDTH / 2 - 140, startY);
     
-    Uint32 ticks = SDL_GetTicks();
-    if ((ticks / 500) % 2 == 0) {  // Blink every 500ms
-        renderer_->drawText("> PRESS START <", WINDOW_WIDTH / 2 - 80, startY + 40);
+    if (snapshot.blinkOn) {
+        addText(commands, layer, TextId::PressStart, WINDOW_WIDTH / 2 - 80, startY + 40);
     }
     
-    renderer_->drawText("Version 1.0.0", 20, WINDOW_HEIGHT - 40);
+    addText(commands, layer, TextId::Version, 20, WINDOW_HEIGHT - 40);
 }
 
-void GameRenderer::renderGame() {
-    renderer_->drawGrid(game_.getGrid());
+void buildGame(const FrameSnapshot& snapshot, RenderCommandList& commands) {
+    commands.push(makeCommand(RenderOp::Board, FramePhase::Board));
     
-    const Tetromino* currentTetromino = tetrominoManager_.getCurrentTetromino();
-    
-    if (currentTetromino) {
-        renderer_->drawTetromino(*currentTetromino);
-        renderer_->drawGhostPiece(game_, *currentTetromino);
+    if (snapshot.piece) {
+        commands.push(makeCommand(RenderOp::Piece, FramePhase::Pieces));
+        if (snapshot.ghost) {
+            commands.push(makeCommand(RenderOp::Ghost, FramePhase::Pieces));
+        }
     }
     
-    renderer_->drawSidebar(game_, tetrominoManager_.getNextTetrominoType());
+    constexpr FramePhase layer = FramePhase::Sidebar;
+    int sidebarX = GRID_WIDTH * BLOCK_SIZE + SIDEBAR_PADDING;
+    int y = UI_PADDING_MEDIUM;
+    
+    addText(commands, layer, TextId::Next, sidebarX, y);
+    y += UI_PADDING_LARGE;
+    
+    addPreview(commands, layer, snapshot.next, sidebarX + BLOCK_SIZE, y);
+    y += TETROMINO_GRID_SIZE * BLOCK_SIZE + UI_PADDING_MEDIUM;
+    
+    addValue(commands, layer, TextId::Score, snapshot.score, sidebarX, y);
+    y += UI_PADDING_XLARGE;
+    
+    addValue(commands, layer, TextId::Level, snapshot.level, sidebarX, y);
+    y += UI_PADDING_XLARGE;
+    
+    addValue(commands, layer, TextId::Lines, snapshot.lines, sidebarX, y);
+    y += UI_PADDING_XXLARGE;
+    
+    addText(commands, layer, TextId::Controls, sidebarX, y);
+    for (TextId key : {TextId::MoveKeys, TextId::RotateKey, TextId::SoftDropKey, TextId::HardDropKey}) {
+        y += UI_PADDING_LARGE;
+        addText(commands, layer, key, sidebarX, y);
+    }
 }
 
-void GameRenderer::renderPauseScreen() {
-    SDL_SetRenderDrawColor(renderer_->getRenderer(), 0, 0, 0, 180);
-    SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(renderer_->getRenderer(), &overlay);
+void buildPauseScreen(RenderCommandList& commands) {
+    constexpr FramePhase layer = FramePhase::Overlay;
+    addFill(commands, layer, {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT}, {0, 0, 0, 180});
     
     int centerX = WINDOW_WIDTH / 2;
     int centerY = WINDOW_HEIGHT / 2;
     
-    renderer_->drawLargeText("PAUSED", centerX - 80, centerY - 60);
-    renderer_->drawText("Press P or ENTER to continue", centerX - 120, centerY);
-    renderer_->drawText("Press ESC to quit", centerX - 80, centerY + 40);
+    addText(commands, layer, TextId::Paused, centerX - 80, centerY - 60, RenderOp::LargeText);
+    addText(commands, layer, TextId::ContinueHelp, centerX - 120, centerY);
+    addText(commands, layer, TextId::QuitPausedHelp, centerX - 80, centerY + 40);
 }
 
-void GameRenderer::renderGameOver() {
+void buildGameOver(const FrameSnapshot& snapshot, RenderCommandList& commands) {
+    constexpr FramePhase layer = FramePhase::Overlay;
+    
     // Semi-transparent overlay
-    SDL_SetRenderDrawColor(renderer_->getRenderer(), 0, 0, 0, 200);
-    SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(renderer_->getRenderer(), &overlay);
+    addFill(commands, layer, {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT}, {0, 0, 0, 200});
     
     int centerX = WINDOW_WIDTH / 2;
     int centerY = WINDOW_HEIGHT / 2;
     
-    renderer_->drawLargeText("GAME OVER", centerX - 100, centerY - 60);
-    renderer_->drawText(std::format("Final Score: {}", game_.getScore()), 
-                      centerX - 80, centerY);
-    renderer_->drawText("Press ENTER to restart", centerX - 100, centerY + 40);
-    renderer_->drawText("Press ESC to quit", centerX - 80, centerY + 70);
+    addText(commands, layer, TextId::GameOver, centerX - 100, centerY - 60, RenderOp::LargeText);
+    addValue(commands, layer, TextId::FinalScore, snapshot.score, centerX - 80, centerY);
+    addValue(commands, layer, TextId::FinesseFaults, snapshot.finesseFaults, centerX - 80, centerY + 30);
+    addText(commands, layer, TextId::RestartHelp, centerX - 100, centerY + 70);
+    addText(commands, layer, TextId::QuitPausedHelp, centerX - 80, centerY + 100);
+}
+
+} // namespace
+
+GameRenderer::GameRenderer(SDL_Renderer* renderer, FontManager& fonts, FrameProfiler& profiler,
+                           RenderBackend backend)
+    : profiler_(profiler) {
+    
+    renderer_ = std::make_unique<Renderer>(renderer, fonts, backend);
+    
+    if (const char* delay = SDL_getenv("TETRIS_SLOW_PRESENT_MS")) {
+        presentDelay_ = static_cast<Uint32>(std::max(std::atoi(delay), 0));
+        std::cout << "Delaying every present by " << presentDelay_ << " ms" << std::endl;
+    }
+}
+
+FrameKey GameRenderer::frameKey(const Game& game, const TetrominoManager& tetrominoManager, Uint32 ticks) {
+    std::optional<Tetromino> piece;
+    if (const Tetromino* current = tetrominoManager.getCurrentTetromino()) {
+        piece = *current;
+    }
+    
+    GameState state = game.getGameState();
+    return {state, game.getBoardVersion(), piece, tetrominoManager.getNextTetrominoType(),
+            game.getScore(), game.getLevel(), game.getLinesCleared(), game.getFinesseFaults(),
+            state == GameState::StartScreen && blinkOn(ticks)};
+}
+
+void GameRenderer::buildCommands(const FrameSnapshot& snapshot, RenderCommandList& commands) {
+    commands.clear();
+    
+    switch (snapshot.state) {
+        case GameState::StartScreen:
+            buildStartScreen(snapshot, commands);
+            break;
+            
+        case GameState::Playing:
+            buildGame(snapshot, commands);
+            break;
+            
+        case GameState::Paused:
+            buildGame(snapshot, commands);
+            buildPauseScreen(commands);
+            break;
+            
+        case GameState::GameOver:
+            buildGame(snapshot, commands);
+            buildGameOver(snapshot, commands);
+            break;
+    }
+    
+    if (snapshot.hudVisible) {
+        commands.push(makeCommand(RenderOp::Hud, FramePhase::Hud));
+    }
+}
+
+void GameRenderer::render(const FrameSnapshot& snapshot) {
+    // Textures lost since the last frame, a device reset covers a target reset
+    if (snapshot.deviceResets != deviceResets_) {
+        renderer_->handleRenderReset(true);
+    } else if (snapshot.renderResets != renderResets_) {
+        renderer_->handleRenderReset(false);
+    }
+    deviceResets_ = snapshot.deviceResets;
+    renderResets_ = snapshot.renderResets;
+    
+    buildCommands(snapshot, commands_);
+    
+    renderer_->resetCounters();
+    renderer_->clear();
+    execute(snapshot);
+    
+    auto scope = profiler_.measure(FramePhase::Present);
+    renderer_->present();
+    if (presentDelay_ > 0) {
+        SDL_Delay(presentDelay_);
+    }
+}
+
+void GameRenderer::execute(const FrameSnapshot& snapshot) {
+    // Commands come grouped by layer, each run of a layer is timed as its phase
+    auto commands = commands_.commands();
+    bool counted = false;
+    auto start = FrameProfiler::Clock::now();
+    
+    for (std::size_t i = 0; i < commands.size(); i++) {
+        const RenderCommand& command = commands[i];
+        
+        // The HUD reports the frame without its own work
+        if (command.op == RenderOp::Hud) {
+            recordFrameCounts();
+            counted = true;
+        }
+        
+        draw(snapshot, command);
+        
+        if (i + 1 == commands.size() || commands[i + 1].layer != command.layer) {
+            auto now = FrameProfiler::Clock::now();
+            profiler_.record(command.layer, now - start);
+            start = now;
+        }
+    }
+    
+    if (!counted) {
+        recordFrameCounts();
+    }
+}
+
+void GameRenderer::draw(const FrameSnapshot& snapshot, const RenderCommand& command) {
+    auto text = static_cast<TextId>(command.id);
+    
+    switch (command.op) {
+        case RenderOp::Board:
+            renderer_->drawBoard(snapshot.grid, snapshot.boardVersion);
+            break;
+            
+        case RenderOp::Piece:
+            if (snapshot.piece) {
+                renderer_->drawTetromino(*snapshot.piece);
+            }
+            break;
+            
+        case RenderOp::Ghost:
+            if (snapshot.ghost) {
+                renderer_->drawGhost(*snapshot.ghost);
+            }
+            break;
+            
+        case RenderOp::Preview:
+            renderer_->drawNextTetromino(static_cast<TetrominoType>(command.id), command.x, command.y);
+            break;
+            
+        case RenderOp::Text:
+            renderer_->drawText(textFor(text), command.x, command.y);
+            break;
+            
+        case RenderOp::LargeText:
+            renderer_->drawLargeText(textFor(text), command.x, command.y);
+            break;
+            
+        case RenderOp::Value:
+            drawValue(text, command.value, command.x, command.y);
+            break;
+            
+        case RenderOp::Fill:
+            renderer_->fillRect({command.x, command.y, command.w, command.h}, command.color);
+            break;
+            
+        case RenderOp::Hud:
+            renderHud(snapshot);
+            break;
+    }
+}
+
+void GameRenderer::drawValue(TextId label, int value, int x, int y) {
+    // Values change from frame to frame, so they go through the glyph atlas
+    std::array<char, HUD_LINE_LENGTH> line;
+    auto result = std::format_to_n(line.data(), static_cast<std::ptrdiff_t>(line.size()), "{}{}",
+                                   textFor(label), value);
+    renderer_->drawDynamicText({line.data(), static_cast<std::size_t>(result.out - line.data())}, x, y);
+}
+
+void GameRenderer::recordFrameCounts() {
+    RenderCounters counters = renderer_->getCounters();
+    profiler_.setFrameCounts(counters.drawCalls, counters.textureUploads);
+}
+
+void GameRenderer::renderHud(const FrameSnapshot& snapshot) {
+    constexpr int lineCount = static_cast<int>(FrameProfiler::PHASE_COUNT) + 3;
+    SDL_Rect panel = {HUD_X, HUD_Y, HUD_WIDTH, lineCount * HUD_LINE_HEIGHT + UI_PADDING_SMALL * 2};
+    renderer_->fillRect(panel, {OVERLAY_COLOR_R, OVERLAY_COLOR_G, OVERLAY_COLOR_B, HUD_BACKGROUND_ALPHA});
+    
+    auto toMilliseconds = [](FrameStats::Duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    
+    int x = HUD_X + UI_PADDING_SMALL;
+    int y = HUD_Y + UI_PADDING_SMALL;
+    renderer_->drawText("ms        p50    p95    p99", x, y);
+    
+    // Numbers change every frame, so they go through the glyph atlas into a
+    // stack buffer: no texture uploads or heap allocations while measuring
+    std::array<char, HUD_LINE_LENGTH> line;
+    for (std::size_t i = 0; i < FrameProfiler::PHASE_COUNT; i++) {
+        auto phase = static_cast<FramePhase>(i);
+        
+        // The simulation may be on another thread, its timings come with the snapshot
+        FrameSnapshot::Percentiles timings = snapshot.simulationTimings[i];
+        if (!FrameProfiler::isSimulationPhase(phase)) {
+            const FrameStats& stats = profiler_.phase(phase);
+            timings = {stats.percentile(50), stats.percentile(95), stats.percentile(99)};
+        }
+        
+        auto result = std::format_to_n(line.data(), static_cast<std::ptrdiff_t>(line.size()),
+                                       "{:<8} {:6.2f} {:6.2f} {:6.2f}", FrameProfiler::phaseName(phase),
+                                       toMilliseconds(timings[0]), toMilliseconds(timings[1]),
+                                       toMilliseconds(timings[2]));
+        y += HUD_LINE_HEIGHT;
+        renderer_->drawDynamicText({line.data(), static_cast<std::size_t>(result.out - line.data())}, x, y);
+    }
+    
+    auto result = std::format_to_n(line.data(), static_cast<std::ptrdiff_t>(line.size()),
+                                   "Draw calls {}  Uploads {}", profiler_.getDrawCalls(),
+                                   profiler_.getTextureUploads());
+    y += HUD_LINE_HEIGHT;
+    renderer_->drawDynamicText({line.data(), static_cast<std::size_t>(result.out - line.data())}, x, y);
+    
+    // Measured from the audio callback, see AudioLatencyMonitor
+    const AudioLatencyMonitor::Report& audio = snapshot.audio;
+    result = audio.callbacks == 0
+                 ? std::format_to_n(line.data(), static_cast<std::ptrdiff_t>(line.size()), "Audio off")
+                 : std::format_to_n(line.data(), static_cast<std::ptrdiff_t>(line.size()),
+                                    "Audio {:5.1f} ms  {} frames  {} underruns", audio.latencyMs,
+                                    audio.framesPerCallback, audio.underruns);
+    y += HUD_LINE_HEIGHT;
+    renderer_->drawDynamicText({line.data(), static_cast<std::size_t>(result.out - line.data())}, x, y);
 }
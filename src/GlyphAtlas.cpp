@@ -0,0 +1,267 @@
+#include "GlyphAtlas.h"
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+constexpr SDL_Color GLYPH_COLOR = {255, 255, 255, 255};
+
+// Next codepoint of a UTF-8 string; malformed bytes decode as themselves
+char32_t decodeUtf8(std::string_view text, std::size_t& position) {
+    auto lead = static_cast<unsigned char>(text[position++]);
+    int continuation = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+    if (continuation == 0 || position + continuation > text.size()) {
+        return lead;
+    }
+
+    char32_t codepoint = lead & (0x3F >> continuation);
+    for (int i = 0; i < continuation; i++) {
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[position++]) & 0x3F);
+    }
+    return codepoint;
+}
+
+char32_t codepointAt(int index) {
+    constexpr int asciiCount = GlyphAtlas::LAST_ASCII - GlyphAtlas::FIRST_ASCII + 1;
+    return index < asciiCount ? GlyphAtlas::FIRST_ASCII + index : GlyphAtlas::FIRST_ARROW + (index - asciiCount);
+}
+
+} // namespace
+
+GlyphAtlas::~GlyphAtlas() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+    }
+}
+
+std::optional<int> GlyphAtlas::glyphIndex(char32_t codepoint) {
+    if (codepoint >= FIRST_ASCII && codepoint <= LAST_ASCII) {
+        return static_cast<int>(codepoint - FIRST_ASCII);
+    }
+    if (codepoint >= FIRST_ARROW && codepoint <= LAST_ARROW) {
+        return static_cast<int>(LAST_ASCII - FIRST_ASCII + 1 + codepoint - FIRST_ARROW);
+    }
+    return std::nullopt;
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+    if (!font) {
+        return false;
+    }
+
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    pixels_.clear();
+
+    // Nothing from a previous font survives, a glyph the new one lacks stays absent
+    glyphs_ = {};
+    std::fill(kerning_.begin(), kerning_.end(), 0);
+
+    // Rasterise every glyph and pack them into rows
+    std::array<SDL_Surface*, GLYPH_COUNT> surfaces{};
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        char32_t codepoint = codepointAt(i);
+        Glyph& glyph = glyphs_[i];
+        int minX, maxX, minY, maxY;
+        if (!TTF_GlyphIsProvided32(font, codepoint) ||
+            TTF_GlyphMetrics32(font, codepoint, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0) {
+            continue;
+        }
+
+        surfaces[i] = TTF_RenderGlyph32_Blended(font, codepoint, GLYPH_COLOR);
+        if (!surfaces[i]) {
+            continue;
+        }
+
+        if (penX + surfaces[i]->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + GLYPH_PADDING;
+            rowHeight = 0;
+        }
+        glyph.source = {penX, penY, surfaces[i]->w, surfaces[i]->h};
+        glyph.present = true;
+        penX += surfaces[i]->w + GLYPH_PADDING;
+        rowHeight = std::max(rowHeight, surfaces[i]->h);
+    }
+
+    // Copy the glyphs into one surface, then upload it once
+    setAtlasSize(ATLAS_WIDTH, penY + rowHeight);
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth_, atlasHeight_, 32, SDL_PIXELFORMAT_RGBA32);
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (!surfaces[i]) {
+            continue;
+        }
+        if (atlas) {
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surfaces[i], nullptr, atlas, &glyphs_[i].source);
+        }
+        SDL_FreeSurface(surfaces[i]);
+    }
+    if (!atlas) {
+        std::cerr << "Could not create glyph atlas surface: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    if (renderer) {
+        texture_ = SDL_CreateTextureFromSurface(renderer, atlas);
+    } else {
+        // Rows of the surface may be padded past atlasWidth_ pixels
+        std::vector<std::uint8_t> bytes(static_cast<std::size_t>(atlasWidth_) * atlasHeight_ * SoftwareRasterizer::BYTES_PER_PIXEL);
+        std::size_t rowBytes = static_cast<std::size_t>(atlasWidth_) * SoftwareRasterizer::BYTES_PER_PIXEL;
+        for (int y = 0; y < atlasHeight_; y++) {
+            const auto* row = static_cast<const std::uint8_t*>(atlas->pixels) + static_cast<std::size_t>(y) * atlas->pitch;
+            std::copy_n(row, rowBytes, bytes.begin() + static_cast<std::ptrdiff_t>(y * rowBytes));
+        }
+        pixels_ = SoftwareRasterizer::fromRgba32(bytes);
+    }
+    SDL_FreeSurface(atlas);
+    if (renderer && !texture_) {
+        std::cerr << "Could not create glyph atlas texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    if (texture_) {
+        SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+    }
+
+    // Kerning for every pair of atlas glyphs, so layout never calls into the font
+    for (int previous = 0; previous < GLYPH_COUNT; previous++) {
+        for (int current = 0; current < GLYPH_COUNT; current++) {
+            if (glyphs_[previous].present && glyphs_[current].present) {
+                int kerning = TTF_GetFontKerningSizeGlyphs32(font, codepointAt(previous), codepointAt(current));
+                setKerning(codepointAt(previous), codepointAt(current), kerning);
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename Visitor>
+int GlyphAtlas::forEachGlyph(std::string_view text, int x, Visitor&& visit) const {
+    int penX = x;
+    std::optional<int> previous;
+
+    for (std::size_t position = 0; position < text.size();) {
+        std::optional<int> index = glyphIndex(decodeUtf8(text, position));
+        if (!index || !glyphs_[*index].present) {
+            continue;
+        }
+
+        if (previous) {
+            penX += kerning_[*previous * GLYPH_COUNT + *index];
+        }
+        visit(glyphs_[*index], penX);
+        penX += glyphs_[*index].advance;
+        previous = index;
+    }
+
+    return penX;
+}
+
+int GlyphAtlas::layout(std::string_view text, int x, int y, SDL_Color color) {
+    vertices_.clear();
+    indices_.clear();
+    vertices_.reserve(text.size() * VERTICES_PER_GLYPH);
+    indices_.reserve(text.size() * INDICES_PER_GLYPH);
+
+    float scaleX = atlasWidth_ > 0 ? 1.0f / atlasWidth_ : 0.0f;
+    float scaleY = atlasHeight_ > 0 ? 1.0f / atlasHeight_ : 0.0f;
+
+    int end = forEachGlyph(text, x, [&](const Glyph& glyph, int penX) {
+        auto first = static_cast<int>(vertices_.size());
+        float left = static_cast<float>(penX);
+        float top = static_cast<float>(y);
+        float right = left + glyph.source.w;
+        float bottom = top + glyph.source.h;
+        float u0 = glyph.source.x * scaleX;
+        float v0 = glyph.source.y * scaleY;
+        float u1 = (glyph.source.x + glyph.source.w) * scaleX;
+        float v1 = (glyph.source.y + glyph.source.h) * scaleY;
+
+        vertices_.push_back({{left, top}, color, {u0, v0}});
+        vertices_.push_back({{right, top}, color, {u1, v0}});
+        vertices_.push_back({{right, bottom}, color, {u1, v1}});
+        vertices_.push_back({{left, bottom}, color, {u0, v1}});
+
+        for (int corner : {0, 1, 2, 0, 2, 3}) {
+            indices_.push_back(first + corner);
+        }
+    });
+
+    return end - x;
+}
+
+bool GlyphAtlas::draw(SDL_Renderer* renderer, std::string_view text, int x, int y, SDL_Color color) {
+    if (!texture_) {
+        return false;
+    }
+
+    if (geometrySupported_) {
+        layout(text, x, y, color);
+        if (indices_.empty()) {
+            return true;
+        }
+        if (SDL_RenderGeometry(renderer, texture_, vertices_.data(), static_cast<int>(vertices_.size()),
+                               indices_.data(), static_cast<int>(indices_.size())) == 0) {
+            return true;
+        }
+
+        // Renderers before SDL 2.0.18 have no geometry support
+        std::cerr << "SDL_RenderGeometry failed, drawing glyphs one by one: " << SDL_GetError() << std::endl;
+        geometrySupported_ = false;
+    }
+
+    drawWithCopies(renderer, text, x, y, color);
+    return true;
+}
+
+void GlyphAtlas::drawWithCopies(SDL_Renderer* renderer, std::string_view text, int x, int y, SDL_Color color) {
+    SDL_SetTextureColorMod(texture_, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(texture_, color.a);
+
+    forEachGlyph(text, x, [&](const Glyph& glyph, int penX) {
+        SDL_Rect destination = {penX, y, glyph.source.w, glyph.source.h};
+        SDL_RenderCopy(renderer, texture_, &glyph.source, &destination);
+    });
+
+    SDL_SetTextureColorMod(texture_, 255, 255, 255);
+    SDL_SetTextureAlphaMod(texture_, 255);
+}
+
+void GlyphAtlas::setGlyph(char32_t codepoint, const Glyph& glyph) {
+    if (auto index = glyphIndex(codepoint)) {
+        glyphs_[*index] = glyph;
+    }
+}
+
+void GlyphAtlas::setKerning(char32_t previous, char32_t codepoint, int kerning) {
+    auto previousIndex = glyphIndex(previous);
+    auto index = glyphIndex(codepoint);
+    if (previousIndex && index) {
+        kerning_[*previousIndex * GLYPH_COUNT + *index] = static_cast<std::int8_t>(
+            std::clamp<int>(kerning, std::numeric_limits<std::int8_t>::min(), std::numeric_limits<std::int8_t>::max()));
+    }
+}
+
+void GlyphAtlas::setAtlasSize(int width, int height) {
+    atlasWidth_ = width;
+    atlasHeight_ = height;
+}
+
+bool GlyphAtlas::draw(SoftwareRasterizer& raster, std::string_view text, int x, int y, SDL_Color color) {
+    if (pixels_.empty()) {
+        return false;
+    }
+
+    forEachGlyph(text, x, [&](const Glyph& glyph, int penX) {
+        raster.blit(pixels_, atlasWidth_, glyph.source, penX, y, color);
+    });
+    return true;
+}
@@ -0,0 +1,18 @@
+#include "Gravity.h"
+
+std::chrono::nanoseconds Gravity::rowInterval(int level) {
+    return SIMULATION_TICK * ONE_ROW / rowsPerTick(level);
+}
+
+int Gravity::step(int level) {
+    accumulated_ += rowsPerTick(level);
+    int rows = static_cast<int>(accumulated_ >> FRACTION_BITS);
+    accumulated_ &= ONE_ROW - 1;
+    return rows;
+}
+
+int Gravity::ticksUntilRow(int level) const {
+    Fixed rate = rowsPerTick(level);
+    Fixed needed = ONE_ROW - accumulated_;
+    return static_cast<int>((needed + rate - 1) / rate);
+}
@@ -1,19 +1,40 @@
 #include "InputHandler.h"
 #include "Game.h"
 #include "TetrominoManager.h"
+#include "Trace.h"
 
 InputHandler::InputHandler(Game& game, TetrominoManager& tetrominoManager)
     : game_(game), tetrominoManager_(tetrominoManager), quit_(false) {
 }
 
 bool InputHandler::processEvents() {
+    TRACE_ZONE("InputHandler::processEvents");
     SDL_Event e;
     
     while (SDL_PollEvent(&e) != 0) {
         if (e.type == SDL_QUIT) {
             return true;
+        } else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+            game_.handleRenderReset(e.type == SDL_RENDER_DEVICE_RESET);
+        } else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED) {
+            game_.handleDisplayChanged();
+            game_.requestRedraw();
+        } else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_FOCUS_LOST) {
+            game_.autoRepeat().releaseAll();  // Key ups go to whichever window has focus now
+        } else if (e.type == SDL_WINDOWEVENT && windowNeedsRedraw(e.window.event)) {
+            game_.requestRedraw();
+        } else if (e.type == SDL_KEYUP) {
+            if (auto key = heldKey(e.key.keysym.sym)) {
+                handleHeldKey(e.key, *key);
+            }
         } else if (e.type == SDL_KEYDOWN) {
-            if (e.key.keysym.sym == SDLK_ESCAPE) {
+            auto key = heldKey(e.key.keysym.sym);
+            if (key && game_.getGameState() == GameState::Playing) {
+                // AutoRepeat times the hold itself, OS repeats are ignored
+                if (!e.key.repeat) {
+                    handleHeldKey(e.key, *key);
+                }
+            } else if (e.key.keysym.sym == SDLK_ESCAPE) {
                 // Handle ESC differently based on game state
                 GameState state = game_.getGameState();
                 
@@ -29,8 +50,17 @@ bool InputHandler::processEvents() {
                 }
             } else if (e.key.keysym.sym == SDLK_m) {
                 game_.toggleSoundMute(); // Toggle mute with M key
+            } else if (e.key.keysym.sym == SDLK_F3) {
+                game_.toggleHud(); // Frame-timing overlay in any state
+            } else if (e.key.keysym.sym == SDLK_F4) {
+                game_.toggleTrace(); // Start or stop recording a trace
             } else {
+                if (game_.getGameState() == GameState::Playing) {
+                    // Moves pressed before this key are still waiting in AutoRepeat
+                    game_.applyPendingInput(eventTime(e.key.timestamp, SDL_GetTicks(), std::chrono::steady_clock::now()));
+                }
                 handleKeyPress(e.key.keysym.sym);
+                game_.recordInputLatency(e.key.timestamp);
             }
         }
     }
@@ -38,6 +68,51 @@ bool InputHandler::processEvents() {
     return false; // Don't quit
 }
 
+std::chrono::steady_clock::time_point InputHandler::eventTime(Uint32 timestamp, Uint32 ticks,
+                                                              std::chrono::steady_clock::time_point now) {
+    // SDL stamps events when they are queued, in milliseconds. A timestamp
+    // ahead of the ticks read afterwards can only be rounding.
+    Uint32 age = ticks >= timestamp ? ticks - timestamp : 0;
+    return now - std::chrono::milliseconds(age);
+}
+
+std::optional<AutoRepeat::Key> InputHandler::heldKey(SDL_Keycode key) {
+    switch (key) {
+        case SDLK_LEFT:
+            return AutoRepeat::Key::Left;
+        case SDLK_RIGHT:
+            return AutoRepeat::Key::Right;
+        case SDLK_DOWN:
+            return AutoRepeat::Key::SoftDrop;
+        default:
+            return std::nullopt;
+    }
+}
+
+void InputHandler::handleHeldKey(const SDL_KeyboardEvent& event, AutoRepeat::Key key) {
+    // The move itself happens in Game::updateGameState, at this time
+    auto at = eventTime(event.timestamp, SDL_GetTicks(), std::chrono::steady_clock::now());
+    if (event.type == SDL_KEYDOWN) {
+        game_.autoRepeat().press(key, at);
+    } else {
+        game_.autoRepeat().release(key, at);
+    }
+}
+
+bool InputHandler::windowNeedsRedraw(Uint8 windowEvent) {
+    // Frames are only drawn on change, so the compositor's copy can be stale
+    switch (windowEvent) {
+        case SDL_WINDOWEVENT_SHOWN:
+        case SDL_WINDOWEVENT_EXPOSED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+        case SDL_WINDOWEVENT_RESTORED:
+        case SDL_WINDOWEVENT_MAXIMIZED:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void InputHandler::handleKeyPress(SDL_Keycode key) {
     switch (game_.getGameState()) {
         case GameState::StartScreen:
@@ -66,18 +141,7 @@ void InputHandler::handleStartScreenInput(SDL_Keycode key) {
 
 void InputHandler::handlePlayingInput(SDL_Keycode key) {
     switch (key) {
-        case SDLK_LEFT:
-            tetrominoManager_.moveTetromino(MOVE_LEFT, NO_MOVE);
-            break;
-            
-        case SDLK_RIGHT:
-            tetrominoManager_.moveTetromino(MOVE_RIGHT, NO_MOVE);
-            break;
-            
-        case SDLK_DOWN:
-            tetrominoManager_.softDrop();
-            break;
-            
+        // Left, right and down go through AutoRepeat
         case SDLK_UP:
             tetrominoManager_.rotateTetromino();
             break;
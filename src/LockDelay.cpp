@@ -0,0 +1,40 @@
+#include "LockDelay.h"
+#include <algorithm>
+
+void LockDelay::reset(int y) {
+    groundedTicks_ = 0;
+    resets_ = 0;
+    lowestY_ = y;
+    touchedDown_ = false;
+}
+
+void LockDelay::onMove() {
+    // Moving in the air is free, only moves on the ground use up resets
+    if (touchedDown_ && resets_ < LOCK_RESET_LIMIT) {
+        resets_++;
+        groundedTicks_ = 0;
+    }
+}
+
+void LockDelay::onFall(int y) {
+    if (y > lowestY_) {
+        reset(y);
+    }
+}
+
+bool LockDelay::tick(bool grounded) {
+    if (!grounded) {
+        return false;
+    }
+
+    touchedDown_ = true;
+    groundedTicks_++;
+    return groundedTicks_ >= LOCK_DELAY_TICKS || resets_ >= LOCK_RESET_LIMIT;
+}
+
+int LockDelay::ticksLeft() const {
+    if (resets_ >= LOCK_RESET_LIMIT) {
+        return 1;
+    }
+    return std::max(LOCK_DELAY_TICKS - groundedTicks_, 1);
+}
@@ -0,0 +1,164 @@
+#include "MusicStream.h"
+#include <SDL2/SDL_mixer.h>
+#include <algorithm>
+
+MusicStream::Selection MusicStream::forLevel(int level, std::size_t trackCount) {
+    int index = std::max(level, 1) - 1;
+    std::size_t track = trackCount == 0 ? 0 : static_cast<std::size_t>(index / MUSIC_LEVELS_PER_TRACK) % trackCount;
+    return {track, 1.0 + MUSIC_TEMPO_STEP * (index % MUSIC_LEVELS_PER_TRACK)};
+}
+
+MusicStream::~MusicStream() {
+    stop();
+}
+
+bool MusicStream::addTrack(std::span<const std::byte> wav) {
+    WavDecoder decoder;
+    if (!decoder.open(wav)) {
+        return false;
+    }
+    tracks_.push_back(std::move(decoder));
+    return true;
+}
+
+bool MusicStream::addTrackFile(const std::string& path) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path) || !addTrack({file->data(), file->size()})) {
+        return false;
+    }
+    files_.push_back(std::move(file));
+    return true;
+}
+
+void MusicStream::setOutput(int sampleRate, int channels) {
+    outputRate_ = sampleRate > 0 ? sampleRate : AUDIO_SAMPLE_RATE;
+    outputChannels_ = channels > 0 ? channels : AUDIO_CHANNELS;
+}
+
+void MusicStream::start() {
+    if (decoder_.joinable() || tracks_.empty()) {
+        return;
+    }
+    stopping_.store(false, std::memory_order_relaxed);
+    decoder_ = std::thread([this] { run(); });
+}
+
+void MusicStream::stop() {
+    if (!decoder_.joinable()) {
+        return;
+    }
+    stopping_.store(true, std::memory_order_relaxed);
+    decoder_.join();
+}
+
+void MusicStream::run() {
+    // Sized once, the loop itself never allocates
+    std::vector<std::int16_t> block(static_cast<std::size_t>(MUSIC_DECODE_FRAMES * outputChannels_));
+    while (!stopping_.load(std::memory_order_relaxed)) {
+        if (ring_.writable() >= block.size()) {
+            std::size_t count = render(block);
+            if (count > 0) {
+                ring_.write({block.data(), count});
+                continue;
+            }
+        }
+        std::this_thread::sleep_for(MUSIC_DECODE_INTERVAL);
+    }
+}
+
+void MusicStream::mix(void* musicStream, Uint8* stream, int length) {
+    auto* music = static_cast<MusicStream*>(musicStream);
+    std::span<std::int16_t> samples(reinterpret_cast<std::int16_t*>(stream), static_cast<std::size_t>(length) / 2);
+    std::size_t count = music->ring_.read(samples);
+    std::fill(samples.begin() + static_cast<std::ptrdiff_t>(count), samples.end(), 0);
+
+    // Paused or muted music is still drained, so it resumes with fresh samples
+    bool playing = music->level_.load(std::memory_order_relaxed) > 0;
+    if (!playing || music->muted_.load(std::memory_order_relaxed)) {
+        std::fill(samples.begin(), samples.end(), 0);
+    } else if (count < samples.size()) {
+        music->underflows_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MusicStream::select(int level) {
+    playingLevel_ = level;
+    if (level <= 0 || tracks_.empty()) {
+        track_ = nullptr;
+        return;
+    }
+
+    Selection selection = forLevel(level, tracks_.size());
+    WavDecoder* track = &tracks_[selection.track];
+    step_ = track->sampleRate() * selection.tempo / outputRate_;
+
+    // A tempo change within the same track carries on from where it is
+    if (track != track_) {
+        track_ = track;
+        track_->rewind();
+        inputSize_ = 0;
+        inputRead_ = 0;
+        phase_ = 0.0;
+        previous_ = nextFrame();
+        current_ = nextFrame();
+    }
+}
+
+MusicStream::Frame MusicStream::nextFrame() {
+    if (inputRead_ == inputSize_) {
+        inputRead_ = 0;
+        inputSize_ = track_->decode(input_);
+        if (inputSize_ == 0) {
+            // End of the track: start again without a gap
+            track_->rewind();
+            inputSize_ = track_->decode(input_);
+            if (inputSize_ == 0) {
+                return {};
+            }
+        }
+    }
+
+    std::int32_t left = input_[inputRead_];
+    std::int32_t right = track_->channels() > 1 ? input_[inputRead_ + 1] : left;
+    inputRead_ += static_cast<std::size_t>(track_->channels());
+    return {left, right};
+}
+
+std::size_t MusicStream::render(std::span<std::int16_t> out) {
+    int level = level_.load(std::memory_order_relaxed);
+    if (level != playingLevel_) {
+        select(level);
+    }
+    if (!track_) {
+        return 0;
+    }
+
+    // Linear interpolation between neighbouring input frames, stepping
+    // through the input faster or slower than it was recorded
+    std::size_t channels = static_cast<std::size_t>(outputChannels_);
+    std::size_t frames = out.size() / channels;
+    for (std::size_t f = 0; f < frames; f++) {
+        std::int16_t* frame = out.data() + f * channels;
+        Frame mixed;
+        for (std::size_t c = 0; c < mixed.size(); c++) {
+            double value = previous_[c] + (current_[c] - previous_[c]) * phase_;
+            mixed[c] = static_cast<std::int32_t>(value) * MUSIC_VOLUME / MIX_MAX_VOLUME;
+        }
+
+        if (channels == 1) {
+            frame[0] = static_cast<std::int16_t>((mixed[0] + mixed[1]) / 2);
+        } else {
+            frame[0] = static_cast<std::int16_t>(mixed[0]);
+            frame[1] = static_cast<std::int16_t>(mixed[1]);
+            std::fill(frame + 2, frame + channels, 0);
+        }
+
+        phase_ += step_;
+        while (phase_ >= 1.0) {
+            phase_ -= 1.0;
+            previous_ = current_;
+            current_ = nextFrame();
+        }
+    }
+    return frames * channels;
+}
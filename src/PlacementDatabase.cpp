@@ -0,0 +1,156 @@
+#include "PlacementDatabase.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr std::array<char, 8> DATABASE_MAGIC = {'T', 'E', 'T', 'P', 'L', 'C', 'D', 'B'};
+constexpr int PIECE_COUNT = static_cast<int>(TetrominoType::COUNT);
+
+} // namespace
+
+std::optional<std::uint32_t> PlacementDatabase::surfaceSignature(const Board& board, int maxStep) {
+    auto heights = board.columnHeights();
+    std::uint32_t base = 2 * maxStep + 1;
+    std::uint32_t signature = 0;
+    std::uint32_t digit = 1;
+
+    for (int x = 0; x + 1 < GRID_WIDTH; x++) {
+        int step = heights[x + 1] - heights[x];
+        if (std::abs(step) > maxStep) {
+            return std::nullopt;
+        }
+        signature += static_cast<std::uint32_t>(step + maxStep) * digit;
+        digit *= base;
+    }
+
+    return signature;
+}
+
+std::uint32_t PlacementDatabase::surfaceCount(int maxStep) {
+    std::uint32_t count = 1;
+    for (int x = 0; x + 1 < GRID_WIDTH; x++) {
+        count *= 2 * maxStep + 1;
+    }
+    return count;
+}
+
+std::optional<Board> PlacementDatabase::surfaceBoard(std::uint32_t signature, int maxStep) {
+    std::uint32_t base = 2 * maxStep + 1;
+    std::array<int, GRID_WIDTH> heights{};
+
+    for (int x = 0; x + 1 < GRID_WIDTH; x++) {
+        heights[x + 1] = heights[x] + static_cast<int>(signature % base) - maxStep;
+        signature /= base;
+    }
+
+    // Rest the lowest column on the floor so no row is ever complete
+    auto [lowest, highest] = std::minmax_element(heights.begin(), heights.end());
+    if (*highest - *lowest > GRID_HEIGHT - 1) {
+        return std::nullopt;
+    }
+
+    Board board;
+    for (int x = 0; x < GRID_WIDTH; x++) {
+        for (int h = 0; h < heights[x] - *lowest; h++) {
+            board.setOccupied(x, GRID_HEIGHT - 1 - h);
+        }
+    }
+    return board;
+}
+
+std::uint32_t PlacementDatabase::makeKey(std::uint32_t signature, TetrominoType piece, TetrominoType next) {
+    return (signature * PIECE_COUNT + static_cast<std::uint32_t>(piece)) * PIECE_COUNT +
+           static_cast<std::uint32_t>(next);
+}
+
+bool PlacementDatabase::write(const std::string& path, int maxStep, std::vector<PlacementRecord> records) {
+    std::sort(records.begin(), records.end(),
+              [](const PlacementRecord& a, const PlacementRecord& b) { return a.key < b.key; });
+
+    PlacementDatabaseHeader header{};
+    header.magic = DATABASE_MAGIC;
+    header.version = VERSION;
+    header.maxStep = static_cast<std::uint32_t>(maxStep);
+    header.recordSize = sizeof(PlacementRecord);
+    header.recordCount = records.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Could not open placement database for writing: " << path << '\n';
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(PlacementRecord)));
+    return static_cast<bool>(file);
+}
+
+bool PlacementDatabase::open(const std::string& path) {
+    close();
+
+    if (!file_.open(path)) {
+        return false;
+    }
+
+    if (file_.size() < sizeof(PlacementDatabaseHeader)) {
+        std::cerr << "Placement database is truncated: " << path << '\n';
+        close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const PlacementDatabaseHeader*>(file_.data());
+    if (header->magic != DATABASE_MAGIC || header->version != VERSION ||
+        header->recordSize != sizeof(PlacementRecord) ||
+        header->maxStep < 1 || header->maxStep > MAX_SUPPORTED_STEP ||
+        (file_.size() - sizeof(PlacementDatabaseHeader)) % sizeof(PlacementRecord) != 0 ||
+        header->recordCount != (file_.size() - sizeof(PlacementDatabaseHeader)) / sizeof(PlacementRecord)) {
+        std::cerr << "Placement database has an unexpected format: " << path << '\n';
+        close();
+        return false;
+    }
+
+    records_ = reinterpret_cast<const PlacementRecord*>(file_.data() + sizeof(PlacementDatabaseHeader));
+    recordCount_ = header->recordCount;
+    maxStep_ = static_cast<int>(header->maxStep);
+    return true;
+}
+
+void PlacementDatabase::close() {
+    file_.close();
+    records_ = nullptr;
+    recordCount_ = 0;
+    maxStep_ = 0;
+}
+
+std::optional<Placement> PlacementDatabase::lookup(const Board& board, TetrominoType piece, TetrominoType next) const {
+    if (!isOpen()) {
+        return std::nullopt;
+    }
+
+    auto signature = surfaceSignature(board, maxStep_);
+    if (!signature) {
+        return std::nullopt;
+    }
+
+    std::uint32_t key = makeKey(*signature, piece, next);
+    const PlacementRecord* end = records_ + recordCount_;
+    const PlacementRecord* record = std::lower_bound(records_, end, key,
+        [](const PlacementRecord& r, std::uint32_t k) { return r.key < k; });
+
+    if (record == end || record->key != key) {
+        return std::nullopt;
+    }
+
+    // The surface ignores absolute height, so the piece may still be blocked near the top
+    const PieceMask& mask = pieceMask(piece, record->rotation);
+    int startY = -mask.top;
+    if (!board.fits(mask, record->x, startY)) {
+        return std::nullopt;
+    }
+
+    return Placement{piece, record->rotation, record->x, board.dropY(mask, record->x, startY)};
+}
@@ -0,0 +1,80 @@
+#include "PlacementGenerator.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+// Shape of a mask with the empty leading rows and columns stripped
+std::array<std::uint16_t, TETROMINO_GRID_SIZE> normalizedRows(const PieceMask& mask) {
+    std::array<std::uint16_t, TETROMINO_GRID_SIZE> rows{};
+    for (int r = mask.top; r <= mask.bottom; r++) {
+        rows[r - mask.top] = static_cast<std::uint16_t>(mask.rows[r] >> mask.minX);
+    }
+    return rows;
+}
+
+std::array<std::vector<int>, static_cast<std::size_t>(TetrominoType::COUNT)> buildDistinctRotations() {
+    std::array<std::vector<int>, static_cast<std::size_t>(TetrominoType::COUNT)> result;
+
+    for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+        std::vector<std::array<std::uint16_t, TETROMINO_GRID_SIZE>> seen;
+
+        for (int rotation = 0; rotation < TETROMINO_ROTATION_COUNT; rotation++) {
+            auto rows = normalizedRows(pieceMask(static_cast<TetrominoType>(type), rotation));
+            if (std::find(seen.begin(), seen.end(), rows) == seen.end()) {
+                seen.push_back(rows);
+                result[type].push_back(rotation);
+            }
+        }
+    }
+
+    return result;
+}
+
+template <typename Container>
+void appendPlacements(const Board& board, TetrominoType type, Container& placements) {
+    for (int rotation : PlacementGenerator::distinctRotations(type)) {
+        const PieceMask& mask = pieceMask(type, rotation);
+        ColumnLandings landings = board.landingRows(mask, -mask.top);
+
+        for (unsigned columns = landings.columns; columns != 0; columns &= columns - 1) {
+            int column = std::countr_zero(columns);
+            placements.push_back({type, rotation, column - mask.minX, landings.y[column]});
+        }
+    }
+}
+
+} // namespace
+
+const std::vector<int>& PlacementGenerator::distinctRotations(TetrominoType type) {
+    static const auto rotations = buildDistinctRotations();
+    return rotations[static_cast<std::size_t>(type)];
+}
+
+std::vector<Placement> PlacementGenerator::generate(const Board& board, TetrominoType type) {
+    std::vector<Placement> placements;
+    appendPlacements(board, type, placements);
+    return placements;
+}
+
+void PlacementGenerator::generate(const Board& board, TetrominoType type, std::pmr::vector<Placement>& placements) {
+    appendPlacements(board, type, placements);
+}
+
+std::vector<Placement> PlacementGenerator::generateByColumn(const Board& board, TetrominoType type) {
+    std::vector<Placement> placements;
+
+    for (int rotation : distinctRotations(type)) {
+        const PieceMask& mask = pieceMask(type, rotation);
+        int startY = -mask.top;
+
+        for (int x = -mask.minX; x + mask.maxX < GRID_WIDTH; x++) {
+            if (!board.fits(mask, x, startY)) {
+                continue;
+            }
+            placements.push_back({type, rotation, x, board.dropY(mask, x, startY)});
+        }
+    }
+
+    return placements;
+}
@@ -0,0 +1,159 @@
+#include "PlacementSearch.h"
+#include "SearchArena.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+// Integer weights keep generated tables identical across compilers and platforms
+constexpr int WEIGHT_AGGREGATE_HEIGHT = -51;
+constexpr int WEIGHT_LINES = 76;
+constexpr int WEIGHT_HOLES = -36;
+constexpr int WEIGHT_BUMPINESS = -18;
+
+// Score given to a board on which the next piece has nowhere to go: below
+// any evaluation, but above the search's starting best so a top-out
+// placement is still returned when nothing else is legal
+constexpr int TOP_OUT_SCORE = std::numeric_limits<int>::min() / 2;
+
+// A board in the beam, remembering which first placement led to it
+struct BeamNode {
+    Board board;
+    int firstIndex;
+    int lines;
+    int score;
+};
+
+// Higher score first; on ties the earlier first placement wins, as in findBest
+bool betterNode(const BeamNode* a, const BeamNode* b) {
+    if (a->score != b->score) {
+        return a->score > b->score;
+    }
+    return a->firstIndex < b->firstIndex;
+}
+
+} // namespace
+
+int PlacementSearch::evaluate(const Board& board, int linesCleared) {
+    auto heights = board.columnHeights();
+
+    int aggregateHeight = 0;
+    int bumpiness = 0;
+    for (int x = 0; x < GRID_WIDTH; x++) {
+        aggregateHeight += heights[x];
+        if (x > 0) {
+            bumpiness += std::abs(heights[x] - heights[x - 1]);
+        }
+    }
+
+    return WEIGHT_AGGREGATE_HEIGHT * aggregateHeight +
+           WEIGHT_LINES * linesCleared +
+           WEIGHT_HOLES * board.holeCount() +
+           WEIGHT_BUMPINESS * bumpiness;
+}
+
+std::optional<Placement> PlacementSearch::findBest(const Board& board, TetrominoType current, TetrominoType next) {
+    SearchArena& arena = SearchArena::threadLocal();
+    arena.reset();
+
+    std::pmr::vector<Placement> placements(&arena);
+    std::pmr::vector<Placement> followUps(&arena);
+    placements.reserve(MAX_PLACEMENTS);
+    followUps.reserve(MAX_PLACEMENTS);
+    PlacementGenerator::generate(board, current, placements);
+
+    std::optional<Placement> best;
+    int bestScore = std::numeric_limits<int>::min();
+
+    for (const Placement& placement : placements) {
+        Board afterCurrent = board;
+        int lines = afterCurrent.place(pieceMask(current, placement.rotation), placement.x, placement.y);
+
+        int score = TOP_OUT_SCORE;
+        followUps.clear();
+        PlacementGenerator::generate(afterCurrent, next, followUps);
+        for (const Placement& followUp : followUps) {
+            Board afterNext = afterCurrent;
+            int nextLines = afterNext.place(pieceMask(next, followUp.rotation), followUp.x, followUp.y);
+            score = std::max(score, evaluate(afterNext, lines + nextLines));
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            best = placement;
+        }
+    }
+
+    return best;
+}
+
+std::optional<Placement> PlacementSearch::beamSearch(const Board& board, std::span<const TetrominoType> pieces, int beamWidth) {
+    if (pieces.empty() || beamWidth <= 0) {
+        return std::nullopt;
+    }
+
+    SearchArena& arena = SearchArena::threadLocal();
+    arena.reset();
+    NodePool<BeamNode> pool(&arena);
+
+    std::pmr::vector<Placement> firstPlacements(&arena);
+    std::pmr::vector<Placement> placements(&arena);
+    std::pmr::vector<BeamNode*> beam(&arena);
+    std::pmr::vector<BeamNode*> children(&arena);
+    firstPlacements.reserve(MAX_PLACEMENTS);
+    placements.reserve(MAX_PLACEMENTS);
+    beam.reserve(static_cast<std::size_t>(beamWidth));
+    children.reserve(static_cast<std::size_t>(beamWidth) * MAX_PLACEMENTS);
+
+    PlacementGenerator::generate(board, pieces[0], firstPlacements);
+    for (int i = 0; i < static_cast<int>(firstPlacements.size()); i++) {
+        const Placement& placement = firstPlacements[i];
+        BeamNode* node = pool.create(board, i, 0, 0);
+        node->lines = node->board.place(pieceMask(pieces[0], placement.rotation), placement.x, placement.y);
+        node->score = evaluate(node->board, node->lines);
+        children.push_back(node);
+    }
+
+    for (std::size_t depth = 1;; depth++) {
+        // Keep the best beamWidth children, the rest go back to the pool
+        if (children.size() > static_cast<std::size_t>(beamWidth)) {
+            std::partial_sort(children.begin(), children.begin() + beamWidth, children.end(), betterNode);
+            for (std::size_t i = static_cast<std::size_t>(beamWidth); i < children.size(); i++) {
+                pool.destroy(children[i]);
+            }
+            children.resize(static_cast<std::size_t>(beamWidth));
+        }
+        if (children.empty()) {
+            break;
+        }
+
+        for (BeamNode* node : beam) {
+            pool.destroy(node);
+        }
+        beam.assign(children.begin(), children.end());
+        children.clear();
+
+        if (depth == pieces.size()) {
+            break;
+        }
+
+        TetrominoType type = pieces[depth];
+        for (const BeamNode* parent : beam) {
+            placements.clear();
+            PlacementGenerator::generate(parent->board, type, placements);
+
+            for (const Placement& placement : placements) {
+                BeamNode* child = pool.create(*parent);
+                child->lines += child->board.place(pieceMask(type, placement.rotation), placement.x, placement.y);
+                child->score = evaluate(child->board, child->lines);
+                children.push_back(child);
+            }
+        }
+    }
+
+    if (beam.empty()) {
+        return std::nullopt;
+    }
+    return firstPlacements[(*std::min_element(beam.begin(), beam.end(), betterNode))->firstIndex];
+}
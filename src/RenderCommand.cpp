@@ -0,0 +1,46 @@
+#include "RenderCommand.h"
+
+namespace {
+
+constexpr std::array<const char*, static_cast<std::size_t>(TextId::COUNT)> TEXTS = {
+    "C++23 TETRIS",
+    "Arrow Keys: Move and Rotate",
+    "Space: Hard Drop",
+    "P: Pause Game",
+    "M: Toggle Sound",
+    "ESC: Quit Game",
+    "Press ENTER or SPACE to Start",
+    "> PRESS START <",
+    "Version 1.0.0",
+    "Next:",
+    "Score: ",
+    "Level: ",
+    "Lines: ",
+    "Controls:",
+    "\u2190 \u2192 : Move",  // Unicode LEFT/RIGHT ARROW
+    "\u2191 : Rotate",       // Unicode UP ARROW
+    "\u2193 : Soft Drop",    // Unicode DOWN ARROW
+    "Space : Hard Drop",
+    "PAUSED",
+    "Press P or ENTER to continue",
+    "Press ESC to quit",
+    "GAME OVER",
+    "Final Score: ",
+    "Finesse Faults: ",
+    "Press ENTER to restart",
+};
+
+} // namespace
+
+const char* textFor(TextId id) {
+    auto index = static_cast<std::size_t>(id);
+    return index < TEXTS.size() ? TEXTS[index] : "";
+}
+
+bool RenderCommandList::push(const RenderCommand& command) {
+    if (size_ == CAPACITY) {
+        return false;
+    }
+    commands_[size_++] = command;
+    return true;
+}
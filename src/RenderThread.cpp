@@ -0,0 +1,43 @@
+#include "RenderThread.h"
+#include "Trace.h"
+#include <utility>
+
+RenderThread::RenderThread(Draw draw, Release release, Pace pace)
+    : draw_(std::move(draw)), release_(std::move(release)), pace_(std::move(pace)),
+      thread_(&RenderThread::run, this) {
+}
+
+RenderThread::~RenderThread() {
+    stopping_.store(true, std::memory_order_release);
+    published_.fetch_add(1, std::memory_order_release);
+    published_.notify_one();
+    thread_.join();
+}
+
+void RenderThread::publish() {
+    frames_.publish();
+    published_.fetch_add(1, std::memory_order_release);
+    published_.notify_one();
+}
+
+void RenderThread::run() {
+    Trace::setThreadName("render");
+    std::uint64_t seen = 0;
+    while (!stopping_.load(std::memory_order_acquire)) {
+        published_.wait(seen, std::memory_order_acquire);
+        if (pace_ && !stopping_.load(std::memory_order_acquire)) {
+            pace_();
+        }
+        seen = published_.load(std::memory_order_acquire);
+
+        // Several publishes may have arrived, only the newest is drawn
+        if (!stopping_.load(std::memory_order_acquire) && frames_.update()) {
+            draw_(frames_.front());
+            framesDrawn_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (release_) {
+        release_();
+    }
+}
@@ -1,218 +1,205 @@
 #include "Renderer.h"
-#include "Game.h"
 #include "Color.h"
+#include "Trace.h"
 #include <format>
 #include <algorithm>
+#include <iostream>
 
-Renderer::Renderer(SDL_Renderer* renderer, TTF_Font* font)
-    : renderer_(renderer), font_(font) {}
+Renderer::Renderer(SDL_Renderer* renderer, FontManager& fonts, RenderBackend backend)
+    : renderer_(renderer),
+      font_(fonts.get(FONT_SIZE)),
+      largeFont_(fonts.get(LARGE_FONT_SIZE)),
+      textCache_(backend == RenderBackend::Sdl ? renderer : nullptr),
+      boardLayer_(backend == RenderBackend::Sdl ? renderer : nullptr),
+      backend_(backend) {
+    if (backend_ == RenderBackend::Software) {
+        // Everything is drawn from CPU copies of the atlases, no textures but the frame
+        raster_ = std::make_unique<SoftwareRasterizer>(WINDOW_WIDTH, WINDOW_HEIGHT);
+        createFrameTexture();
+        glyphAtlas_.build(nullptr, font_);
+        largeGlyphAtlas_.build(nullptr, largeFont_ ? largeFont_ : font_);
+        std::cout << "Rasterising frames on the CPU" << (renderer_ ? "" : " (headless)") << std::endl;
+        return;
+    }
+    
+    blockAtlas_.build(renderer_);
+    
+    if (!glyphAtlas_.build(renderer_, font_)) {
+        std::cerr << "Glyph atlas unavailable, changing text will be cached per string" << std::endl;
+    }
+}
+
+Renderer::~Renderer() {
+    if (frameTexture_) {
+        SDL_DestroyTexture(frameTexture_);
+    }
+}
 
 void Renderer::clear() {
+    if (raster_) {
+        raster_->clear({SCREEN_CLEAR_COLOR_R, SCREEN_CLEAR_COLOR_G, SCREEN_CLEAR_COLOR_B, SCREEN_CLEAR_COLOR_A});
+        return;
+    }
+    
     SDL_SetRenderDrawColor(renderer_, SCREEN_CLEAR_COLOR_R, SCREEN_CLEAR_COLOR_G, 
                           SCREEN_CLEAR_COLOR_B, SCREEN_CLEAR_COLOR_A);
     SDL_RenderClear(renderer_);
+    counters_.drawCalls++;
 }
 
 void Renderer::present() {
+    TRACE_ZONE("Renderer::present");
+    if (raster_) {
+        if (!frameTexture_) {
+            return;  // Headless
+        }
+        
+        // The whole CPU frame goes out as one upload and one copy
+        SDL_UpdateTexture(frameTexture_, nullptr, raster_->pixels().data(), raster_->pitch());
+        SDL_Rect destination = {0, 0, raster_->width(), raster_->height()};
+        SDL_RenderCopy(renderer_, frameTexture_, nullptr, &destination);
+        counters_.textureUploads++;
+        counters_.drawCalls++;
+    }
+    
     SDL_RenderPresent(renderer_);
 }
 
-void Renderer::drawGrid(const std::vector<std::vector<std::optional<TetrominoType>>>& grid) {
-    SDL_Rect rect;
-    rect.w = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
-    rect.h = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
+void Renderer::createFrameTexture() {
+    if (!renderer_) {
+        return;
+    }
     
-    SDL_SetRenderDrawColor(renderer_, GRID_LINE_COLOR, GRID_LINE_COLOR, GRID_LINE_COLOR, ALPHA_OPAQUE);
+    if (frameTexture_) {
+        SDL_DestroyTexture(frameTexture_);
+    }
+    frameTexture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                      raster_->width(), raster_->height());
+    if (!frameTexture_) {
+        std::cerr << "Could not create frame texture, nothing will be shown: " << SDL_GetError() << std::endl;
+    }
+}
+
+void Renderer::drawOutline(const SDL_Rect& rect, SDL_Color color) {
+    if (raster_) {
+        raster_->drawRect(rect, color);
+        return;
+    }
+    
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    SDL_RenderDrawRect(renderer_, &rect);
+    counters_.drawCalls++;
+}
+
+void Renderer::flushBlocks() {
+    if (raster_) {
+        blockAtlas_.flush(*raster_);
+    } else {
+        counters_.drawCalls += blockAtlas_.flush(renderer_);
+    }
+}
+
+void Renderer::drawAtlasText(GlyphAtlas& atlas, std::string_view text, int x, int y, SDL_Color color) {
+    if (!atlas.draw(*raster_, text, x, y, color)) {
+        // No font: a box the size of the text, as on the SDL path
+        drawOutline({x, y, static_cast<int>(text.length() * TEXT_FALLBACK_CHAR_WIDTH), TEXT_FALLBACK_HEIGHT}, color);
+    }
+}
+
+void Renderer::drawGrid(const std::vector<std::vector<std::optional<TetrominoType>>>& grid) {
+    TRACE_ZONE("Renderer::drawGrid");
     SDL_Rect border = {0, 0, GRID_WIDTH * BLOCK_SIZE, GRID_HEIGHT * BLOCK_SIZE};
-    SDL_RenderDrawRect(renderer_, &border);
+    drawOutline(border, {GRID_LINE_COLOR, GRID_LINE_COLOR, GRID_LINE_COLOR, ALPHA_OPAQUE});
     
-    // Draw filled cells
+    // Filled and empty cells go out as one batch
     for (int y = 0; y < GRID_HEIGHT; y++) {
         for (int x = 0; x < GRID_WIDTH; x++) {
-            rect.x = x * BLOCK_SIZE;
-            rect.y = y * BLOCK_SIZE;
-            
-            if (grid[y][x].has_value()) {
-                const auto& color = COLORS[static_cast<std::size_t>(grid[y][x].value())];
-                SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, ALPHA_OPAQUE);
-                SDL_RenderFillRect(renderer_, &rect);
-                
-                // Add 3D effect with darker borders
-                SDL_SetRenderDrawColor(renderer_, 
-                                     color.r/HALF, color.g/HALF, color.b/HALF, ALPHA_OPAQUE);
-                SDL_Rect border = {rect.x, rect.y, rect.w, rect.h};
-                SDL_RenderDrawRect(renderer_, &border);
-            } else {
-                // Draw empty cell
-                SDL_SetRenderDrawColor(renderer_, EMPTY_CELL_COLOR, EMPTY_CELL_COLOR, 
-                                      EMPTY_CELL_COLOR, ALPHA_OPAQUE);
-                SDL_RenderDrawRect(renderer_, &rect);
-            }
+            int sprite = grid[y][x].has_value() ? BlockAtlas::blockSprite(grid[y][x].value())
+                                                : BlockAtlas::EMPTY_CELL_SPRITE;
+            blockAtlas_.add(sprite, x * BLOCK_SIZE, y * BLOCK_SIZE);
         }
     }
+    flushBlocks();
 }
 
-void Renderer::drawTetromino(const Tetromino& tetromino) {
-    SDL_Rect rect;
-    rect.w = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
-    rect.h = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
+void Renderer::drawBoard(const std::vector<std::vector<std::optional<TetrominoType>>>& grid, std::uint64_t boardVersion) {
+    TRACE_ZONE("Renderer::drawBoard");
+    // Rasterising the cells is cheaper than keeping a second CPU layer
+    if (raster_) {
+        drawGrid(grid);
+        return;
+    }
+    
+    counters_.drawCalls += boardLayer_.draw(boardVersion, [&]() { drawGrid(grid); });
+}
+
+void Renderer::handleRenderReset(bool deviceReset) {
+    boardLayer_.invalidate();
     
-    const auto& color = COLORS[static_cast<std::size_t>(tetromino.type())];
-    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, ALPHA_OPAQUE);
+    if (deviceReset && raster_) {
+        std::cout << "Render device reset, recreating the frame texture" << std::endl;
+        createFrameTexture();
+    } else if (deviceReset) {
+        std::cout << "Render device reset, recreating textures" << std::endl;
+        boardLayer_.recreate();
+        textCache_.clear();
+        blockAtlas_.build(renderer_);
+        glyphAtlas_.build(renderer_, font_);
+    }
+}
+
+void Renderer::drawTetromino(const Tetromino& tetromino) {
+    TRACE_ZONE("Renderer::drawTetromino");
+    int sprite = BlockAtlas::blockSprite(tetromino.type());
     
     for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
         for (int x = 0; x < TETROMINO_GRID_SIZE; x++) {
             if (tetromino.isOccupying(tetromino.x() + x, tetromino.y() + y)) {
-                rect.x = (tetromino.x() + x) * BLOCK_SIZE;
-                rect.y = (tetromino.y() + y) * BLOCK_SIZE;
+                int screenY = (tetromino.y() + y) * BLOCK_SIZE;
                 
-                if (rect.y >= 0) {  // Only draw if visible
-                    SDL_RenderFillRect(renderer_, &rect);
-                    
-                    // Add 3D effect
-                    SDL_SetRenderDrawColor(renderer_, 
-                                         color.r/HALF, color.g/HALF, color.b/HALF, ALPHA_OPAQUE);
-                    SDL_Rect border = {rect.x, rect.y, rect.w, rect.h};
-                    SDL_RenderDrawRect(renderer_, &border);
-                    
-                    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, ALPHA_OPAQUE);
+                if (screenY >= 0) {  // Only draw if visible
+                    blockAtlas_.add(sprite, (tetromino.x() + x) * BLOCK_SIZE, screenY);
                 }
             }
         }
     }
+    flushBlocks();
 }
 
-void Renderer::drawGhostPiece(const Game& game, const Tetromino& tetromino) {
-    // Create a manual copy of the current tetromino position and rotation
-    int ghostX = tetromino.x();
-    int ghostY = tetromino.y();
-    int ghostRotation = tetromino.rotation();
-    TetrominoType ghostType = tetromino.type();
+void Renderer::drawGhost(const Tetromino& landing) {
+    TRACE_ZONE("Renderer::drawGhost");
+    auto shape = landing.getRotatedShape();
     
-    // Determine how far down the piece can go
-    int maxY = ghostY;
-    bool canMoveDown = true;
-    int safetyCounter = 0;
-    const int MAX_ATTEMPTS = GRID_HEIGHT * 2; // Safety limit
-    
-    // Manually check positions downward
-    for (int testY = ghostY + 1; testY < GRID_HEIGHT + 4 && canMoveDown && safetyCounter < MAX_ATTEMPTS; testY++) {
-        safetyCounter++;
-        
-        // Create a temporary tetromino at the test position
-        Tetromino tempTetromino(ghostType, ghostX, testY);
-        
-        // Apply the same rotation as the current tetromino
-        for (int i = 0; i < ghostRotation; i++) {
-            tempTetromino.rotateWithoutWallKick();
-        }
-        
-        // Check if this position would be valid
-        canMoveDown = true;
-        
-        // Check all blocks in the shape for collision
-        auto shape = tempTetromino.getRotatedShape();
-        for (int y = 0; y < TETROMINO_GRID_SIZE && canMoveDown; y++) {
-            for (int x = 0; x < TETROMINO_GRID_SIZE && canMoveDown; x++) {
-                if (shape[y][x]) {
-                    if (!game.isPositionFree(ghostX + x, testY + y)) {
-                        canMoveDown = false;
-                    }
-                }
-            }
-        }
-        
-        if (canMoveDown) {
-            maxY = testY;
-        }
-    }
+    // Use a bright version of the color for better visibility
+    const auto& color = COLORS[static_cast<std::size_t>(landing.type())];
+    SDL_Color tint = {static_cast<Uint8>(std::min(color.r + GHOST_PIECE_BRIGHTNESS_BOOST, COLOR_MAX)),
+                      static_cast<Uint8>(std::min(color.g + GHOST_PIECE_BRIGHTNESS_BOOST, COLOR_MAX)),
+                      static_cast<Uint8>(std::min(color.b + GHOST_PIECE_BRIGHTNESS_BOOST, COLOR_MAX)),
+                      ALPHA_GHOST_PIECE};
     
-    // If we can drop the piece and it's different from the current position, draw the ghost
-    if (maxY > ghostY) {
-        SDL_Rect rect;
-        rect.w = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
-        rect.h = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
-        
-        // Create a temporary tetromino at the landing position
-        Tetromino landingTetromino(ghostType, ghostX, maxY);
-        
-        // Apply the same rotation
-        for (int i = 0; i < ghostRotation; i++) {
-            landingTetromino.rotateWithoutWallKick();
-        }
-        
-        // Get the entire shape for drawing
-        auto shape = landingTetromino.getRotatedShape();
-        
-        // Use a bright version of the color for better visibility
-        const auto& color = COLORS[static_cast<std::size_t>(ghostType)];
-        SDL_SetRenderDrawColor(renderer_, 
-                              std::min(color.r + GHOST_PIECE_BRIGHTNESS_BOOST, COLOR_MAX),
-                              std::min(color.g + GHOST_PIECE_BRIGHTNESS_BOOST, COLOR_MAX), 
-                              std::min(color.b + GHOST_PIECE_BRIGHTNESS_BOOST, COLOR_MAX), 
-                              ALPHA_GHOST_PIECE);
-        
-        // Draw the ghost piece - draw each block in the shape
-        for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
-            for (int x = 0; x < TETROMINO_GRID_SIZE; x++) {
-                if (shape[y][x]) {
-                    rect.x = (ghostX + x) * BLOCK_SIZE;
-                    rect.y = (maxY + y) * BLOCK_SIZE;
-                    
-                    if (rect.y >= 0) {  // Only draw if visible
-                        SDL_RenderDrawRect(renderer_, &rect);
-                    }
+    // Draw the ghost piece - the white outline sprite tinted per block
+    for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
+        for (int x = 0; x < TETROMINO_GRID_SIZE; x++) {
+            if (shape[y][x]) {
+                int screenY = (landing.y() + y) * BLOCK_SIZE;
+                
+                if (screenY >= 0) {  // Only draw if visible
+                    blockAtlas_.add(BlockAtlas::GHOST_SPRITE, (landing.x() + x) * BLOCK_SIZE, screenY, tint);
                 }
             }
         }
     }
-}
-
-void Renderer::drawSidebar(const Game& game, TetrominoType nextTetrominoType) {
-    int sidebarX = GRID_WIDTH * BLOCK_SIZE + SIDEBAR_PADDING;
-    int y = UI_PADDING_MEDIUM;
-    
-    drawText("Next:", sidebarX, y);
-    y += UI_PADDING_LARGE;
-    
-    drawNextTetromino(nextTetrominoType, sidebarX + BLOCK_SIZE, y);
-    
-    y += TETROMINO_GRID_SIZE * BLOCK_SIZE + UI_PADDING_MEDIUM;
-    
-    drawText(std::format("Score: {}", game.getScore()), sidebarX, y);
-    y += UI_PADDING_XLARGE;
-    
-    drawText(std::format("Level: {}", game.getLevel()), sidebarX, y);
-    y += UI_PADDING_XLARGE;
-    
-    drawText(std::format("Lines: {}", game.getLinesCleared()), sidebarX, y);
-    y += UI_PADDING_XXLARGE;
-    
-    drawText("Controls:", sidebarX, y);
-    y += UI_PADDING_LARGE;
-    drawText("\u2190 \u2192 : Move", sidebarX, y);  // Unicode LEFT/RIGHT ARROW
-    y += UI_PADDING_LARGE;
-    drawText("\u2191 : Rotate", sidebarX, y);       // Unicode UP ARROW
-    y += UI_PADDING_LARGE;
-    drawText("\u2193 : Soft Drop", sidebarX, y);    // Unicode DOWN ARROW
-    y += UI_PADDING_LARGE;
-    drawText("Space : Hard Drop", sidebarX, y);
+    flushBlocks();
 }
 
 void Renderer::drawNextTetromino(TetrominoType type, int x, int y) {
+    TRACE_ZONE("Renderer::drawNextTetromino");
     Tetromino nextTetromino(type, 0, 0);
     
     int previewSize = TETROMINO_GRID_SIZE * BLOCK_SIZE;
     int centerX = x + previewSize / HALF;
     int centerY = y + previewSize / HALF;
     
-    SDL_Rect rect;
-    rect.w = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
-    rect.h = BLOCK_SIZE - BLOCK_BORDER_THICKNESS;
-    
-    const auto& color = COLORS[static_cast<std::size_t>(type)];
-    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, ALPHA_OPAQUE);
-    
     auto shape = nextTetromino.getRotatedShape();
     
     int offsetX = 0;
@@ -246,108 +233,84 @@ void Renderer::drawNextTetromino(TetrominoType type, int x, int y) {
     for (int row = 0; row < TETROMINO_GRID_SIZE; row++) {
         for (int col = 0; col < TETROMINO_GRID_SIZE; col++) {
             if (shape[row][col]) {
-                rect.x = offsetX + (col * BLOCK_SIZE);
-                rect.y = offsetY + (row * BLOCK_SIZE);
-                
-                SDL_RenderFillRect(renderer_, &rect);
-                
-                // Add 3D effect
-                SDL_SetRenderDrawColor(renderer_, 
-                                     color.r/HALF, color.g/HALF, color.b/HALF, ALPHA_OPAQUE);
-                SDL_Rect border = {rect.x, rect.y, rect.w, rect.h};
-                SDL_RenderDrawRect(renderer_, &border);
-                
-                SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, ALPHA_OPAQUE);
+                blockAtlas_.add(BlockAtlas::blockSprite(type), offsetX + (col * BLOCK_SIZE), offsetY + (row * BLOCK_SIZE));
             }
         }
     }
+    flushBlocks();
     
     // Draw outline around the preview area
-    SDL_SetRenderDrawColor(renderer_, GRID_LINE_COLOR, GRID_LINE_COLOR, GRID_LINE_COLOR, ALPHA_OPAQUE);
     SDL_Rect previewRect = {x, y, previewSize, previewSize};
-    SDL_RenderDrawRect(renderer_, &previewRect);
+    drawOutline(previewRect, {GRID_LINE_COLOR, GRID_LINE_COLOR, GRID_LINE_COLOR, ALPHA_OPAQUE});
 }
 
-void Renderer::drawText(const std::string& text, int x, int y) {
-    if (font_) {
-        SDL_Color textColor = {TEXT_COLOR_R, TEXT_COLOR_G, TEXT_COLOR_B, ALPHA_OPAQUE};
+void Renderer::drawText(std::string_view text, int x, int y) {
+    TRACE_ZONE("Renderer::drawText");
+    SDL_Color textColor = {TEXT_COLOR_R, TEXT_COLOR_G, TEXT_COLOR_B, ALPHA_OPAQUE};
+    
+    if (raster_) {
+        drawAtlasText(glyphAtlas_, text, x, y, textColor);
+    } else if (font_) {
         
-        // Use Blended rendering for better quality with Unicode characters
-        SDL_Surface* surface = TTF_RenderUTF8_Blended(font_, text.c_str(), textColor);
+        // Rasterised once per distinct string, later frames reuse the texture
+        const TextCache::Entry* cached = textCache_.get(text, font_, textColor);
         
-        if (surface) {
-            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-            
-            if (texture) {
-                SDL_Rect rect = {x, y, surface->w, surface->h};
-                SDL_RenderCopy(renderer_, texture, nullptr, &rect);
-                SDL_DestroyTexture(texture);
-            }
-            
-            SDL_FreeSurface(surface);
+        if (cached) {
+            SDL_Rect rect = {x, y, cached->width, cached->height};
+            SDL_RenderCopy(renderer_, cached->texture, nullptr, &rect);
+            counters_.drawCalls++;
         }
     } else {
         // Fallback if font loading failed: draw a colored rectangle
-        SDL_SetRenderDrawColor(renderer_, TEXT_COLOR_R, TEXT_COLOR_G, TEXT_COLOR_B, ALPHA_OPAQUE);
         SDL_Rect rect = {x, y, static_cast<int>(text.length() * TEXT_FALLBACK_CHAR_WIDTH), TEXT_FALLBACK_HEIGHT};
-        SDL_RenderDrawRect(renderer_, &rect);
+        drawOutline(rect, textColor);
     }
 }
 
-void Renderer::drawLargeText(const std::string& text, int x, int y) {
-    if (font_) {
-        int originalSize = TTF_FontHeight(font_);
+void Renderer::drawDynamicText(std::string_view text, int x, int y) {
+    TRACE_ZONE("Renderer::drawDynamicText");
+    SDL_Color textColor = {TEXT_COLOR_R, TEXT_COLOR_G, TEXT_COLOR_B, ALPHA_OPAQUE};
+    
+    if (raster_) {
+        drawAtlasText(glyphAtlas_, text, x, y, textColor);
+        return;
+    }
+    
+    // One draw call from the glyph atlas, no surface or texture per string
+    if (glyphAtlas_.draw(renderer_, text, x, y, textColor)) {
+        counters_.drawCalls++;
+    } else {
+        drawText(text, x, y);
+    }
+}
+
+void Renderer::drawLargeText(std::string_view text, int x, int y) {
+    TRACE_ZONE("Renderer::drawLargeText");
+    // Fall back to regular size if the large font could not be opened
+    TTF_Font* font = largeFont_ ? largeFont_ : font_;
+    SDL_Color textColor = {255, 255, 255, 255}; // Bright white for large text
+    
+    if (raster_) {
+        drawAtlasText(largeGlyphAtlas_, text, x, y, textColor);
+    } else if (font) {
         
-        TTF_Font* largeFont = TTF_OpenFont(TTF_FontFaceFamilyName(font_), originalSize * 2);
+        const TextCache::Entry* cached = textCache_.get(text, font, textColor);
         
-        if (largeFont) {
-            SDL_Color textColor = {255, 255, 255, 255}; // Bright white for large text
-            
-            SDL_Surface* surface = TTF_RenderUTF8_Blended(largeFont, text.c_str(), textColor);
-            
-            if (surface) {
-                SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-                
-                if (texture) {
-                    SDL_Rect rect = {x, y, surface->w, surface->h};
-                    SDL_RenderCopy(renderer_, texture, nullptr, &rect);
-                    SDL_DestroyTexture(texture);
-                }
-                
-                SDL_FreeSurface(surface);
-            }
-            
-            TTF_CloseFont(largeFont);
-        } else {
-            // Fall back to regular size if large font creation fails
-            SDL_Color textColor = {255, 255, 255, 255}; // White for emphasis
-            
-            SDL_Surface* surface = TTF_RenderUTF8_Blended(font_, text.c_str(), textColor);
-            
-            if (surface) {
-                SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-                
-                if (texture) {
-                    SDL_Rect rect = {x, y, surface->w, surface->h};
-                    SDL_RenderCopy(renderer_, texture, nullptr, &rect);
-                    SDL_DestroyTexture(texture);
-                }
-                
-                SDL_FreeSurface(surface);
-            }
+        if (cached) {
+            SDL_Rect rect = {x, y, cached->width, cached->height};
+            SDL_RenderCopy(renderer_, cached->texture, nullptr, &rect);
+            counters_.drawCalls++;
         }
     } else {
-        SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 255);
         SDL_Rect rect = {x, y, static_cast<int>(text.length() * 16), 40}; // Larger size
-        SDL_RenderDrawRect(renderer_, &rect);
+        drawOutline(rect, textColor);
     }
 }
 
 void Renderer::drawGameOver(int score) {
-    SDL_SetRenderDrawColor(renderer_, OVERLAY_COLOR_R, OVERLAY_COLOR_G, 
-                          OVERLAY_COLOR_B, OVERLAY_COLOR_A);
+    TRACE_ZONE("Renderer::drawGameOver");
     SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(renderer_, &overlay);
+    fillRect(overlay, {OVERLAY_COLOR_R, OVERLAY_COLOR_G, OVERLAY_COLOR_B, OVERLAY_COLOR_A});
     
     int centerX = WINDOW_WIDTH / HALF;
     int centerY = WINDOW_HEIGHT / HALF;
@@ -356,3 +319,25 @@ void Renderer::drawGameOver(int score) {
     drawText(std::format("Final Score: {}", score), centerX - GAME_OVER_OFFSET_X, centerY);
     drawText("Press ENTER to restart", centerX - GAME_OVER_OFFSET_X - UI_PADDING_LARGE, centerY + GAME_OVER_OFFSET_Y);
 }
+
+void Renderer::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    if (raster_) {
+        raster_->fillRect(rect, color);
+        return;
+    }
+    
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer_, &rect);
+    counters_.drawCalls++;
+}
+
+void Renderer::resetCounters() {
+    counters_ = {};
+    missesAtReset_ = textCache_.misses();
+}
+
+RenderCounters Renderer::getCounters() const {
+    RenderCounters counters = counters_;
+    counters.textureUploads += static_cast<int>(textCache_.misses() - missesAtReset_);
+    return counters;
+}
@@ -0,0 +1,110 @@
+#include "SearchArena.h"
+#include <algorithm>
+#include <cstdint>
+
+SearchArena::SearchArena(std::size_t blockSize, std::pmr::memory_resource* upstream)
+    : blockSize_(blockSize), upstream_(upstream) {}
+
+SearchArena::~SearchArena() {
+    release();
+}
+
+void SearchArena::reset() {
+    current_ = head_;
+    if (current_ != nullptr) {
+        cursor_ = reinterpret_cast<std::byte*>(current_ + 1);
+        end_ = reinterpret_cast<std::byte*>(current_) + current_->size;
+    }
+    bytesInUse_ = 0;
+}
+
+void SearchArena::release() {
+    while (head_ != nullptr) {
+        Block* next = head_->next;
+        upstream_->deallocate(head_, head_->size, alignof(std::max_align_t));
+        head_ = next;
+    }
+    current_ = nullptr;
+    cursor_ = nullptr;
+    end_ = nullptr;
+    bytesInUse_ = 0;
+    capacity_ = 0;
+}
+
+void SearchArena::resetStatistics() {
+    peakBytes_ = bytesInUse_;
+    allocationCount_ = 0;
+    upstreamAllocationCount_ = 0;
+}
+
+SearchArena& SearchArena::threadLocal() {
+    thread_local SearchArena arena;
+    return arena;
+}
+
+void* SearchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    allocationCount_++;
+
+    void* result = nullptr;
+    if (tryBump(bytes, alignment, result)) {
+        return result;
+    }
+
+    // Move on to the next kept block that is large enough, or link in a new
+    // one right after the current block
+    std::size_t needed = sizeof(Block) + bytes + alignment;
+    Block* previous = current_;
+    Block* next = current_ != nullptr ? current_->next : head_;
+    while (next != nullptr && next->size < needed) {
+        previous = next;
+        next = next->next;
+    }
+    if (next == nullptr) {
+        next = allocateBlock(needed);
+        if (previous != nullptr) {
+            next->next = previous->next;
+            previous->next = next;
+        } else {
+            next->next = head_;
+            head_ = next;
+        }
+    }
+
+    // Space skipped at the end of the old block counts as used until reset
+    bytesInUse_ += static_cast<std::size_t>(end_ - cursor_);
+    current_ = next;
+    cursor_ = reinterpret_cast<std::byte*>(current_ + 1);
+    end_ = reinterpret_cast<std::byte*>(current_) + current_->size;
+
+    tryBump(bytes, alignment, result);
+    return result;
+}
+
+bool SearchArena::tryBump(std::size_t bytes, std::size_t alignment, void*& result) {
+    if (cursor_ == nullptr) {
+        return false;
+    }
+
+    auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+    if (padding + bytes > static_cast<std::size_t>(end_ - cursor_)) {
+        return false;
+    }
+
+    result = cursor_ + padding;
+    cursor_ += padding + bytes;
+    bytesInUse_ += padding + bytes;
+    peakBytes_ = std::max(peakBytes_, bytesInUse_);
+    return true;
+}
+
+SearchArena::Block* SearchArena::allocateBlock(std::size_t minimumSize) {
+    std::size_t size = std::max(blockSize_, minimumSize);
+    auto* block = static_cast<Block*>(upstream_->allocate(size, alignof(std::max_align_t)));
+    block->next = nullptr;
+    block->size = size;
+
+    capacity_ += size;
+    upstreamAllocationCount_++;
+    return block;
+}
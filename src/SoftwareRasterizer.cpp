@@ -0,0 +1,173 @@
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TETRIS_RASTER_SSE2 1
+#endif
+
+namespace {
+
+constexpr std::uint32_t OPAQUE_ALPHA = 0xFF000000u;
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+// x / 255 rounded, exact for every product of two bytes
+constexpr std::uint32_t div255(std::uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+std::uint32_t channel(std::uint32_t pixel, int shift) {
+    return (pixel >> shift) & 0xFF;
+}
+
+// Tint then blend one source pixel over an opaque destination pixel
+std::uint32_t blendPixel(std::uint32_t source, std::uint32_t destination, const std::uint32_t tint[4]) {
+    std::uint32_t alpha = div255(channel(source, 24) * tint[3]);
+    std::uint32_t inverse = 255 - alpha;
+    std::uint32_t result = OPAQUE_ALPHA;
+    for (int i = 0; i < 3; i++) {
+        int shift = 16 - i * 8;
+        std::uint32_t tinted = div255(channel(source, shift) * tint[i]);
+        result |= div255(tinted * alpha + channel(destination, shift) * inverse) << shift;
+    }
+    return result;
+}
+
+void fillSpan(std::uint32_t* row, int count, std::uint32_t color) {
+    int i = 0;
+#ifdef TETRIS_RASTER_SSE2
+    __m128i fill = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), fill);
+    }
+#endif
+    for (; i < count; i++) {
+        row[i] = color;
+    }
+}
+
+#ifdef TETRIS_RASTER_SSE2
+// div255 on eight 16-bit lanes
+__m128i div255x8(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Two pixels widened to 16 bits per channel: tint, then blend over the destination
+__m128i blendHalf(__m128i source, __m128i destination, __m128i tint) {
+    source = div255x8(_mm_mullo_epi16(source, tint));
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    return div255x8(_mm_add_epi16(_mm_mullo_epi16(source, alpha), _mm_mullo_epi16(destination, inverse)));
+}
+#endif
+
+void blendSpan(const std::uint32_t* source, std::uint32_t* destination, int count, const std::uint32_t tint[4]) {
+    int i = 0;
+#ifdef TETRIS_RASTER_SSE2
+    // Lanes are B, G, R, A per pixel in memory order
+    __m128i tintLanes = _mm_setr_epi16(static_cast<short>(tint[2]), static_cast<short>(tint[1]),
+                                       static_cast<short>(tint[0]), static_cast<short>(tint[3]),
+                                       static_cast<short>(tint[2]), static_cast<short>(tint[1]),
+                                       static_cast<short>(tint[0]), static_cast<short>(tint[3]));
+    __m128i zero = _mm_setzero_si128();
+    __m128i opaque = _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA));
+    for (; i + 4 <= count; i += 4) {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+        __m128i low = blendHalf(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), tintLanes);
+        __m128i high = blendHalf(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), tintLanes);
+        __m128i result = _mm_or_si128(_mm_packus_epi16(low, high), opaque);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), result);
+    }
+#endif
+    for (; i < count; i++) {
+        destination[i] = blendPixel(source[i], destination[i], tint);
+    }
+}
+
+} // namespace
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+    : width_(std::max(width, 0)),
+      height_(std::max(height, 0)),
+      pixels_(static_cast<std::size_t>(width_) * height_, OPAQUE_ALPHA) {
+}
+
+std::vector<std::uint32_t> SoftwareRasterizer::fromRgba32(std::span<const std::uint8_t> bytes) {
+    std::vector<std::uint32_t> pixels(bytes.size() / BYTES_PER_PIXEL);
+    for (std::size_t i = 0; i < pixels.size(); i++) {
+        const std::uint8_t* rgba = bytes.data() + i * BYTES_PER_PIXEL;
+        pixels[i] = pack({rgba[0], rgba[1], rgba[2], rgba[3]});
+    }
+    return pixels;
+}
+
+bool SoftwareRasterizer::clip(SDL_Rect& rect) const {
+    int left = std::max(rect.x, 0);
+    int top = std::max(rect.y, 0);
+    int right = std::min(rect.x + rect.w, width_);
+    int bottom = std::min(rect.y + rect.h, height_);
+    rect = {left, top, right - left, bottom - top};
+    return rect.w > 0 && rect.h > 0;
+}
+
+void SoftwareRasterizer::clear(SDL_Color color) {
+    fillSpan(pixels_.data(), static_cast<int>(pixels_.size()), pack(color) | OPAQUE_ALPHA);
+}
+
+void SoftwareRasterizer::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    SDL_Rect clipped = rect;
+    if (!clip(clipped)) {
+        return;
+    }
+
+    std::uint32_t packed = pack(color) | OPAQUE_ALPHA;
+    for (int y = clipped.y; y < clipped.y + clipped.h; y++) {
+        fillSpan(pixels_.data() + static_cast<std::size_t>(y) * width_ + clipped.x, clipped.w, packed);
+    }
+}
+
+void SoftwareRasterizer::drawRect(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) {
+        return;
+    }
+
+    fillRect({rect.x, rect.y, rect.w, 1}, color);
+    fillRect({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    fillRect({rect.x, rect.y + 1, 1, rect.h - 2}, color);
+    fillRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, color);
+}
+
+void SoftwareRasterizer::blit(std::span<const std::uint32_t> source, int sourceWidth, const SDL_Rect& sourceRect,
+                              int x, int y, SDL_Color tint) {
+    SDL_Rect destination = {x, y, sourceRect.w, sourceRect.h};
+    if (!clip(destination)) {
+        return;
+    }
+
+    int sourceX = sourceRect.x + (destination.x - x);
+    int sourceY = sourceRect.y + (destination.y - y);
+    if (static_cast<std::size_t>(sourceY + destination.h - 1) * sourceWidth + sourceX + destination.w > source.size()) {
+        return;
+    }
+
+    const std::uint32_t tintChannels[4] = {tint.r, tint.g, tint.b, tint.a};
+    for (int row = 0; row < destination.h; row++) {
+        const std::uint32_t* from = source.data() + static_cast<std::size_t>(sourceY + row) * sourceWidth + sourceX;
+        std::uint32_t* to = pixels_.data() + static_cast<std::size_t>(destination.y + row) * width_ + destination.x;
+        blendSpan(from, to, destination.w, tintChannels);
+    }
+}
+
+std::uint64_t SoftwareRasterizer::checksum() const {
+    std::uint64_t hash = FNV_OFFSET;
+    for (std::uint32_t pixel : pixels_) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash = (hash ^ ((pixel >> shift) & 0xFF)) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
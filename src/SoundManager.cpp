@@ -1,5 +1,13 @@
 #include "SoundManager.h"
+#include "Constants.h"
+#include "SoundSynth.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <string_view>
 #include <vector>
 #include <utility>  // for std::pair
 
@@ -8,6 +16,12 @@ SoundManager::SoundManager()
 }
 
 SoundManager::~SoundManager() {
+    stopMixer();
+    
+    if (loader_.joinable()) {
+        loader_.join();
+    }
+    
     if (initialized_) {
         Mix_CloseAudio();
         Mix_Quit();
@@ -15,20 +29,31 @@ SoundManager::~SoundManager() {
 }
 
 bool SoundManager::initialize() {
-    // Try multiple audio drivers in order
-    const char* drivers[] = {"directsound", "wasapi", "pulseaudio", "alsa", "dummy"};
+    // SDL's own choice first (nullptr), then the drivers this platform has,
+    // so a normal start opens audio on the first attempt
+#if defined(_WIN32)
+    const char* drivers[] = {nullptr, "wasapi", "directsound", "dummy"};
+#elif defined(__APPLE__)
+    const char* drivers[] = {nullptr, "coreaudio", "dummy"};
+#else
+    const char* drivers[] = {nullptr, "pipewire", "pulseaudio", "alsa", "dummy"};
+#endif
     bool success = false;
+    bufferFrames_ = requestedBufferFrames(SDL_getenv("TETRIS_AUDIO_BUFFER"));
     
     for (const char* driver : drivers) {
-        std::cout << "Trying audio driver: " << driver << std::endl;
-        SDL_setenv("SDL_AUDIODRIVER", driver, 1);
+        const char* name = driver ? driver : "default";
+        if (driver) {
+            std::cout << "Trying audio driver: " << driver << '\n';
+            SDL_setenv("SDL_AUDIODRIVER", driver, 1);
+        }
         
-        if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) >= 0) {
-            std::cout << "Successfully initialized audio with driver: " << driver << std::endl;
+        if (Mix_OpenAudio(AUDIO_SAMPLE_RATE, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, bufferFrames_) >= 0) {
+            std::cout << "Successfully initialized audio with driver: " << name << '\n';
             success = true;
             break;
         }
-        std::cerr << "Failed to initialize with " << driver << ": " << Mix_GetError() << std::endl;
+        std::cerr << "Failed to initialize with " << name << ": " << Mix_GetError() << std::endl;
     }
     
     if (!success) {
@@ -38,46 +63,350 @@ bool SoundManager::initialize() {
     }
     
     initialized_ = true;
-    Mix_Volume(-1, volume_);
+    configureDevice();
+    startMixer();
     return true;
 }
+
+int SoundManager::requestedBufferFrames(const char* setting) {
+    int defaultFrames = AUDIO_LOW_LATENCY ? AUDIO_LOW_LATENCY_CHUNK_SIZE : AUDIO_CHUNK_SIZE;
+    if (!setting) {
+        return defaultFrames;
+    }
+    
+    int frames = std::atoi(setting);
+    bool powerOfTwo = frames > 0 && (frames & (frames - 1)) == 0;
+    if (!powerOfTwo || frames < AUDIO_MIN_CHUNK_SIZE || frames > AUDIO_CHUNK_SIZE) {
+        std::cerr << "Ignoring TETRIS_AUDIO_BUFFER=" << setting << ", expected a power of two from "
+                  << AUDIO_MIN_CHUNK_SIZE << " to " << AUDIO_CHUNK_SIZE << std::endl;
+        return defaultFrames;
+    }
+    return frames;
+}
+
+void SoundManager::configureDevice() {
+    Mix_Volume(-1, muted_ ? 0 : volume_);
+    
+    // A group of channels per effect, so a burst of one effect cannot take
+    // the channels another one needs
+    int channels = 0;
+    for (int voices : SOUND_VOICE_LIMITS) {
+        channels += voices;
+    }
+    Mix_AllocateChannels(channels);
+    int first = 0;
+    for (std::size_t i = 0; i < SOUND_EFFECT_COUNT; i++) {
+        Mix_GroupChannels(first, first + SOUND_VOICE_LIMITS[i] - 1, static_cast<int>(i));
+        first += SOUND_VOICE_LIMITS[i];
+    }
+    
+    // The post-mix hook runs once per device callback, which is what we time
+    int frequency = AUDIO_SAMPLE_RATE;
+    Uint16 format = MIX_DEFAULT_FORMAT;
+    int outputChannels = AUDIO_CHANNELS;
+    Mix_QuerySpec(&frequency, &format, &outputChannels);
+    monitor_.reset(bufferFrames_, frequency, SDL_AUDIO_BITSIZE(format) / 8 * outputChannels);
+    latencyLogged_ = false;
+    Mix_SetPostMix(&SoundManager::postMix, this);
+    
+    if (musicHooked_) {
+        Mix_HookMusic(&MusicStream::mix, &music_);
+    }
+}
+
+void SoundManager::loadMusic() {
+    if (!initialized_) {
+        return;
+    }
+    
+    // Kept compressed and decoded while playing, never loaded whole
+    if (archive_) {
+        for (const AssetArchive::Entry& entry : archive_->entries()) {
+            std::string_view name(entry.name, strnlen(entry.name, AssetArchive::NAME_LENGTH));
+            if (name.starts_with("music/")) {
+                if (auto asset = archive_->find(name); !asset || !music_.addTrack(asset->data)) {
+                    std::cerr << "Cannot play music track " << name << std::endl;
+                }
+            }
+        }
+    }
+    if (music_.trackCount() == 0) {
+        std::error_code error;
+        std::vector<std::filesystem::path> files;
+        for (const auto& file : std::filesystem::directory_iterator("resources/music", error)) {
+            if (file.path().extension() == ".wav") {
+                files.push_back(file.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files) {
+            if (!music_.addTrackFile(file.string())) {
+                std::cerr << "Cannot play music track " << file.string() << std::endl;
+            }
+        }
+    }
+    if (music_.trackCount() == 0) {
+        return;
+    }
+    
+    // Sounds are ready by now, so the mixer thread may be reopening the device
+    std::lock_guard<std::mutex> lock(deviceMutex_);
+    int frequency = AUDIO_SAMPLE_RATE;
+    Uint16 format = MIX_DEFAULT_FORMAT;
+    int channels = AUDIO_CHANNELS;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    if (format != AUDIO_S16SYS) {
+        std::cerr << "Music needs 16-bit audio output, playing without it" << std::endl;
+        return;
+    }
+    
+    music_.setOutput(frequency, channels);
+    music_.start();
+    musicHooked_ = true;
+    Mix_HookMusic(&MusicStream::mix, &music_);
+    std::cout << "Streaming " << music_.trackCount() << " music tracks\n";
+}
+
+void SoundManager::postMix(void* manager, Uint8*, int length) {
+    static_cast<SoundManager*>(manager)->monitor_.onCallback(AudioLatencyMonitor::Clock::now(), length);
+}
+
+void SoundManager::checkDevice() {
+    AudioLatencyMonitor::Report report = monitor_.report();
+    if (report.calibrated && !latencyLogged_) {
+        AudioLatencyMonitor::print(std::cout, report);
+        latencyLogged_ = true;
+    }
+    
+    // Wait for the loader: converted sounds depend on the device format
+    if (monitor_.underruns() < AUDIO_UNDERRUN_LIMIT || bufferFrames_ >= AUDIO_CHUNK_SIZE || !soundsReady()) {
+        return;
+    }
+    
+    std::cerr << "Audio underran " << monitor_.underruns() << " times with a " << bufferFrames_
+              << " frame buffer, reopening with " << bufferFrames_ * 2 << std::endl;
+    if (!reopenDevice(bufferFrames_ * 2)) {
+        std::cerr << "Could not reopen audio: " << Mix_GetError() << ". Continuing without sound." << std::endl;
+        deviceLost_ = true;
+    }
+}
+
+bool SoundManager::reopenDevice(int bufferFrames) {
+    std::lock_guard<std::mutex> lock(deviceMutex_);
+    Mix_SetPostMix(nullptr, nullptr);
+    Mix_CloseAudio();
+    
+    // Chunks outlive the device, the format is unchanged so they stay valid
+    bufferFrames_ = bufferFrames;
+    if (Mix_OpenAudio(AUDIO_SAMPLE_RATE, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, bufferFrames_) < 0) {
+        return false;
+    }
+    configureDevice();
+    return true;
+}
+
+void SoundManager::startMixer() {
+    mixer_ = std::thread([this] {
+        std::uint32_t seen = frame_.load(std::memory_order_acquire);
+        while (true) {
+            frame_.wait(seen, std::memory_order_acquire);
+            seen = frame_.load(std::memory_order_acquire);
+            if (stopping_.load(std::memory_order_acquire)) {
+                break;
+            }
+            mixFrame();
+        }
+    });
+}
+
+void SoundManager::stopMixer() {
+    if (!mixer_.joinable()) {
+        return;
+    }
+    stopping_.store(true, std::memory_order_release);
+    frame_.fetch_add(1, std::memory_order_release);
+    frame_.notify_one();
+    mixer_.join();
+}
+
+void SoundManager::endFrame() {
+    frame_.fetch_add(1, std::memory_order_release);
+    frame_.notify_one();
+}
+
+void SoundManager::mixFrame() {
+    SoundQueue::Batch batch = queue_.drain();
+    checkDevice();
+    
+    // Effects queued before the loader finished are dropped, not played late
+    if (!soundsReady() || deviceLost_) {
+        return;
+    }
+    
+    for (std::size_t i = 0; i < SOUND_EFFECT_COUNT; i++) {
+        if (batch[i] > 0) {
+            startVoice(static_cast<SoundEffect>(i));
+        }
+    }
+}
+
+bool SoundManager::startVoice(SoundEffect effect) {
+    auto index = static_cast<std::size_t>(effect);
+    Mix_Chunk* chunk = sounds_[index].get();
+    if (!chunk) {
+        return false;
+    }
+    
+    int tag = static_cast<int>(index);
+    int channel = Mix_GroupAvailable(tag);
+    if (channel < 0) {
+        channel = Mix_GroupOldest(tag);
+    }
+    if (channel < 0) {
+        return false;
+    }
+    return Mix_PlayChannel(channel, chunk, 0) >= 0;
+}
+
 bool SoundManager::loadSounds() {
     if (!initialized_) {
         std::cerr << "Cannot load sounds - audio system not initialized" << std::endl;
+        soundsReady_.store(true, std::memory_order_release);
         // Return true to prevent cascading failures
         return true;
     }
     
     bool success = true;
     
-    // Check if sound files exist and attempt to load them
     const std::vector<std::pair<SoundEffect, std::string>> soundFiles = {
-        {SoundEffect::Move, "resources/sounds/move.wav"},
-        {SoundEffect::Rotate, "resources/sounds/rotate.wav"},
-        {SoundEffect::Drop, "resources/sounds/drop.wav"},
-        {SoundEffect::LineClear, "resources/sounds/clear.wav"},
-        {SoundEffect::LevelUp, "resources/sounds/levelup.wav"},
-        {SoundEffect::GameOver, "resources/sounds/gameover.wav"}
+        {SoundEffect::Move, "sounds/move.wav"},
+        {SoundEffect::Rotate, "sounds/rotate.wav"},
+        {SoundEffect::Drop, "sounds/drop.wav"},
+        {SoundEffect::LineClear, "sounds/clear.wav"},
+        {SoundEffect::LevelUp, "sounds/levelup.wav"},
+        {SoundEffect::GameOver, "sounds/gameover.wav"}
     };
     
-    for (const auto& [effect, filename] : soundFiles) {
-        // Check if file exists before attempting to load
-        FILE* file = fopen(filename.c_str(), "r");
-        if (file) {
-            fclose(file);
-            success &= loadSound(effect, filename);
+    // TETRIS_SYNTH_SOUNDS=1 skips the files altogether
+    const char* synthSetting = SDL_getenv("TETRIS_SYNTH_SOUNDS");
+    bool synthesizeAll = synthSetting && std::string_view(synthSetting) == "1";
+    int synthesized = 0;
+    
+    for (const auto& [effect, name] : soundFiles) {
+        bool loaded = false;
+        if (synthesizeAll) {
+            // Nothing to load
+        } else if (auto asset = archive_ ? archive_->find(name) : std::nullopt) {
+            loaded = loadSound(effect, *asset);
         } else {
-            std::cerr << "Sound file not found: " << filename << std::endl;
+            // Mix_LoadWAV reports a missing file itself, no need to probe first
+            loaded = loadSound(effect, "resources/" + name);
+        }
+        
+        if (!loaded && (synthesizeAll || SYNTHESIZE_MISSING_SOUNDS)) {
+            loaded = synthesize(effect);
+            synthesized += loaded ? 1 : 0;
         }
+        success &= loaded;
     }
     
+    if (synthesized > 0) {
+        std::cout << "Synthesized " << synthesized << " sound effects\n";
+    }
     if (!success) {
         std::cerr << "Warning: Some sounds could not be loaded, continuing with partial sound support" << std::endl;
     }
     
+    soundsReady_.store(true, std::memory_order_release);
     return true; // Always return true to allow game to continue
 }
 
+bool SoundManager::loadSound(SoundEffect effect, const AssetArchive::Asset& asset) {
+    Mix_Chunk* sound = nullptr;
+    if (asset.kind == AssetArchive::Kind::Pcm) {
+        sound = loadPcm(asset.data);
+    } else {
+        sound = Mix_LoadWAV_RW(SDL_RWFromConstMem(asset.data.data(), static_cast<int>(asset.data.size())), 1);
+    }
+    
+    if (!sound) {
+        std::cerr << "Failed to load sound effect: " << asset.name << " - " << Mix_GetError() << std::endl;
+        return false;
+    }
+    
+    sounds_[static_cast<std::size_t>(effect)].reset(sound);
+    return true;
+}
+
+bool SoundManager::synthesize(SoundEffect effect) {
+    int frequency = AUDIO_SAMPLE_RATE;
+    Uint16 format = MIX_DEFAULT_FORMAT;
+    int channels = AUDIO_CHANNELS;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    if (format != AUDIO_S16SYS) {
+        return false;
+    }
+    
+    // Rendered straight into the device format, the chunk plays from our buffer
+    std::vector<std::int16_t>& pcm = synthesized_.emplace_back(
+        SoundSynth::toPcm(SoundSynth::render(effect, frequency), channels));
+    Mix_Chunk* sound = Mix_QuickLoad_RAW(reinterpret_cast<Uint8*>(pcm.data()), static_cast<Uint32>(pcm.size() * sizeof(std::int16_t)));
+    if (!sound) {
+        return false;
+    }
+    sounds_[static_cast<std::size_t>(effect)].reset(sound);
+    return true;
+}
+
+Mix_Chunk* SoundManager::loadPcm(std::span<const std::byte> samples) {
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    
+    // The mixer only reads the samples and a quick-loaded chunk does not own
+    // them, so in the device format they play straight from the archive
+    if (frequency == AUDIO_SAMPLE_RATE && format == MIX_DEFAULT_FORMAT && channels == AUDIO_CHANNELS) {
+        auto* bytes = const_cast<Uint8*>(reinterpret_cast<const Uint8*>(samples.data()));
+        return Mix_QuickLoad_RAW(bytes, static_cast<Uint32>(samples.size()));
+    }
+    
+    // The driver picked another format, convert once into a buffer we keep
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, AUDIO_SAMPLE_RATE,
+                          format, static_cast<Uint8>(channels), frequency) < 0) {
+        return nullptr;
+    }
+    
+    auto capacity = samples.size() * static_cast<std::size_t>(std::max(cvt.len_mult, 1));
+    std::vector<Uint8>& buffer = converted_.emplace_back(capacity);
+    std::memcpy(buffer.data(), samples.data(), samples.size());
+    cvt.buf = buffer.data();
+    cvt.len = static_cast<int>(samples.size());
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        return nullptr;
+    }
+    buffer.resize(cvt.needed ? static_cast<std::size_t>(cvt.len_cvt) : samples.size());
+    return Mix_QuickLoad_RAW(buffer.data(), static_cast<Uint32>(buffer.size()));
+}
+
+void SoundManager::loadSoundsAsync() {
+    if (loader_.joinable()) {
+        return;
+    }
+    
+    // Decoding and converting the WAVs is the slowest part of startup and the
+    // start screen makes no sound, so it overlaps with the first frames
+    loader_ = std::thread([this] {
+        auto start = std::chrono::steady_clock::now();
+        loadSounds();
+        loadMusic();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        auto loaded = std::count_if(sounds_.begin(), sounds_.end(), [](const auto& sound) { return sound != nullptr; });
+        std::cout << "Loaded " << loaded << " sounds in the background in " << elapsed.count() << " ms\n";
+    });
+}
+
 bool SoundManager::loadSound(SoundEffect effect, const std::string& filename) {
     Mix_Chunk* sound = Mix_LoadWAV(filename.c_str());
     
@@ -87,7 +416,7 @@ bool SoundManager::loadSound(SoundEffect effect, const std::string& filename) {
         return false;
     }
     
-    sounds_[effect] = std::unique_ptr<Mix_Chunk, MixChunkDeleter>(sound);
+    sounds_[static_cast<std::size_t>(effect)].reset(sound);
     return true;
 }
 
@@ -96,13 +425,12 @@ void SoundManager::playSound(SoundEffect effect) {
         return;
     }
     
-    auto it = sounds_.find(effect);
-    if (it != sounds_.end()) {
-        Mix_PlayChannel(-1, it->second.get(), 0);
-    }
+    // Full means the audio thread has fallen behind, losing a click beats waiting for it
+    queue_.push(effect);
 }
 
 void SoundManager::setVolume(int volume) {
+    std::lock_guard<std::mutex> lock(deviceMutex_);
     volume_ = (volume * MIX_MAX_VOLUME) / 100;
     
     if (volume_ < 0) volume_ = 0;
@@ -112,7 +440,9 @@ void SoundManager::setVolume(int volume) {
 }
 
 void SoundManager::toggleMute() {
+    std::lock_guard<std::mutex> lock(deviceMutex_);
     muted_ = !muted_;
+    music_.setMuted(muted_);
     
     if (muted_) {
         Mix_Volume(-1, 0);
@@ -0,0 +1,21 @@
+#include "SoundQueue.h"
+
+bool SoundQueue::push(SoundEffect effect) {
+    if (!events_.push({effect})) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+SoundQueue::Batch SoundQueue::drain() {
+    Batch batch{};
+    Event event;
+    while (events_.pop(event)) {
+        auto index = static_cast<std::size_t>(event.effect);
+        if (index < SOUND_EFFECT_COUNT) {
+            batch[index]++;
+        }
+    }
+    return batch;
+}
@@ -0,0 +1,223 @@
+#include "SoundSynth.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TETRIS_SYNTH_SSE2 1
+#endif
+
+namespace {
+
+using Wave = SoundSynth::Wave;
+
+// Start, length, pitch slide, volume, duty, decay
+constexpr SoundSynth::Note MOVE[] = {
+    {Wave::Square, 0.0f, 0.03f, 440.0f, 420.0f, 0.2f, 0.5f, 0.02f},
+};
+constexpr SoundSynth::Note ROTATE[] = {
+    {Wave::Square, 0.0f, 0.06f, 600.0f, 900.0f, 0.2f, 0.25f, 0.04f},
+};
+constexpr SoundSynth::Note DROP[] = {
+    {Wave::Noise, 0.0f, 0.08f, 0.0f, 0.0f, 0.3f, 0.0f, 0.02f},
+    {Wave::Square, 0.0f, 0.12f, 150.0f, 60.0f, 0.35f, 0.5f, 0.05f},
+};
+constexpr SoundSynth::Note LINE_CLEAR[] = {
+    {Wave::Triangle, 0.00f, 0.08f, 523.3f, 523.3f, 0.45f, 0.0f, 0.0f},
+    {Wave::Triangle, 0.07f, 0.08f, 659.3f, 659.3f, 0.45f, 0.0f, 0.0f},
+    {Wave::Triangle, 0.14f, 0.08f, 784.0f, 784.0f, 0.45f, 0.0f, 0.0f},
+    {Wave::Triangle, 0.21f, 0.20f, 1046.5f, 1046.5f, 0.45f, 0.0f, 0.12f},
+};
+constexpr SoundSynth::Note LEVEL_UP[] = {
+    {Wave::Square, 0.00f, 0.09f, 392.0f, 392.0f, 0.2f, 0.5f, 0.0f},
+    {Wave::Square, 0.09f, 0.09f, 523.3f, 523.3f, 0.2f, 0.5f, 0.0f},
+    {Wave::Square, 0.18f, 0.09f, 659.3f, 659.3f, 0.2f, 0.5f, 0.0f},
+    {Wave::Square, 0.27f, 0.30f, 784.0f, 784.0f, 0.2f, 0.5f, 0.15f},
+    {Wave::Triangle, 0.27f, 0.30f, 392.0f, 392.0f, 0.3f, 0.0f, 0.15f},
+};
+constexpr SoundSynth::Note GAME_OVER[] = {
+    {Wave::Square, 0.00f, 0.20f, 392.0f, 392.0f, 0.2f, 0.5f, 0.0f},
+    {Wave::Square, 0.20f, 0.20f, 329.6f, 329.6f, 0.2f, 0.5f, 0.0f},
+    {Wave::Square, 0.40f, 0.20f, 261.6f, 261.6f, 0.2f, 0.5f, 0.0f},
+    {Wave::Saw, 0.60f, 0.70f, 196.0f, 98.0f, 0.25f, 0.0f, 0.35f},
+};
+
+constexpr std::array<std::uint32_t, 4> NOISE_SEEDS = {0x12345678u, 0x9E3779B9u, 0x7F4A7C15u, 0x2545F491u};
+constexpr float NOISE_SCALE = 1.0f / 2147483648.0f;
+
+std::size_t samplesFor(float seconds, int sampleRate) {
+    return static_cast<std::size_t>(std::lround(seconds * static_cast<float>(sampleRate)));
+}
+
+float wave(Wave type, float phase, float duty, std::uint32_t& noise) {
+    switch (type) {
+        case Wave::Square:
+            return phase < duty ? 1.0f : -1.0f;
+        case Wave::Triangle:
+            return 4.0f * std::fabs(phase - 0.5f) - 1.0f;
+        case Wave::Saw:
+            return 2.0f * phase - 1.0f;
+        case Wave::Noise:
+            noise ^= noise << 13;
+            noise ^= noise >> 17;
+            noise ^= noise << 5;
+            return static_cast<float>(static_cast<std::int32_t>(noise)) * NOISE_SCALE;
+    }
+    return 0.0f;
+}
+
+#ifdef TETRIS_SYNTH_SSE2
+__m128 waveX4(Wave type, __m128 phase, __m128 duty, __m128i& noise) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    switch (type) {
+        case Wave::Square: {
+            __m128 high = _mm_cmplt_ps(phase, duty);
+            return _mm_or_ps(_mm_and_ps(high, one), _mm_andnot_ps(high, _mm_set1_ps(-1.0f)));
+        }
+        case Wave::Triangle: {
+            __m128 centred = _mm_sub_ps(phase, _mm_set1_ps(0.5f));
+            __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), centred);
+            return _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(4.0f), magnitude), one);
+        }
+        case Wave::Saw:
+            return _mm_sub_ps(_mm_add_ps(phase, phase), one);
+        case Wave::Noise:
+            noise = _mm_xor_si128(noise, _mm_slli_epi32(noise, 13));
+            noise = _mm_xor_si128(noise, _mm_srli_epi32(noise, 17));
+            noise = _mm_xor_si128(noise, _mm_slli_epi32(noise, 5));
+            return _mm_mul_ps(_mm_cvtepi32_ps(noise), _mm_set1_ps(NOISE_SCALE));
+    }
+    return _mm_setzero_ps();
+}
+#endif
+
+} // namespace
+
+std::span<const SoundSynth::Note> SoundSynth::patch(SoundEffect effect) {
+    switch (effect) {
+        case SoundEffect::Move: return MOVE;
+        case SoundEffect::Rotate: return ROTATE;
+        case SoundEffect::Drop: return DROP;
+        case SoundEffect::LineClear: return LINE_CLEAR;
+        case SoundEffect::LevelUp: return LEVEL_UP;
+        case SoundEffect::GameOver: return GAME_OVER;
+    }
+    return {};
+}
+
+std::vector<float> SoundSynth::render(SoundEffect effect, int sampleRate) {
+    std::size_t length = 0;
+    for (const Note& note : patch(effect)) {
+        length = std::max(length, samplesFor(note.start, sampleRate) + samplesFor(note.duration, sampleRate));
+    }
+
+    std::vector<float> samples(length);
+    for (const Note& note : patch(effect)) {
+        renderNote(note, sampleRate, std::span<float>(samples).subspan(samplesFor(note.start, sampleRate)));
+    }
+    return samples;
+}
+
+void SoundSynth::renderNote(const Note& note, int sampleRate, std::span<float> out) {
+    std::size_t count = std::min(samplesFor(note.duration, sampleRate), out.size());
+    if (count == 0) {
+        return;
+    }
+
+    // Phase is in cycles; the per-sample increment itself moves by `slide`
+    // each sample for the pitch sweep
+    float rate = static_cast<float>(sampleRate);
+    float increment = note.fromHz / rate;
+    float slide = (note.toHz - note.fromHz) / rate / static_cast<float>(count);
+    float decay = note.decay > 0.0f ? std::exp(-1.0f / (note.decay * rate)) : 1.0f;
+    float attack = 1.0f / (ATTACK * rate);
+    float release = 1.0f / (RELEASE * rate);
+    float last = static_cast<float>(count);
+
+    float phase = 0.0f;
+    float level = note.volume;
+    std::array<std::uint32_t, 4> noise = NOISE_SEEDS;
+    std::size_t i = 0;
+
+#ifdef TETRIS_SYNTH_SSE2
+    // Lane j holds sample i + j; four samples on, the phase has moved by
+    // four increments plus six slides and the increment by four slides
+    __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    __m128 phaseX4 = _mm_add_ps(_mm_mul_ps(lane, _mm_set1_ps(increment)),
+                                _mm_mul_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 3.0f), _mm_set1_ps(slide)));
+    __m128 incrementX4 = _mm_add_ps(_mm_set1_ps(increment), _mm_mul_ps(lane, _mm_set1_ps(slide)));
+    __m128 levelX4 = _mm_mul_ps(_mm_set1_ps(note.volume), _mm_setr_ps(1.0f, decay, decay * decay, decay * decay * decay));
+    __m128 decayX4 = _mm_set1_ps(decay * decay * decay * decay);
+    __m128 slideX4 = _mm_set1_ps(4.0f * slide);
+    __m128 slideSum = _mm_set1_ps(6.0f * slide);
+    __m128 index = lane;
+    __m128i noiseX4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(noise.data()));
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 four = _mm_set1_ps(4.0f);
+    const __m128 duty = _mm_set1_ps(note.duty);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 fadeIn = _mm_mul_ps(index, _mm_set1_ps(attack));
+        __m128 fadeOut = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(last), index), _mm_set1_ps(release));
+        __m128 envelope = _mm_mul_ps(_mm_min_ps(_mm_min_ps(fadeIn, fadeOut), one), levelX4);
+
+        __m128 sample = _mm_mul_ps(waveX4(note.wave, phaseX4, duty, noiseX4), envelope);
+        _mm_storeu_ps(out.data() + i, _mm_add_ps(_mm_loadu_ps(out.data() + i), sample));
+
+        phaseX4 = _mm_add_ps(phaseX4, _mm_add_ps(_mm_mul_ps(incrementX4, four), slideSum));
+        phaseX4 = _mm_sub_ps(phaseX4, _mm_cvtepi32_ps(_mm_cvttps_epi32(phaseX4)));
+        incrementX4 = _mm_add_ps(incrementX4, slideX4);
+        levelX4 = _mm_mul_ps(levelX4, decayX4);
+        index = _mm_add_ps(index, four);
+    }
+
+    // The scalar loop picks up from lane 0
+    phase = _mm_cvtss_f32(phaseX4);
+    increment = _mm_cvtss_f32(incrementX4);
+    level = _mm_cvtss_f32(levelX4);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(noise.data()), noiseX4);
+#endif
+
+    for (; i < count; i++) {
+        float position = static_cast<float>(i);
+        float envelope = std::min({position * attack, (last - position) * release, 1.0f}) * level;
+        out[i] += wave(note.wave, phase, note.duty, noise[i % noise.size()]) * envelope;
+
+        phase += increment;
+        phase -= std::floor(phase);
+        increment += slide;
+        level *= decay;
+    }
+}
+
+std::vector<std::int16_t> SoundSynth::toPcm(std::span<const float> samples, int channels) {
+    std::size_t width = static_cast<std::size_t>(std::max(channels, 1));
+    std::vector<std::int16_t> pcm(samples.size() * width);
+    std::size_t i = 0;
+
+#ifdef TETRIS_SYNTH_SSE2
+    // Eight samples at a time, packs saturates anything past full scale
+    if (width <= 2) {
+        const __m128 scale = _mm_set1_ps(32767.0f);
+        for (; i + 8 <= samples.size(); i += 8) {
+            __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(samples.data() + i), scale));
+            __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(samples.data() + i + 4), scale));
+            __m128i packed = _mm_packs_epi32(low, high);
+            auto* target = reinterpret_cast<__m128i*>(pcm.data() + i * width);
+            if (width == 1) {
+                _mm_storeu_si128(target, packed);
+            } else {
+                _mm_storeu_si128(target, _mm_unpacklo_epi16(packed, packed));
+                _mm_storeu_si128(target + 1, _mm_unpackhi_epi16(packed, packed));
+            }
+        }
+    }
+#endif
+
+    for (; i < samples.size(); i++) {
+        long value = std::clamp(std::lrint(samples[i] * 32767.0f), -32768L, 32767L);
+        std::fill_n(pcm.begin() + static_cast<std::ptrdiff_t>(i * width), width, static_cast<std::int16_t>(value));
+    }
+    return pcm;
+}
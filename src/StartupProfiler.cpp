@@ -0,0 +1,48 @@
+#include "StartupProfiler.h"
+#include "Constants.h"
+#include <algorithm>
+
+namespace {
+
+double milliseconds(StartupProfiler::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+void StartupProfiler::record(const char* name, Clock::duration duration) {
+    if (count_ < phases_.size()) {
+        phases_[count_++] = {name, duration};
+    }
+}
+
+bool StartupProfiler::markFirstFrame(Clock::time_point presented) {
+    Clock::rep unset = -1;
+    Clock::rep elapsed = std::max<Clock::rep>((presented - start_).count(), 0);
+    return firstFrame_.compare_exchange_strong(unset, elapsed, std::memory_order_relaxed);
+}
+
+std::optional<StartupProfiler::Clock::duration> StartupProfiler::getTimeToFirstFrame() const {
+    Clock::rep elapsed = firstFrame_.load(std::memory_order_relaxed);
+    if (elapsed < 0) {
+        return std::nullopt;
+    }
+    return Clock::duration(elapsed);
+}
+
+void StartupProfiler::report(std::ostream& out) const {
+    out << "Startup:";
+    for (const Phase& phase : phases()) {
+        out << ' ' << phase.name << ' ' << milliseconds(phase.duration) << " ms,";
+    }
+
+    if (auto firstFrame = getTimeToFirstFrame()) {
+        out << " first frame after " << milliseconds(*firstFrame) << " ms";
+        if (*firstFrame > STARTUP_TARGET) {
+            out << ", over the " << STARTUP_TARGET.count() << " ms target";
+        }
+    } else {
+        out << " no frame presented yet";
+    }
+    out << '\n';
+}
@@ -1,10 +1,13 @@
 #include "TetrominoManager.h"
 #include "Game.h"
+#include "Finesse.h"
+#include "Trace.h"
 #include <algorithm>
 #include <array>
+#include <bit>
 
 TetrominoManager::TetrominoManager(Game& game) 
-    : game_(game), currentTetromino_(nullptr) {
+    : game_(game), currentTetromino_(nullptr), pieceInputs_(0) {
     
     initRng();
     generateNextTetrominoType();
@@ -26,62 +29,75 @@ bool TetrominoManager::moveTetromino(int dx, int dy) {
     int newX = currentTetromino_->x() + dx;
     int newY = currentTetromino_->y() + dy;
     
-    Tetromino testTetromino(currentTetromino_->type(), newX, newY);
-    
-    for (int i = 0; i < currentTetromino_->rotation(); i++) {
-        testTetromino.rotateWithoutWallKick(); 
-    }
-    
-    if (!isValidPosition(testTetromino)) {
+    if (!canMove(dx, dy)) {
         return false;
     }
     
     if (dx != NO_MOVE) {
+        pieceInputs_++;  // A press into a wall is not a wasted input
         currentTetromino_->setPosition(newX, currentTetromino_->y());
+        lockDelay_.onMove();
         game_.playMoveSound();
     }
     if (dy != NO_MOVE) {
         currentTetromino_->setPosition(currentTetromino_->x(), newY);
+        lockDelay_.onFall(newY);
     }
     
     return true;
 }
 
+int TetrominoManager::shiftTetromino(int dx, int steps) {
+    // Repeats of a held key: finesse counted the press that started them,
+    // so a shift to the wall is one input like FinesseInput::DasLeft
+    int moved = 0;
+    while (currentTetromino_ && moved < steps && canMove(dx, NO_MOVE)) {
+        currentTetromino_->setPosition(currentTetromino_->x() + dx, currentTetromino_->y());
+        moved++;
+    }
+    
+    if (moved > 0) {
+        lockDelay_.onMove();
+        game_.playMoveSound();
+    }
+    return moved;
+}
+
+bool TetrominoManager::canMove(int dx, int dy) const {
+    Tetromino testTetromino(currentTetromino_->type(), currentTetromino_->x() + dx, currentTetromino_->y() + dy);
+    
+    for (int i = 0; i < currentTetromino_->rotation(); i++) {
+        testTetromino.rotateWithoutWallKick(); 
+    }
+    
+    return isValidPosition(testTetromino);
+}
+
 void TetrominoManager::rotateTetromino() {
     if (currentTetromino_) {
         int oldRotation = currentTetromino_->rotation();
         currentTetromino_->rotate(game_);
         
         if (oldRotation != currentTetromino_->rotation()) {
+            pieceInputs_++;  // Like moves, a blocked rotation is not a wasted input
+            lockDelay_.onMove();
+            lockDelay_.onFall(currentTetromino_->y());  // A kick may have taken it lower
             game_.playRotateSound();
         }
     }
 }
 
 void TetrominoManager::softDrop() {
-    if (!moveTetromino(NO_MOVE, MOVE_DOWN)) {
-        lockTetromino();
-        clearLines();
-        
-        if (!createNewTetromino()) {
-            game_.setGameOver();
-        }
-    }
+    // On the ground the lock delay decides when it locks, only hard drop locks at once
+    moveTetromino(NO_MOVE, MOVE_DOWN);
 }
 
 void TetrominoManager::hardDrop() {
     if (!currentTetromino_) return;
     
-    int dropCount = 0;
-    while (moveTetromino(NO_MOVE, MOVE_DOWN)) {
-        game_.increaseScore(1);  // Extra points for hard drop
-        dropCount++;
-        
-        // Safety check to prevent infinite loop
-        if (dropCount > GRID_HEIGHT) {
-            break;
-        }
-    }
+    int distance = dropDistance();
+    currentTetromino_->setPosition(currentTetromino_->x(), currentTetromino_->y() + distance);
+    game_.increaseScore(distance);  // Extra point per row for hard drop
     
     game_.playDropSound();
     
@@ -93,9 +109,49 @@ void TetrominoManager::hardDrop() {
     }
 }
 
+int TetrominoManager::dropTetromino(int rows) {
+    if (!currentTetromino_) return 0;
+    
+    int fallen = std::min(rows, dropDistance());
+    currentTetromino_->setPosition(currentTetromino_->x(), currentTetromino_->y() + fallen);
+    lockDelay_.onFall(currentTetromino_->y());
+    return fallen;
+}
+
+bool TetrominoManager::tickLockDelay() {
+    return currentTetromino_ && lockDelay_.tick(isGrounded());
+}
+
+int TetrominoManager::ticksUntilLock() const {
+    return lockDelay_.ticksLeft();
+}
+
+int TetrominoManager::dropDistance() const {
+    if (!currentTetromino_) return 0;
+    
+    const Tetromino& piece = *currentTetromino_;
+    DropCache& cache = dropCache_;
+    bool sameColumn = cache.valid && cache.type == piece.type() && cache.x == piece.x() &&
+                      cache.rotation == piece.rotation() && cache.boardVersion == game_.getBoardVersion();
+    
+    // Falling never passes the landing row, so it stays right until the piece moves sideways or turns
+    if (!sameColumn || piece.y() < cache.fromY || piece.y() > cache.landingY) {
+        int landingY = piece.y();
+        while (landingY < GRID_HEIGHT && piece.isValidPosition(game_, piece.x(), landingY + 1, piece.rotation())) {
+            landingY++;
+        }
+        cache = {true, piece.type(), piece.x(), piece.rotation(), piece.y(), landingY, game_.getBoardVersion()};
+    }
+    
+    return cache.landingY - piece.y();
+}
+
 void TetrominoManager::lockTetromino() {
+    TRACE_ZONE("TetrominoManager::lockTetromino");
     if (!currentTetromino_) return;
     
+    checkFinesse();
+    
     auto& grid = const_cast<std::vector<std::vector<std::optional<TetrominoType>>>&>(game_.getGrid());
     
     for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
@@ -110,37 +166,21 @@ void TetrominoManager::lockTetromino() {
             }
         }
     }
+    
+    game_.markBoardChanged();
 }
 
 void TetrominoManager::clearLines() {
+    TRACE_ZONE("TetrominoManager::clearLines");
     auto& grid = const_cast<std::vector<std::vector<std::optional<TetrominoType>>>&>(game_.getGrid());
-    int linesCleared = 0;
     
-    for (int y = GRID_HEIGHT - 1; y >= 0; y--) {
-        bool lineComplete = true;
-        
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            if (!grid[y][x].has_value()) {
-                lineComplete = false;
-                break;
-            }
-        }
-        
-        if (lineComplete) {
-            // Clear the line
-            for (int yy = y; yy > 0; yy--) {
-                grid[yy] = grid[yy - 1];
-            }
-            
-            // Clear the top line
-            std::fill(grid[0].begin(), grid[0].end(), std::optional<TetrominoType>{});
-            
-            linesCleared++;
-            y++; // Recheck this position
-        }
-    }
+    // Which lines are full and how the rest fall is decided by Board
+    std::uint32_t lines = Board::fromGrid(grid).fullLines();
+    int linesCleared = std::popcount(lines);
     
     if (linesCleared > 0) {
+        Board::removeLines(grid, lines, std::vector<std::optional<TetrominoType>>(GRID_WIDTH));
+        game_.markBoardChanged();
         game_.playLineClearSound();
         
         calculateScoreAndUpdateLevel(linesCleared);
@@ -148,22 +188,33 @@ void TetrominoManager::clearLines() {
 }
 
 void TetrominoManager::calculateScoreAndUpdateLevel(int linesCleared) {
-    static const std::array<int, 4> lineScores = {100, 300, 500, 800};
-    int points = lineScores[std::min(linesCleared, TETROMINO_GRID_SIZE) - 1] * game_.getLevel();
-    
-    game_.increaseScore(points);
+    game_.increaseScore(lineClearScore(linesCleared, game_.getLevel()));
     game_.incrementLinesCleared(linesCleared);
 }
 
+void TetrominoManager::checkFinesse() {
+    // Compare against the board before this piece is written into it
+    Board board = Board::fromGrid(game_.getGrid());
+    Placement placement{currentTetromino_->type(), currentTetromino_->rotation(),
+                        currentTetromino_->x(), currentTetromino_->y()};
+    
+    auto minimal = Finesse::sequenceFor(board, placement);
+    if (minimal && pieceInputs_ > minimal->movementCount()) {
+        game_.addFinesseFault();
+    }
+}
+
 bool TetrominoManager::createNewTetromino() {
+    TRACE_ZONE("TetrominoManager::createNewTetromino");
     TetrominoType type = nextTetrominoType_;
     
     generateNextTetrominoType();
     
-    int startX = GRID_WIDTH / HALF - HALF;
-    int startY = (type == TetrominoType::I) ? MOVE_LEFT : NO_MOVE;
-    
-    currentTetromino_ = std::make_unique<Tetromino>(type, startX, startY);
+    currentTetromino_ = std::make_unique<Tetromino>(spawnTetromino(type));
+    pieceInputs_ = 0;
+    dropCache_.valid = false;
+    lockDelay_.reset(currentTetromino_->y());
+    game_.resetGravity();
     
     if (!canPlaceNewTetromino()) {
         return false;  // Game over
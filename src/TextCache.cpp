@@ -0,0 +1,93 @@
+#include "TextCache.h"
+#include <functional>
+
+TextCache::TextCache(SDL_Renderer* renderer, std::size_t byteBudget)
+    : renderer_(renderer), byteBudget_(byteBudget) {}
+
+TextCache::~TextCache() {
+    // Textures are released directly here since destroy() must not be
+    // dispatched virtually from a destructor
+    for (Node& node : entries_) {
+        if (node.entry.texture) {
+            SDL_DestroyTexture(node.entry.texture);
+        }
+    }
+}
+
+const TextCache::Entry* TextCache::get(std::string_view text, TTF_Font* font, SDL_Color color) {
+    auto found = index_.find(KeyView{text, font, packColor(color)});
+    if (found != index_.end()) {
+        hits_++;
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return &found->second->entry;
+    }
+
+    misses_++;
+    Entry entry{nullptr, 0, 0};
+    if (!render(text, font, color, entry)) {
+        return nullptr;
+    }
+
+    entries_.push_front({{std::string(text), font, packColor(color)}, entry});
+    index_.emplace(entries_.front().key, entries_.begin());
+    bytes_ += entryBytes(entry);
+    evictToBudget();
+
+    return &entries_.front().entry;
+}
+
+void TextCache::clear() {
+    for (Node& node : entries_) {
+        destroy(node.entry);
+    }
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+bool TextCache::render(std::string_view text, TTF_Font* font, SDL_Color color, Entry& entry) {
+    // Use Blended rendering for better quality with Unicode characters
+    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, std::string(text).c_str(), color);
+    if (!surface) {
+        return false;
+    }
+
+    entry = {SDL_CreateTextureFromSurface(renderer_, surface), surface->w, surface->h};
+    SDL_FreeSurface(surface);
+    return entry.texture != nullptr;
+}
+
+void TextCache::destroy(Entry& entry) {
+    if (entry.texture) {
+        SDL_DestroyTexture(entry.texture);
+        entry.texture = nullptr;
+    }
+}
+
+std::size_t TextCache::KeyHash::operator()(const KeyView& key) const {
+    std::size_t hash = std::hash<std::string_view>{}(key.text);
+    hash ^= std::hash<const void*>{}(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<std::uint32_t>{}(key.color) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+std::uint32_t TextCache::packColor(SDL_Color color) {
+    return (static_cast<std::uint32_t>(color.r) << 24) | (static_cast<std::uint32_t>(color.g) << 16) |
+           (static_cast<std::uint32_t>(color.b) << 8) | color.a;
+}
+
+std::size_t TextCache::entryBytes(const Entry& entry) {
+    return static_cast<std::size_t>(entry.width) * entry.height * BYTES_PER_PIXEL;
+}
+
+void TextCache::evictToBudget() {
+    // Never evict the entry just added, even if it is over budget on its own
+    while (bytes_ > byteBudget_ && entries_.size() > 1) {
+        Node& oldest = entries_.back();
+        bytes_ -= entryBytes(oldest.entry);
+        destroy(oldest.entry);
+        index_.erase(oldest.key);
+        entries_.pop_back();
+        evictions_++;
+    }
+}
@@ -0,0 +1,167 @@
+#include "Trace.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Trace::enabled_{false};
+
+namespace {
+
+static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE must be a power of two");
+
+// Fields are atomic so the writer can reuse a slot while a dump reads it
+struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::int64_t> begin{0};  // Nanoseconds since the epoch below
+    std::atomic<std::int64_t> end{0};
+};
+
+// One thread's zones. Only that thread writes, buffers live until exit so
+// a dump still sees threads that have finished.
+struct ThreadBuffer {
+    std::array<Slot, TRACE_RING_SIZE> slots;
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<const char*> name{nullptr};
+    int id = 0;
+};
+
+const Trace::Clock::time_point epoch = Trace::Clock::now();
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+thread_local ThreadBuffer* threadBuffer = nullptr;
+thread_local const char* threadName = nullptr;  // Kept until the thread records its first zone
+
+ThreadBuffer& currentBuffer() {
+    if (!threadBuffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.push_back(std::make_unique<ThreadBuffer>());
+        threadBuffer = registry.back().get();
+        threadBuffer->id = static_cast<int>(registry.size());
+        threadBuffer->name.store(threadName, std::memory_order_relaxed);
+    }
+    return *threadBuffer;
+}
+
+std::int64_t sinceEpoch(Trace::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count();
+}
+
+struct Copied {
+    const char* name;
+    std::int64_t begin;
+    std::int64_t end;
+};
+
+// The zones still in the ring, oldest first
+std::vector<Copied> copyZones(const ThreadBuffer& buffer) {
+    std::uint64_t end = buffer.written.load(std::memory_order_acquire);
+    std::uint64_t start = end > TRACE_RING_SIZE ? end - TRACE_RING_SIZE : 0;
+
+    std::vector<Copied> zones;
+    zones.reserve(static_cast<std::size_t>(end - start));
+    for (std::uint64_t i = start; i < end; i++) {
+        const Slot& slot = buffer.slots[i & (TRACE_RING_SIZE - 1)];
+        zones.push_back({slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+                         slot.end.load(std::memory_order_relaxed)});
+    }
+
+    // Slots the writer got round to again while we copied hold newer zones,
+    // and it may be halfway through the slot of zone `after` as well. The
+    // fence pairs with the one in record(): once we have copied any store of
+    // zone k, this load returns at least k, so the slot it reused is trimmed.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t after = buffer.written.load(std::memory_order_relaxed);
+    std::uint64_t firstIntact = after + 1 > TRACE_RING_SIZE ? after + 1 - TRACE_RING_SIZE : 0;
+    if (firstIntact > start) {
+        zones.erase(zones.begin(), zones.begin() + static_cast<std::ptrdiff_t>(std::min(firstIntact - start, end - start)));
+    }
+    return zones;
+}
+
+void writeString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Trace::setThreadName(const char* name) {
+    // A thread's ring is only allocated once it records something
+    threadName = name;
+    if (threadBuffer) {
+        threadBuffer->name.store(name, std::memory_order_relaxed);
+    }
+}
+
+void Trace::record(const char* name, Clock::time_point begin, Clock::time_point end) {
+    ThreadBuffer& buffer = currentBuffer();
+    std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    Slot& slot = buffer.slots[index & (TRACE_RING_SIZE - 1)];
+    
+    // Seqlock-style: a dump that sees any of the stores below also sees
+    // written == index, so it knows this slot may be half overwritten
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(sinceEpoch(begin), std::memory_order_relaxed);
+    slot.end.store(sinceEpoch(end), std::memory_order_relaxed);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Trace::writeChromeJson(std::ostream& out) {
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& buffer : registry) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    // Complete ("X") events, timestamps in microseconds
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    out << std::fixed << std::setprecision(3);
+    bool first = true;
+    auto separator = [&] {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    for (const ThreadBuffer* buffer : buffers) {
+        if (const char* name = buffer->name.load(std::memory_order_relaxed)) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+            writeString(out, name);
+            out << "}}";
+        }
+
+        for (const Copied& zone : copyZones(*buffer)) {
+            if (!zone.name) {
+                continue;
+            }
+            separator();
+            out << "{\"name\":";
+            writeString(out, zone.name);
+            out << ",\"cat\":\"tetris\",\"ph\":\"X\",\"ts\":" << zone.begin / 1000.0
+                << ",\"dur\":" << (zone.end - zone.begin) / 1000.0 << ",\"pid\":1,\"tid\":" << buffer->id << "}";
+        }
+    }
+    out << "]}\n";
+}
+
+bool Trace::writeChromeJson(const std::string& path) {
+    std::ofstream out(path);
+    writeChromeJson(out);
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,176 @@
+#include "WavDecoder.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<int, 89> IMA_STEPS = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66,
+    73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449,
+    494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272,
+    2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493,
+    10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+constexpr std::array<int, 8> IMA_INDEX_CHANGE = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+std::uint16_t read16(std::span<const std::byte> bytes, std::size_t offset) {
+    return static_cast<std::uint16_t>(std::to_integer<unsigned>(bytes[offset]) |
+                                      std::to_integer<unsigned>(bytes[offset + 1]) << 8);
+}
+
+std::uint32_t read32(std::span<const std::byte> bytes, std::size_t offset) {
+    return read16(bytes, offset) | static_cast<std::uint32_t>(read16(bytes, offset + 2)) << 16;
+}
+
+bool hasId(std::span<const std::byte> bytes, std::size_t offset, std::string_view id) {
+    return std::memcmp(bytes.data() + offset, id.data(), 4) == 0;
+}
+
+struct ImaChannel {
+    int predictor;
+    int index;
+
+    std::int16_t decode(unsigned nibble) {
+        int step = IMA_STEPS[static_cast<std::size_t>(index)];
+        int diff = step >> 3;
+        if (nibble & 1) diff += step >> 2;
+        if (nibble & 2) diff += step >> 1;
+        if (nibble & 4) diff += step;
+        predictor = std::clamp(nibble & 8 ? predictor - diff : predictor + diff, -32768, 32767);
+        index = std::clamp(index + IMA_INDEX_CHANGE[nibble & 7], 0, static_cast<int>(IMA_STEPS.size()) - 1);
+        return static_cast<std::int16_t>(predictor);
+    }
+};
+
+} // namespace
+
+bool WavDecoder::open(std::span<const std::byte> wav) {
+    data_ = {};
+    if (wav.size() < 12 || !hasId(wav, 0, "RIFF") || !hasId(wav, 8, "WAVE")) {
+        return false;
+    }
+
+    // Chunks are padded to an even size
+    bool haveFormat = false;
+    std::span<const std::byte> data;
+    for (std::size_t offset = 12; offset + 8 <= wav.size();) {
+        std::size_t size = read32(wav, offset + 4);
+        std::size_t body = offset + 8;
+        if (size > wav.size() - body) {
+            size = wav.size() - body;  // Truncated files play up to the cut
+        }
+
+        if (hasId(wav, offset, "fmt ") && size >= 16) {
+            format_ = read16(wav, body);
+            channels_ = read16(wav, body + 2);
+            sampleRate_ = static_cast<int>(read32(wav, body + 4));
+            blockAlign_ = read16(wav, body + 12);
+            int bits = read16(wav, body + 14);
+            haveFormat = (format_ == FORMAT_PCM && bits == 16) || (format_ == FORMAT_IMA_ADPCM && bits == 4);
+        } else if (hasId(wav, offset, "data")) {
+            data = wav.subspan(body, size);
+        }
+        offset = body + size + (size & 1);
+    }
+
+    if (!haveFormat || channels_ < 1 || channels_ > MAX_CHANNELS || sampleRate_ <= 0 || data.empty() ||
+        blockAlign_ < static_cast<std::size_t>(channels_) * (format_ == FORMAT_PCM ? 2 : 4)) {
+        return false;
+    }
+
+    if (format_ == FORMAT_IMA_ADPCM) {
+        // Each channel has a 4-byte header holding its first sample, then
+        // eight 4-bit samples per 4 bytes
+        std::size_t channels = static_cast<std::size_t>(channels_);
+        std::size_t perChannel = (blockAlign_ / channels - 4) * 2 + 1;
+        block_.assign(perChannel * channels, 0);
+    } else {
+        block_.clear();
+    }
+
+    data_ = data;
+    rewind();
+    return true;
+}
+
+void WavDecoder::rewind() {
+    position_ = 0;
+    blockSamples_ = 0;
+    blockRead_ = 0;
+}
+
+std::size_t WavDecoder::decode(std::span<std::int16_t> out) {
+    if (!isOpen()) {
+        return 0;
+    }
+    std::size_t frameSize = static_cast<std::size_t>(channels_);
+    out = out.first(out.size() / frameSize * frameSize);
+
+    if (format_ == FORMAT_PCM) {
+        return decodePcm(out);
+    }
+
+    std::size_t written = 0;
+    while (written < out.size()) {
+        if (blockRead_ == blockSamples_ && !decodeBlock()) {
+            break;
+        }
+        std::size_t count = std::min(out.size() - written, blockSamples_ - blockRead_);
+        std::copy_n(block_.begin() + static_cast<std::ptrdiff_t>(blockRead_), count, out.begin() + static_cast<std::ptrdiff_t>(written));
+        blockRead_ += count;
+        written += count;
+    }
+    return written;
+}
+
+std::size_t WavDecoder::decodePcm(std::span<std::int16_t> out) {
+    std::size_t channels = static_cast<std::size_t>(channels_);
+    std::size_t frameBytes = channels * 2;
+    std::size_t frames = std::min(out.size() / channels, (data_.size() - position_) / frameBytes);
+    std::size_t count = frames * channels;
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = static_cast<std::int16_t>(read16(data_, position_ + i * 2));
+    }
+    position_ += frames * frameBytes;
+    return count;
+}
+
+bool WavDecoder::decodeBlock() {
+    std::size_t channels = static_cast<std::size_t>(channels_);
+    std::size_t headerBytes = 4 * channels;
+
+    // The last block may be short
+    std::size_t size = std::min(blockAlign_, data_.size() - position_);
+    if (size <= headerBytes) {
+        return false;
+    }
+    std::span<const std::byte> block = data_.subspan(position_, size);
+    position_ += size;
+
+    std::array<ImaChannel, MAX_CHANNELS> state{};
+    for (std::size_t c = 0; c < channels; c++) {
+        state[c].predictor = static_cast<std::int16_t>(read16(block, c * 4));
+        state[c].index = std::clamp(std::to_integer<int>(block[c * 4 + 2]), 0, static_cast<int>(IMA_STEPS.size()) - 1);
+        block_[c] = static_cast<std::int16_t>(state[c].predictor);
+    }
+
+    // After the headers, 4 bytes (8 samples) of each channel in turn
+    std::size_t groups = (size - headerBytes) / headerBytes;
+    for (std::size_t g = 0; g < groups; g++) {
+        for (std::size_t c = 0; c < channels; c++) {
+            std::size_t offset = headerBytes + (g * channels + c) * 4;
+            for (std::size_t b = 0; b < 4; b++) {
+                unsigned byte = std::to_integer<unsigned>(block[offset + b]);
+                std::size_t frame = 1 + g * 8 + b * 2;
+                block_[frame * channels + c] = state[c].decode(byte & 0xF);
+                block_[(frame + 1) * channels + c] = state[c].decode(byte >> 4);
+            }
+        }
+    }
+
+    blockSamples_ = (1 + groups * 8) * channels;
+    blockRead_ = 0;
+    return true;
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "AssetArchive.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+std::vector<std::byte> bytes(const std::string& text) {
+    std::vector<std::byte> data;
+    for (char c : text) {
+        data.push_back(static_cast<std::byte>(c));
+    }
+    return data;
+}
+
+std::string text(std::span<const std::byte> data) {
+    return {reinterpret_cast<const char*>(data.data()), data.size()};
+}
+
+} // namespace
+
+// Test fixture for packing and reading the asset archive
+class AssetArchiveTest : public ::testing::Test {
+protected:
+    std::vector<std::byte> image;
+    AssetArchive archive;
+
+    void SetUp() override {
+        auto packed = AssetArchive::pack({
+            {"sounds/move.wav", AssetArchive::Kind::Pcm, bytes("pcm samples")},
+            {"fonts/Arial.ttf", AssetArchive::Kind::Raw, bytes("font")},
+            {"sounds/drop.wav", AssetArchive::Kind::Pcm, bytes("x")},
+        });
+        ASSERT_TRUE(packed.has_value());
+        image = std::move(*packed);
+    }
+};
+
+TEST_F(AssetArchiveTest, FindsEveryEntry) {
+    ASSERT_TRUE(archive.openMemory(image));
+    EXPECT_EQ(archive.entries().size(), 3U);
+
+    auto font = archive.find("fonts/Arial.ttf");
+    ASSERT_TRUE(font.has_value());
+    EXPECT_EQ(font->kind, AssetArchive::Kind::Raw);
+    EXPECT_EQ(text(font->data), "font");
+
+    auto move = archive.find("sounds/move.wav");
+    ASSERT_TRUE(move.has_value());
+    EXPECT_EQ(move->kind, AssetArchive::Kind::Pcm);
+    EXPECT_EQ(text(move->data), "pcm samples");
+
+    EXPECT_FALSE(archive.find("sounds/missing.wav").has_value());
+}
+
+TEST_F(AssetArchiveTest, DataIsAligned) {
+    ASSERT_TRUE(archive.openMemory(image));
+    for (const auto& entry : archive.entries()) {
+        EXPECT_EQ(entry.offset % AssetArchive::ALIGNMENT, 0U);
+    }
+}
+
+TEST_F(AssetArchiveTest, FindFirstMatchesAPrefix) {
+    ASSERT_TRUE(archive.openMemory(image));
+
+    auto sound = archive.findFirst("sounds/");
+    ASSERT_TRUE(sound.has_value());
+    EXPECT_EQ(sound->name, "sounds/drop.wav");
+    EXPECT_FALSE(archive.findFirst("music/").has_value());
+}
+
+TEST_F(AssetArchiveTest, RejectsDamagedArchives) {
+    std::vector<std::byte> truncated(image.begin(), image.begin() + 20);
+    EXPECT_FALSE(archive.openMemory(truncated));
+
+    std::vector<std::byte> wrongMagic = image;
+    wrongMagic[0] = std::byte{0};
+    EXPECT_FALSE(archive.openMemory(wrongMagic));
+    EXPECT_FALSE(archive.isOpen());
+}
+
+TEST_F(AssetArchiveTest, RejectsLongNames) {
+    std::string name(AssetArchive::NAME_LENGTH, 'a');
+    EXPECT_FALSE(AssetArchive::pack({{name, AssetArchive::Kind::Raw, bytes("x")}}).has_value());
+}
+
+TEST_F(AssetArchiveTest, MapsArchiveFiles) {
+    auto path = std::filesystem::temp_directory_path() / "tetris_asset_archive_test.pak";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    }
+
+    ASSERT_TRUE(archive.open(path.string()));
+    auto font = archive.find("fonts/Arial.ttf");
+    ASSERT_TRUE(font.has_value());
+    EXPECT_EQ(text(font->data), "font");
+
+    archive.close();
+    EXPECT_FALSE(archive.isOpen());
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(archive.open(path.string()));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "AudioLatencyMonitor.h"
+#include "Constants.h"
+#include "SoundManager.h"
+
+using namespace std::chrono_literals;
+
+// Timing the mixer callback with a fake clock
+class AudioLatencyTest : public ::testing::Test {
+protected:
+    static constexpr int RATE = 48000;
+    static constexpr int BYTES_PER_FRAME = 4;  // 16-bit stereo
+    static constexpr int FRAMES = 480;          // 10 ms at 48 kHz
+
+    AudioLatencyMonitor monitor;
+    AudioLatencyMonitor::Clock::time_point now{};
+
+    void SetUp() override {
+        monitor.reset(512, RATE, BYTES_PER_FRAME);
+    }
+
+    void callback(std::chrono::microseconds interval, int frames = FRAMES) {
+        now += interval;
+        monitor.onCallback(now, frames * BYTES_PER_FRAME);
+    }
+};
+
+TEST_F(AudioLatencyTest, ReportsTheRequestedBufferBeforeAnyCallback) {
+    AudioLatencyMonitor::Report report = monitor.report();
+    EXPECT_EQ(report.bufferFrames, 512);
+    EXPECT_EQ(report.callbacks, 0U);
+    EXPECT_FALSE(report.calibrated);
+    EXPECT_NEAR(report.periodMs, 512 * 1000.0 / RATE, 1e-9);
+}
+
+TEST_F(AudioLatencyTest, MeasuresTheCallbackPeriod) {
+    for (std::uint32_t i = 0; i < AUDIO_CALIBRATION_CALLBACKS; i++) {
+        callback(10ms);
+    }
+
+    AudioLatencyMonitor::Report report = monitor.report();
+    EXPECT_TRUE(report.calibrated);
+    EXPECT_EQ(report.framesPerCallback, FRAMES);
+    EXPECT_NEAR(report.periodMs, 10.0, 0.01);
+    EXPECT_NEAR(report.latencyMs, 10.0 * AudioLatencyMonitor::BUFFERED_PERIODS, 0.01);
+    EXPECT_EQ(report.underruns, 0U);
+}
+
+TEST_F(AudioLatencyTest, CountsLateCallbacksAsUnderruns) {
+    for (std::uint32_t i = 0; i < AudioLatencyMonitor::WARMUP_CALLBACKS + 2; i++) {
+        callback(10ms);
+    }
+
+    // Jitter within two periods is normal, anything longer left the device empty
+    callback(19ms);
+    EXPECT_EQ(monitor.underruns(), 0U);
+    callback(35ms);
+    callback(10ms);
+    callback(50ms);
+    EXPECT_EQ(monitor.underruns(), 2U);
+}
+
+TEST_F(AudioLatencyTest, IgnoresTheFirstCallbacks) {
+    // The device starting up is not an underrun
+    callback(100ms);
+    callback(100ms);
+    EXPECT_EQ(monitor.underruns(), 0U);
+}
+
+TEST_F(AudioLatencyTest, ResetStartsOver) {
+    for (int i = 0; i < 10; i++) {
+        callback(60ms);
+    }
+    ASSERT_GT(monitor.underruns(), 0U);
+
+    monitor.reset(1024, RATE, BYTES_PER_FRAME);
+    AudioLatencyMonitor::Report report = monitor.report();
+    EXPECT_EQ(report.bufferFrames, 1024);
+    EXPECT_EQ(report.underruns, 0U);
+    EXPECT_EQ(report.callbacks, 0U);
+}
+
+TEST(AudioBufferTest, TakesValidSettingsOnly) {
+    int defaultFrames = AUDIO_LOW_LATENCY ? AUDIO_LOW_LATENCY_CHUNK_SIZE : AUDIO_CHUNK_SIZE;
+    EXPECT_EQ(SoundManager::requestedBufferFrames(nullptr), defaultFrames);
+    EXPECT_EQ(SoundManager::requestedBufferFrames("256"), 256);
+    EXPECT_EQ(SoundManager::requestedBufferFrames("2048"), 2048);
+    EXPECT_EQ(SoundManager::requestedBufferFrames("300"), defaultFrames);
+    EXPECT_EQ(SoundManager::requestedBufferFrames("128"), defaultFrames);
+    EXPECT_EQ(SoundManager::requestedBufferFrames("8192"), defaultFrames);
+    EXPECT_EQ(SoundManager::requestedBufferFrames("fast"), defaultFrames);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "AutoRepeat.h"
+#include "InputHandler.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+#include <algorithm>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Key = AutoRepeat::Key;
+
+// DAS, ARR and soft drop timing with a fake clock
+class AutoRepeatTest : public ::testing::Test {
+protected:
+    static constexpr auto FALL = 400ms;
+
+    AutoRepeat::Clock::time_point start{};
+
+    AutoRepeat::Clock::time_point at(std::chrono::milliseconds offset) const { return start + offset; }
+
+    // Every action due by `now`
+    static std::vector<AutoRepeat::Action> drain(AutoRepeat& repeat, AutoRepeat::Clock::time_point now) {
+        std::vector<AutoRepeat::Action> actions;
+        while (auto action = repeat.next(now, FALL)) {
+            actions.push_back(*action);
+        }
+        return actions;
+    }
+};
+
+TEST_F(AutoRepeatTest, APressActsOnceAtItsOwnTime) {
+    AutoRepeat repeat({100ms, 20ms, 20});
+    repeat.press(Key::Left, at(5ms));
+
+    EXPECT_TRUE(drain(repeat, at(4ms)).empty());
+    auto actions = drain(repeat, at(50ms));
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_EQ(actions[0].key, Key::Left);
+    EXPECT_EQ(actions[0].at, at(5ms));
+    EXPECT_FALSE(actions[0].repeat);
+}
+
+TEST_F(AutoRepeatTest, ATapReleasedBeforeTheLoopRanStillMoves) {
+    AutoRepeat repeat({100ms, 20ms, 20});
+    repeat.press(Key::Right, at(0ms));
+    repeat.release(Key::Right, at(8ms));
+
+    auto actions = drain(repeat, at(500ms));
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_FALSE(actions[0].repeat);
+}
+
+TEST_F(AutoRepeatTest, RepeatsEveryArrOnceDasHasCharged) {
+    AutoRepeat repeat({100ms, 20ms, 20});
+    repeat.press(Key::Left, at(0ms));
+
+    auto actions = drain(repeat, at(99ms));
+    EXPECT_EQ(actions.size(), 1U);
+    actions = drain(repeat, at(145ms));
+    ASSERT_EQ(actions.size(), 3U);
+    EXPECT_EQ(actions[0].at, at(100ms));
+    EXPECT_EQ(actions[1].at, at(120ms));
+    EXPECT_EQ(actions[2].at, at(140ms));
+    EXPECT_TRUE(actions[0].repeat);
+    EXPECT_FALSE(actions[0].toWall);
+    EXPECT_EQ(repeat.nextDue(FALL), at(160ms));
+
+    repeat.release(Key::Left, at(150ms));
+    EXPECT_TRUE(drain(repeat, at(300ms)).empty());
+    EXPECT_FALSE(repeat.nextDue(FALL).has_value());
+}
+
+TEST_F(AutoRepeatTest, OsRepeatsDoNotRestartDas) {
+    AutoRepeat repeat({100ms, 20ms, 20});
+    repeat.press(Key::Left, at(0ms));
+    drain(repeat, at(10ms));
+    repeat.press(Key::Left, at(60ms));
+
+    auto actions = drain(repeat, at(100ms));
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_EQ(actions[0].at, at(100ms));
+}
+
+TEST_F(AutoRepeatTest, ZeroArrShiftsToTheWallAndStaysThere) {
+    AutoRepeat repeat({100ms, 0ms, 20});
+    repeat.press(Key::Right, at(0ms));
+    drain(repeat, at(0ms));
+    EXPECT_FALSE(repeat.heldAgainstWall().has_value());
+
+    auto actions = drain(repeat, at(500ms));
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_TRUE(actions[0].toWall);
+    EXPECT_EQ(repeat.heldAgainstWall(), Key::Right);
+    EXPECT_FALSE(repeat.nextDue(FALL).has_value());  // Nothing left to wake up for
+
+    repeat.release(Key::Right, at(600ms));
+    EXPECT_FALSE(repeat.heldAgainstWall().has_value());
+}
+
+TEST_F(AutoRepeatTest, TheLastDirectionPressedWins) {
+    AutoRepeat repeat({100ms, 20ms, 20});
+    repeat.press(Key::Left, at(0ms));
+    drain(repeat, at(120ms));
+
+    repeat.press(Key::Right, at(130ms));
+    auto actions = drain(repeat, at(229ms));
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_EQ(actions[0].key, Key::Right);
+    EXPECT_FALSE(actions[0].repeat);
+
+    // Letting go of right charges DAS for the left key still held
+    repeat.release(Key::Right, at(200ms));
+    EXPECT_TRUE(drain(repeat, at(299ms)).empty());
+    actions = drain(repeat, at(300ms));
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_EQ(actions[0].key, Key::Left);
+    EXPECT_TRUE(actions[0].repeat);
+}
+
+TEST_F(AutoRepeatTest, SoftDropRepeatsAtAFractionOfGravity) {
+    AutoRepeat repeat({100ms, 20ms, 20});
+    EXPECT_EQ(repeat.softDropInterval(FALL), 20ms);
+
+    repeat.press(Key::SoftDrop, at(0ms));
+    auto actions = drain(repeat, at(65ms));
+    ASSERT_EQ(actions.size(), 4U);
+    EXPECT_FALSE(actions[0].repeat);
+    EXPECT_EQ(actions[3].at, at(60ms));
+    EXPECT_TRUE(actions[3].repeat);
+}
+
+TEST_F(AutoRepeatTest, ActionsComeOutInTimeOrder) {
+    AutoRepeat repeat({50ms, 30ms, 20});
+    repeat.press(Key::SoftDrop, at(0ms));
+    repeat.press(Key::Left, at(10ms));
+
+    auto actions = drain(repeat, at(100ms));
+    for (std::size_t i = 1; i < actions.size(); i++) {
+        EXPECT_LE(actions[i - 1].at, actions[i].at);
+    }
+}
+
+TEST_F(AutoRepeatTest, AStallSkipsRepeatsInsteadOfReplayingThem) {
+    AutoRepeat repeat({100ms, 10ms, 20});
+    repeat.press(Key::Left, at(0ms));
+
+    auto actions = drain(repeat, at(2000ms));
+    EXPECT_LE(actions.size(), 2U + static_cast<std::size_t>(AUTO_REPEAT_MAX_LAG / 10ms));
+    EXPECT_GE(actions.back().at, at(2000ms) - AUTO_REPEAT_MAX_LAG);
+}
+
+TEST_F(AutoRepeatTest, ReleaseAllForgetsEveryKey) {
+    AutoRepeat repeat;
+    repeat.press(Key::Left, at(0ms));
+    repeat.press(Key::SoftDrop, at(0ms));
+    repeat.releaseAll();
+
+    EXPECT_FALSE(repeat.isHeld(Key::Left));
+    EXPECT_TRUE(drain(repeat, at(1000ms)).empty());
+}
+
+TEST_F(AutoRepeatTest, ReadsSettings) {
+    auto settings = AutoRepeat::settingsFrom("90", "0", "40");
+    EXPECT_EQ(settings.das, 90ms);
+    EXPECT_EQ(settings.arr, 0ms);
+    EXPECT_EQ(settings.softDropFactor, 40);
+
+    auto defaults = AutoRepeat::settingsFrom(nullptr, "fast", "0");
+    EXPECT_EQ(defaults.das, DAS_DELAY);
+    EXPECT_EQ(defaults.arr, ARR_INTERVAL);
+    EXPECT_EQ(defaults.softDropFactor, SOFT_DROP_FACTOR);
+}
+
+TEST_F(AutoRepeatTest, EventTimesComeFromSdlTimestamps) {
+    EXPECT_EQ(InputHandler::eventTime(1000, 1012, at(500ms)), at(488ms));
+    EXPECT_EQ(InputHandler::eventTime(1013, 1012, at(500ms)), at(500ms));
+    EXPECT_EQ(InputHandler::heldKey(SDLK_DOWN), Key::SoftDrop);
+    EXPECT_FALSE(InputHandler::heldKey(SDLK_UP).has_value());
+}
+
+TEST(AutoRepeatGameTest, ATapBeforeAHardDropMovesFirst) {
+    TestGame game;
+    game.startGame();
+    TetrominoManager& manager = game.getTetrominoManager();
+    ASSERT_TRUE(manager.createNewTetromino());
+    int x = manager.getCurrentTetromino()->x();
+
+    // Left tapped, then Space, all within one frame
+    auto now = std::chrono::steady_clock::now();
+    game.autoRepeat().press(Key::Left, now - 10ms);
+    game.autoRepeat().release(Key::Left, now - 8ms);
+    game.applyPendingInput(now - 5ms);
+    EXPECT_EQ(manager.getCurrentTetromino()->x(), x - 1);
+
+    // The piece's leftmost cell lands one column left of where it spawned
+    int firstColumn = TETROMINO_GRID_SIZE;
+    const auto& shape = manager.getCurrentTetromino()->getRotatedShape();
+    for (int row = 0; row < TETROMINO_GRID_SIZE; row++) {
+        for (int column = 0; column < TETROMINO_GRID_SIZE; column++) {
+            if (shape[row][column]) {
+                firstColumn = std::min(firstColumn, column);
+            }
+        }
+    }
+    manager.hardDrop();
+
+    int leftmost = GRID_WIDTH;
+    for (const auto& row : game.getGrid()) {
+        for (int column = 0; column < GRID_WIDTH; column++) {
+            if (row[column]) {
+                leftmost = std::min(leftmost, column);
+            }
+        }
+    }
+    EXPECT_EQ(leftmost, x - 1 + firstColumn);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "BlockAtlas.h"
+#include "Color.h"
+
+// Test fixture for the block sprite atlas
+class BlockAtlasTest : public ::testing::Test {
+protected:
+    // RGBA of one atlas pixel inside a sprite
+    static std::array<std::uint8_t, 4> pixel(const std::vector<std::uint8_t>& pixels, int sprite, int x, int y) {
+        SDL_Rect rect = BlockAtlas::spriteRect(sprite);
+        std::size_t offset = (static_cast<std::size_t>(y) * BlockAtlas::ATLAS_WIDTH + rect.x + x) * BlockAtlas::BYTES_PER_PIXEL;
+        return {pixels[offset], pixels[offset + 1], pixels[offset + 2], pixels[offset + 3]};
+    }
+
+    BlockAtlas atlas;
+};
+
+TEST_F(BlockAtlasTest, BlockSpritesHaveDarkerBorder) {
+    auto pixels = BlockAtlas::renderPixels();
+    const Color& red = COLORS[static_cast<std::size_t>(TetrominoType::Z)];
+    int sprite = BlockAtlas::blockSprite(TetrominoType::Z);
+
+    auto inside = pixel(pixels, sprite, BlockAtlas::SPRITE_SIZE / 2, BlockAtlas::SPRITE_SIZE / 2);
+    EXPECT_EQ(inside[0], red.r);
+    EXPECT_EQ(inside[3], ALPHA_OPAQUE);
+
+    auto border = pixel(pixels, sprite, 0, BlockAtlas::SPRITE_SIZE - 1);
+    EXPECT_EQ(border[0], red.r / HALF);
+}
+
+TEST_F(BlockAtlasTest, OutlineSpritesAreHollow) {
+    auto pixels = BlockAtlas::renderPixels();
+    for (int sprite : {BlockAtlas::EMPTY_CELL_SPRITE, BlockAtlas::GHOST_SPRITE}) {
+        EXPECT_EQ(pixel(pixels, sprite, 0, 0)[3], ALPHA_OPAQUE);
+        EXPECT_EQ(pixel(pixels, sprite, BlockAtlas::SPRITE_SIZE / 2, BlockAtlas::SPRITE_SIZE / 2)[3], 0);
+    }
+}
+
+TEST_F(BlockAtlasTest, SpritesDoNotOverlap) {
+    for (int sprite = 1; sprite < BlockAtlas::SPRITE_COUNT; sprite++) {
+        SDL_Rect previous = BlockAtlas::spriteRect(sprite - 1);
+        EXPECT_LT(previous.x + previous.w, BlockAtlas::spriteRect(sprite).x);
+    }
+    SDL_Rect last = BlockAtlas::spriteRect(BlockAtlas::SPRITE_COUNT - 1);
+    EXPECT_LE(last.x + last.w, BlockAtlas::ATLAS_WIDTH);
+}
+
+TEST_F(BlockAtlasTest, FullBoardIsOneBatch) {
+    for (int y = 0; y < GRID_HEIGHT; y++) {
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            atlas.add((x + y) % BlockAtlas::SPRITE_COUNT, x * BLOCK_SIZE, y * BLOCK_SIZE);
+        }
+    }
+    atlas.buildGeometry();
+
+    EXPECT_EQ(atlas.queued(), static_cast<std::size_t>(GRID_WIDTH * GRID_HEIGHT));
+    EXPECT_EQ(atlas.vertices().size(), atlas.queued() * 4);
+    EXPECT_EQ(atlas.indices().size(), atlas.queued() * 6);
+}
+
+TEST_F(BlockAtlasTest, QuadUsesSpriteAndTint) {
+    SDL_Color tint = {10, 20, 30, ALPHA_GHOST_PIECE};
+    atlas.add(BlockAtlas::GHOST_SPRITE, 60, 90, tint);
+    atlas.buildGeometry();
+
+    ASSERT_EQ(atlas.vertices().size(), 4U);
+    const SDL_Vertex& topLeft = atlas.vertices()[0];
+    const SDL_Vertex& bottomRight = atlas.vertices()[2];
+    EXPECT_FLOAT_EQ(topLeft.position.x, 60.0f);
+    EXPECT_FLOAT_EQ(bottomRight.position.y, 90.0f + BlockAtlas::SPRITE_SIZE);
+    EXPECT_FLOAT_EQ(topLeft.tex_coord.x,
+                    static_cast<float>(BlockAtlas::spriteRect(BlockAtlas::GHOST_SPRITE).x) / BlockAtlas::ATLAS_WIDTH);
+    EXPECT_EQ(topLeft.color.a, ALPHA_GHOST_PIECE);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "BoardLayer.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+
+// Game whose grid can be filled directly
+class BoardGame : public TestGame {
+public:
+    void fillRow(int y) {
+        for (auto& cell : grid_[y]) {
+            cell = TetrominoType::O;
+        }
+    }
+};
+
+// Test fixture for the cached board layer and the version that drives it
+class BoardLayerTest : public ::testing::Test {
+protected:
+    BoardGame game;
+};
+
+TEST_F(BoardLayerTest, WithoutRendererDrawsEveryFrame) {
+    BoardLayer layer(nullptr);
+    int redraws = 0;
+
+    layer.draw(1, [&]() { redraws++; });
+    layer.draw(1, [&]() { redraws++; });
+
+    EXPECT_EQ(redraws, 2);
+    EXPECT_FALSE(layer.isCached());
+    EXPECT_EQ(layer.getRedrawCount(), 0U);
+}
+
+TEST_F(BoardLayerTest, InvalidateForcesRedraw) {
+    BoardLayer layer(nullptr);
+    EXPECT_TRUE(layer.needsRedraw(0));
+
+    layer.invalidate();
+    EXPECT_TRUE(layer.needsRedraw(0));
+}
+
+TEST_F(BoardLayerTest, LockingPieceChangesBoardVersion) {
+    game.startGame();
+    std::uint64_t before = game.getBoardVersion();
+
+    game.getTetrominoManager().lockTetromino();
+
+    EXPECT_GT(game.getBoardVersion(), before);
+}
+
+TEST_F(BoardLayerTest, ClearingLinesChangesBoardVersion) {
+    game.startGame();
+    game.fillRow(GRID_HEIGHT - 1);
+    std::uint64_t before = game.getBoardVersion();
+
+    game.getTetrominoManager().clearLines();
+
+    EXPECT_GT(game.getBoardVersion(), before);
+}
+
+TEST_F(BoardLayerTest, NothingToClearKeepsBoardVersion) {
+    game.startGame();
+    std::uint64_t before = game.getBoardVersion();
+
+    game.getTetrominoManager().clearLines();
+
+    EXPECT_EQ(game.getBoardVersion(), before);
+}
+
+TEST_F(BoardLayerTest, ResetChangesBoardVersion) {
+    std::uint64_t before = game.getBoardVersion();
+    game.resetGame();
+    EXPECT_GT(game.getBoardVersion(), before);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
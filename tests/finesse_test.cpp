@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "Finesse.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+#include <memory>
+
+// Test fixture for finesse sequences and fault counting
+class FinesseTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        game = std::make_unique<TestGame>();
+    }
+    
+    std::unique_ptr<TestGame> game;
+};
+
+TEST_F(FinesseTest, SpawnPlacementNeedsOnlyHardDrop) {
+    Tetromino spawn = TetrominoManager::spawnTetromino(TetrominoType::T);
+    const FinesseSequence& sequence = Finesse::emptyBoardSequence(TetrominoType::T, 0, spawn.x());
+    
+    ASSERT_EQ(sequence.length, 1);
+    EXPECT_EQ(sequence.inputs[0], FinesseInput::HardDrop);
+    EXPECT_EQ(sequence.movementCount(), 0);
+}
+
+TEST_F(FinesseTest, LeftWallTakesOneShift) {
+    const FinesseSequence& sequence = Finesse::emptyBoardSequence(TetrominoType::T, 0, 0);
+    ASSERT_EQ(sequence.length, 2);
+    EXPECT_EQ(sequence.inputs[0], FinesseInput::DasLeft);
+    EXPECT_EQ(sequence.movementCount(), 1);
+}
+
+TEST_F(FinesseTest, OneColumnIsATap) {
+    Tetromino spawn = TetrominoManager::spawnTetromino(TetrominoType::T);
+    const FinesseSequence& sequence = Finesse::emptyBoardSequence(TetrominoType::T, 0, spawn.x() + 1);
+    ASSERT_EQ(sequence.length, 2);
+    EXPECT_EQ(sequence.inputs[0], FinesseInput::MoveRight);
+}
+
+TEST_F(FinesseTest, EveryTableEntryReachesItsPlacement) {
+    Board empty;
+    for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+        auto pieceType = static_cast<TetrominoType>(type);
+        for (const Placement& placement : PlacementGenerator::generate(empty, pieceType)) {
+            const FinesseSequence& sequence = Finesse::emptyBoardSequence(pieceType, placement.rotation, placement.x);
+            ASSERT_GT(sequence.length, 0);
+            
+            auto reached = Finesse::simulate(empty, pieceType, sequence);
+            ASSERT_TRUE(reached.has_value());
+            
+            // Same cells, possibly via an equivalent rotation
+            Board expected = empty;
+            expected.place(pieceMask(pieceType, placement.rotation), placement.x, placement.y);
+            Board actual = empty;
+            actual.place(pieceMask(pieceType, reached->rotation), reached->x, reached->y);
+            EXPECT_EQ(actual, expected);
+        }
+    }
+}
+
+TEST_F(FinesseTest, SearchFindsTuckUnderOverhang) {
+    // Roof over the two leftmost columns, open on the right
+    Board board;
+    for (int x = 0; x < 3; x++) {
+        board.setOccupied(x, GRID_HEIGHT - 3);
+    }
+    
+    // O piece resting on the floor under the roof
+    const PieceMask& mask = pieceMask(TetrominoType::O, 0);
+    Placement target{TetrominoType::O, 0, -mask.minX, GRID_HEIGHT - 1 - mask.bottom};
+    ASSERT_TRUE(board.fits(mask, target.x, target.y));
+    
+    auto sequence = Finesse::sequenceFor(board, target);
+    ASSERT_TRUE(sequence.has_value());
+    
+    bool usesSoftDrop = false;
+    for (int i = 0; i < sequence->length; i++) {
+        usesSoftDrop |= sequence->inputs[i] == FinesseInput::SoftDrop;
+    }
+    EXPECT_TRUE(usesSoftDrop);
+    auto reached = Finesse::simulate(board, TetrominoType::O, *sequence);
+    ASSERT_TRUE(reached.has_value());
+    Board expected = board;
+    expected.place(mask, target.x, target.y);
+    Board actual = board;
+    actual.place(pieceMask(TetrominoType::O, reached->rotation), reached->x, reached->y);
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(FinesseTest, WastedInputsCountAsFault) {
+    game->startGame();
+    TetrominoManager& manager = game->getTetrominoManager();
+    
+    // Right then left ends where the piece started, which needs no moves at all
+    manager.moveTetromino(MOVE_RIGHT, NO_MOVE);
+    manager.moveTetromino(MOVE_LEFT, NO_MOVE);
+    manager.hardDrop();
+    EXPECT_EQ(game->getFinesseFaults(), 1);
+    
+    manager.hardDrop();
+    EXPECT_EQ(game->getFinesseFaults(), 1);
+    
+    game->resetGame();
+    EXPECT_EQ(game->getFinesseFaults(), 0);
+}
+
+TEST_F(FinesseTest, HeldShiftToTheWallIsOneInput) {
+    game->startGame();
+    TetrominoManager& manager = game->getTetrominoManager();
+    
+    // A press, its DAS repeats, then presses that only hit the wall
+    manager.moveTetromino(MOVE_LEFT, NO_MOVE);
+    manager.shiftTetromino(MOVE_LEFT, GRID_WIDTH);
+    manager.moveTetromino(MOVE_LEFT, NO_MOVE);
+    manager.moveTetromino(MOVE_LEFT, NO_MOVE);
+    manager.hardDrop();
+    EXPECT_EQ(game->getFinesseFaults(), 0);
+}
+
+TEST_F(FinesseTest, TappingToTheWallIsAFault) {
+    game->startGame();
+    TetrominoManager& manager = game->getTetrominoManager();
+    
+    int taps = 0;
+    while (manager.moveTetromino(MOVE_LEFT, NO_MOVE)) {
+        taps++;
+    }
+    manager.hardDrop();
+    EXPECT_EQ(game->getFinesseFaults(), taps > 1 ? 1 : 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "FontManager.h"
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// FontManager that pretends files named "missing*" do not exist
+class MockFontManager : public FontManager {
+public:
+    ~MockFontManager() override { closeAll(); }
+
+    std::vector<std::pair<std::string, int>> opened;
+    std::vector<int> openedFromMemory;
+    int closed = 0;
+
+protected:
+    TTF_Font* openFont(const std::string& path, int size) override {
+        opened.emplace_back(path, size);
+        if (path.starts_with("missing")) {
+            return nullptr;
+        }
+        return reinterpret_cast<TTF_Font*>(static_cast<std::uintptr_t>(opened.size()));
+    }
+
+    TTF_Font* openFontMemory(std::span<const std::byte> data, int size) override {
+        openedFromMemory.push_back(size);
+        if (data.empty()) {
+            return nullptr;
+        }
+        return reinterpret_cast<TTF_Font*>(static_cast<std::uintptr_t>(100 + openedFromMemory.size()));
+    }
+
+    void closeFont(TTF_Font*) override { closed++; }
+};
+
+// Test fixture for font loading and caching
+class FontManagerTest : public ::testing::Test {
+protected:
+    MockFontManager fonts;
+};
+
+TEST_F(FontManagerTest, ResolvesFirstFontThatOpens) {
+    std::array<const char*, 3> candidates = {"missing.ttf", "found.ttf", "other.ttf"};
+
+    ASSERT_TRUE(fonts.resolve(candidates, 24));
+    EXPECT_EQ(fonts.getPath(), "found.ttf");
+    EXPECT_EQ(fonts.opened.size(), 2U);
+}
+
+TEST_F(FontManagerTest, EachSizeIsOpenedOnce) {
+    std::array<const char*, 1> candidates = {"found.ttf"};
+    ASSERT_TRUE(fonts.resolve(candidates, 24));
+
+    TTF_Font* large = fonts.get(48);
+    for (int frame = 0; frame < 60; frame++) {
+        EXPECT_EQ(fonts.get(48), large);
+        EXPECT_NE(fonts.get(24), nullptr);
+    }
+
+    EXPECT_EQ(fonts.opened.size(), 2U);
+    EXPECT_EQ(fonts.openCount(), 2U);
+}
+
+TEST_F(FontManagerTest, FailedOpenIsNotRetried) {
+    EXPECT_EQ(fonts.get("missing.ttf", 48), nullptr);
+    EXPECT_EQ(fonts.get("missing.ttf", 48), nullptr);
+
+    EXPECT_EQ(fonts.opened.size(), 1U);
+    EXPECT_EQ(fonts.openCount(), 0U);
+}
+
+TEST_F(FontManagerTest, UnresolvedManagerHasNoFonts) {
+    std::array<const char*, 1> candidates = {"missing.ttf"};
+
+    EXPECT_FALSE(fonts.resolve(candidates, 24));
+    EXPECT_FALSE(fonts.isResolved());
+    EXPECT_EQ(fonts.get(24), nullptr);
+}
+
+TEST_F(FontManagerTest, CloseAllClosesOpenFonts) {
+    fonts.get("a.ttf", 24);
+    fonts.get("a.ttf", 48);
+    fonts.get("missing.ttf", 24);
+    fonts.closeAll();
+
+    EXPECT_EQ(fonts.closed, 2);
+    EXPECT_EQ(fonts.openCount(), 0U);
+}
+
+TEST_F(FontManagerTest, MemoryFaceServesEverySize) {
+    std::array<std::byte, 4> face{};
+    ASSERT_TRUE(fonts.resolveMemory("fonts/Arial.ttf", face, 24));
+    EXPECT_EQ(fonts.getPath(), "fonts/Arial.ttf");
+    EXPECT_NE(fonts.get(48), nullptr);
+
+    EXPECT_EQ(fonts.openedFromMemory, (std::vector<int>{24, 48}));
+    EXPECT_TRUE(fonts.opened.empty());
+}
+
+// Font resolution remembered between runs
+class FontCacheTest : public FontManagerTest {
+protected:
+    std::string cacheFile = (std::filesystem::temp_directory_path() / "tetris_font_cache_test.txt").string();
+
+    void SetUp() override { std::filesystem::remove(cacheFile); }
+    void TearDown() override { std::filesystem::remove(cacheFile); }
+
+    std::string cachedPath() const {
+        std::string path;
+        std::ifstream in(cacheFile);
+        std::getline(in, path);
+        return path;
+    }
+};
+
+TEST_F(FontCacheTest, SecondRunSkipsProbing) {
+    std::array<const char*, 3> candidates = {"missing.ttf", "missing2.ttf", "found.ttf"};
+    ASSERT_TRUE(fonts.resolve(candidates, 24, cacheFile));
+    EXPECT_EQ(cachedPath(), "found.ttf");
+
+    MockFontManager nextRun;
+    ASSERT_TRUE(nextRun.resolve(candidates, 24, cacheFile));
+    EXPECT_EQ(nextRun.getPath(), "found.ttf");
+    EXPECT_EQ(nextRun.opened.size(), 1U);
+}
+
+TEST_F(FontCacheTest, StaleEntryFallsBackToCandidates) {
+    std::ofstream(cacheFile) << "missing-old.ttf\n";
+
+    std::array<const char*, 2> candidates = {"missing.ttf", "found.ttf"};
+    ASSERT_TRUE(fonts.resolve(candidates, 24, cacheFile));
+    EXPECT_EQ(fonts.getPath(), "found.ttf");
+    EXPECT_EQ(cachedPath(), "found.ttf");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
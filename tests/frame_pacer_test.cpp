@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "FramePacer.h"
+#include "FrameStats.h"
+
+using namespace std::chrono_literals;
+
+// Pacer on a manual clock, records how it waited
+class FakePacer : public FramePacer {
+public:
+    using FramePacer::FramePacer;
+
+    void advance(Clock::duration duration) { time_ += duration; }
+
+    Clock::time_point time_{};
+    Clock::duration slept_{};
+    bool spun_ = false;
+
+protected:
+    Clock::time_point now() const override { return time_; }
+
+    void sleepFor(Clock::duration duration) override {
+        slept_ += duration;
+        time_ += duration;
+    }
+
+    void spinUntil(Clock::time_point deadline) override {
+        spun_ = true;
+        time_ = std::max(time_, deadline);
+    }
+};
+
+// Test fixture for frame pacing and frame time statistics
+class FramePacerTest : public ::testing::Test {
+protected:
+    FakePacer pacer{144};
+};
+
+TEST_F(FramePacerTest, IntervalFollowsRefreshRate) {
+    EXPECT_EQ(pacer.frameInterval(), std::chrono::nanoseconds(1'000'000'000 / 144));
+
+    pacer.setRefreshRate(0);
+    EXPECT_EQ(pacer.getRefreshRate(), FramePacer::DEFAULT_REFRESH_RATE);
+}
+
+TEST_F(FramePacerTest, SleepsThenSpinsToNextSlot) {
+    pacer.framePresented();
+    FramePacer::Clock::time_point first = pacer.time_;
+    pacer.advance(1ms);
+
+    pacer.waitForNextFrame();
+
+    EXPECT_EQ(pacer.time_, first + pacer.frameInterval());
+    EXPECT_EQ(pacer.slept_, pacer.frameInterval() - 1ms - FramePacer::SPIN_MARGIN);
+    EXPECT_TRUE(pacer.spun_);
+}
+
+TEST_F(FramePacerTest, LateFrameDoesNotWait) {
+    pacer.framePresented();
+    pacer.advance(10ms);
+
+    pacer.waitForNextFrame();
+
+    EXPECT_EQ(pacer.slept_, FramePacer::Clock::duration::zero());
+    EXPECT_FALSE(pacer.spun_);
+}
+
+TEST_F(FramePacerTest, VSyncLeavesWaitingToPresent) {
+    pacer.setVSync(true);
+    pacer.framePresented();
+
+    pacer.waitForNextFrame();
+
+    EXPECT_FALSE(pacer.spun_);
+}
+
+TEST_F(FramePacerTest, RecordsFrameTimesButNotIdleGaps) {
+    pacer.framePresented();
+    for (int i = 0; i < 3; i++) {
+        pacer.waitForNextFrame();
+        pacer.framePresented();
+    }
+    pacer.advance(1s);
+    pacer.framePresented();
+
+    EXPECT_EQ(pacer.stats().size(), 3U);
+    EXPECT_EQ(pacer.stats().max(), pacer.frameInterval());
+}
+
+TEST(FrameStatsTest, PercentilesAndVariance) {
+    FrameStats stats;
+    for (int i = 1; i <= 100; i++) {
+        stats.add(std::chrono::milliseconds(i));
+    }
+
+    EXPECT_EQ(stats.percentile(50), 50ms);
+    EXPECT_EQ(stats.percentile(99), 99ms);
+    EXPECT_EQ(stats.percentile(100), 100ms);
+    EXPECT_NEAR(stats.variance(), 841.67, 0.01);
+}
+
+TEST(FrameStatsTest, KeepsOnlyTheMostRecentWindow) {
+    FrameStats stats;
+    for (std::size_t i = 0; i < FrameStats::CAPACITY; i++) {
+        stats.add(100ms);
+    }
+    for (std::size_t i = 0; i < FrameStats::CAPACITY; i++) {
+        stats.add(1ms);
+    }
+
+    EXPECT_EQ(stats.size(), FrameStats::CAPACITY);
+    EXPECT_EQ(stats.max(), 1ms);
+    EXPECT_EQ(stats.last(), 1ms);
+    EXPECT_DOUBLE_EQ(stats.variance(), 0.0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "FrameProfiler.h"
+
+using namespace std::chrono_literals;
+
+// Test fixture for the per-phase frame timings behind the HUD
+class FrameProfilerTest : public ::testing::Test {
+protected:
+    FrameProfiler profiler;
+};
+
+TEST_F(FrameProfilerTest, PhasesAreRecordedSeparately) {
+    for (int i = 1; i <= 100; i++) {
+        profiler.record(FramePhase::Board, std::chrono::microseconds(i));
+    }
+    profiler.record(FramePhase::Present, 4ms);
+
+    EXPECT_EQ(profiler.phase(FramePhase::Board).size(), 100U);
+    EXPECT_EQ(profiler.phase(FramePhase::Board).percentile(95), 95us);
+    EXPECT_EQ(profiler.phase(FramePhase::Present).percentile(50), 4ms);
+    EXPECT_TRUE(profiler.phase(FramePhase::Input).empty());
+}
+
+TEST_F(FrameProfilerTest, ScopeRecordsOnExit) {
+    {
+        auto scope = profiler.measure(FramePhase::Update);
+        EXPECT_TRUE(profiler.phase(FramePhase::Update).empty());
+    }
+    EXPECT_EQ(profiler.phase(FramePhase::Update).size(), 1U);
+}
+
+TEST_F(FrameProfilerTest, RingDoesNotGrow) {
+    for (std::size_t i = 0; i < FrameStats::CAPACITY * 3; i++) {
+        profiler.record(FramePhase::Sidebar, 1us);
+    }
+    EXPECT_EQ(profiler.phase(FramePhase::Sidebar).size(), FrameStats::CAPACITY);
+}
+
+TEST_F(FrameProfilerTest, EveryPhaseHasAName) {
+    for (std::size_t i = 0; i < FrameProfiler::PHASE_COUNT; i++) {
+        EXPECT_STRNE(FrameProfiler::phaseName(static_cast<FramePhase>(i)), "?");
+    }
+}
+
+TEST_F(FrameProfilerTest, KeepsLastFrameCounts) {
+    profiler.setFrameCounts(12, 1);
+    EXPECT_EQ(profiler.getDrawCalls(), 12);
+    EXPECT_EQ(profiler.getTextureUploads(), 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -176,6 +176,56 @@ TEST_F(CollisionDetectionTest, TetrominoCollisionAtBoundaries) {
     EXPECT_TRUE(game->isPositionFree(0, 0));
 }
 
+// Tests for the render-on-change main loop
+class FrameScheduleTest : public ::testing::Test {
+protected:
+    TestGame game;
+};
+
+TEST_F(FrameScheduleTest, PlayingWaitsUntilNextGravityStep) {
+    using namespace std::chrono;
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Playing, milliseconds(120), 0, false), 120);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Playing, microseconds(120100), 0, false), 121);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Playing, milliseconds(-5), 0, false), 0);
+}
+
+TEST_F(FrameScheduleTest, StartScreenWaitsUntilBlinkToggles) {
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::StartScreen, {}, 0, false), 500);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::StartScreen, {}, 1499, false), 1);
+    EXPECT_NE(GameRenderer::blinkOn(499), GameRenderer::blinkOn(500));
+}
+
+TEST_F(FrameScheduleTest, PausedAndGameOverWaitForInput) {
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Paused, {}, 0, false), WAIT_FOREVER);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::GameOver, {}, 0, false), WAIT_FOREVER);
+}
+
+TEST_F(FrameScheduleTest, OpenHudCapsTheWait) {
+    using namespace std::chrono;
+    int refresh = static_cast<int>(milliseconds(HUD_REFRESH_INTERVAL).count());
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Paused, {}, 0, true), refresh);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::GameOver, {}, 0, true), refresh);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Playing, seconds(10), 0, true), refresh);
+    EXPECT_EQ(Game::eventWaitTimeout(GameState::Playing, milliseconds(5), 0, true), 5);
+}
+
+TEST_F(FrameScheduleTest, FrameKeyChangesOnlyWithVisibleState) {
+    game.startGame();
+    FrameKey before = GameRenderer::frameKey(game, game.getTetrominoManager(), 0);
+    
+    // Time alone does not change a playing frame
+    EXPECT_EQ(GameRenderer::frameKey(game, game.getTetrominoManager(), 250), before);
+    
+    game.getTetrominoManager().moveTetromino(NO_MOVE, MOVE_DOWN);
+    EXPECT_NE(GameRenderer::frameKey(game, game.getTetrominoManager(), 0), before);
+}
+
+TEST_F(FrameScheduleTest, StartScreenFrameFollowsBlink) {
+    FrameKey visible = GameRenderer::frameKey(game, game.getTetrominoManager(), 0);
+    EXPECT_NE(GameRenderer::frameKey(game, game.getTetrominoManager(), 500), visible);
+    EXPECT_EQ(GameRenderer::frameKey(game, game.getTetrominoManager(), 1000), visible);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
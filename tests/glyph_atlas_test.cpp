@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "GlyphAtlas.h"
+
+// Atlas with hand-made metrics: every glyph is 8x16 with an advance of 10
+class TestGlyphAtlas : public GlyphAtlas {
+public:
+    static constexpr int WIDTH = 8;
+    static constexpr int HEIGHT = 16;
+    static constexpr int ADVANCE = 10;
+
+    TestGlyphAtlas() {
+        setAtlasSize(256, 64);
+        int x = 0;
+        for (char32_t codepoint : {U'A', U'V', U'1', U'2', U' ', U'\u2190'}) {
+            setGlyph(codepoint, {{x, 0, WIDTH, HEIGHT}, ADVANCE, true});
+            x += WIDTH;
+        }
+        setKerning(U'A', U'V', -2);
+    }
+};
+
+// Test fixture for glyph atlas layout
+class GlyphAtlasTest : public ::testing::Test {
+protected:
+    TestGlyphAtlas atlas;
+    SDL_Color color = {200, 200, 200, 255};
+};
+
+TEST_F(GlyphAtlasTest, IndexCoversAsciiAndArrows) {
+    EXPECT_EQ(GlyphAtlas::glyphIndex(U' '), 0);
+    EXPECT_TRUE(GlyphAtlas::glyphIndex(U'~').has_value());
+    EXPECT_TRUE(GlyphAtlas::glyphIndex(U'\u2193').has_value());
+    EXPECT_EQ(GlyphAtlas::glyphIndex(U'\u2193'), GlyphAtlas::GLYPH_COUNT - 1);
+    EXPECT_FALSE(GlyphAtlas::glyphIndex(U'\n').has_value());
+    EXPECT_FALSE(GlyphAtlas::glyphIndex(U'\u00e9').has_value());
+}
+
+TEST_F(GlyphAtlasTest, LayoutEmitsOneQuadPerGlyph) {
+    int width = atlas.layout("12 1", 100, 50, color);
+
+    EXPECT_EQ(width, 4 * TestGlyphAtlas::ADVANCE);
+    ASSERT_EQ(atlas.vertices().size(), 4U * GlyphAtlas::VERTICES_PER_GLYPH);
+    ASSERT_EQ(atlas.indices().size(), 4U * GlyphAtlas::INDICES_PER_GLYPH);
+
+    // Second glyph starts one advance to the right
+    const SDL_Vertex& topLeft = atlas.vertices()[GlyphAtlas::VERTICES_PER_GLYPH];
+    EXPECT_FLOAT_EQ(topLeft.position.x, 100.0f + TestGlyphAtlas::ADVANCE);
+    EXPECT_FLOAT_EQ(topLeft.position.y, 50.0f);
+    EXPECT_EQ(topLeft.color.r, color.r);
+
+    const SDL_Vertex& bottomRight = atlas.vertices()[2];
+    EXPECT_FLOAT_EQ(bottomRight.position.x, 100.0f + TestGlyphAtlas::WIDTH);
+    EXPECT_FLOAT_EQ(bottomRight.position.y, 50.0f + TestGlyphAtlas::HEIGHT);
+}
+
+TEST_F(GlyphAtlasTest, KerningPullsPairsTogether) {
+    EXPECT_EQ(atlas.layout("AV", 0, 0, color), 2 * TestGlyphAtlas::ADVANCE - 2);
+    EXPECT_EQ(atlas.layout("VA", 0, 0, color), 2 * TestGlyphAtlas::ADVANCE);
+}
+
+TEST_F(GlyphAtlasTest, DecodesUtf8AndSkipsMissingGlyphs) {
+    // The arrow is three bytes of UTF-8, 'B' has no glyph in this atlas
+    EXPECT_EQ(atlas.layout("\u2190B1", 0, 0, color), 2 * TestGlyphAtlas::ADVANCE);
+    EXPECT_EQ(atlas.vertices().size(), 2U * GlyphAtlas::VERTICES_PER_GLYPH);
+}
+
+TEST_F(GlyphAtlasTest, TextureCoordinatesAreNormalised) {
+    atlas.layout("V", 0, 0, color);
+    const SDL_Vertex& topLeft = atlas.vertices()[0];
+    EXPECT_FLOAT_EQ(topLeft.tex_coord.x, 8.0f / 256.0f);
+    EXPECT_FLOAT_EQ(topLeft.tex_coord.y, 0.0f);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
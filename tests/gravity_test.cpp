@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "Gravity.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+
+static_assert(Gravity::rowsPerTick(INITIAL_LEVEL) == Gravity::ONE_ROW / SIMULATION_RATE);
+static_assert(Gravity::rowsPerTick(MAX_LEVEL) == Gravity::TWENTY_G);
+static_assert(Gravity::rowsPerTick(MAX_LEVEL + 5) == Gravity::TWENTY_G);
+
+TEST(GravityTest, GetsFasterEveryLevel) {
+    for (int level = INITIAL_LEVEL + 1; level <= MAX_LEVEL; level++) {
+        EXPECT_GE(Gravity::rowsPerTick(level), Gravity::rowsPerTick(level - 1)) << "level " << level;
+    }
+    EXPECT_EQ(Gravity::rowsPerTick(19), Gravity::TWENTY_G);
+    EXPECT_LT(Gravity::rowsPerTick(18), Gravity::TWENTY_G);
+}
+
+TEST(GravityTest, LevelOneFallsARowASecond) {
+    Gravity gravity;
+    int rows = 0;
+    for (int tick = 0; tick < SIMULATION_RATE * 3; tick++) {
+        rows += gravity.step(INITIAL_LEVEL);
+    }
+    EXPECT_EQ(rows, 2);  // The fraction lost to fixed point leaves the third row a tick short
+    EXPECT_EQ(gravity.ticksUntilRow(INITIAL_LEVEL), 1);
+    EXPECT_NEAR(std::chrono::duration<double>(Gravity::rowInterval(INITIAL_LEVEL)).count(), 1.0, 0.001);
+}
+
+TEST(GravityTest, FallsSeveralRowsPerTickAtHighLevels) {
+    Gravity gravity;
+    int rows = 0;
+    for (int tick = 0; tick < 10; tick++) {
+        rows += gravity.step(17);
+    }
+    EXPECT_EQ(rows, static_cast<int>(10 * Gravity::rowsPerTick(17) >> Gravity::FRACTION_BITS));
+    EXPECT_GT(rows, 10 * 6);
+}
+
+TEST(GravityTest, TwentyGDropsTheWholeBoardEachTick) {
+    Gravity gravity;
+    EXPECT_EQ(gravity.step(MAX_LEVEL), GRID_HEIGHT);
+    EXPECT_EQ(gravity.ticksUntilRow(MAX_LEVEL), 1);
+}
+
+TEST(GravityTest, ResetDropsTheFraction) {
+    Gravity gravity;
+    for (int tick = 0; tick < 30; tick++) {
+        gravity.step(INITIAL_LEVEL);
+    }
+    EXPECT_EQ(gravity.ticksUntilRow(INITIAL_LEVEL), 31);
+    gravity.reset();
+    EXPECT_EQ(gravity.ticksUntilRow(INITIAL_LEVEL), SIMULATION_RATE + 1);
+}
+
+// Drop distance on a real TetrominoManager
+class DropDistanceTest : public ::testing::Test {
+protected:
+    std::unique_ptr<TestGame> game = std::make_unique<TestGame>();
+    TetrominoManager manager{*game};
+};
+
+TEST_F(DropDistanceTest, MatchesStepByStepFalling) {
+    manager.createNewTetromino();
+    int distance = manager.dropDistance();
+    EXPECT_GT(distance, 0);
+
+    EXPECT_EQ(manager.dropTetromino(3), 3);
+    EXPECT_EQ(manager.dropDistance(), distance - 3);
+
+    // 20G lands the piece exactly and no further
+    EXPECT_EQ(manager.dropTetromino(GRID_HEIGHT), distance - 3);
+    EXPECT_EQ(manager.dropDistance(), 0);
+    EXPECT_FALSE(manager.moveTetromino(NO_MOVE, MOVE_DOWN));
+    EXPECT_EQ(manager.dropTetromino(1), 0);
+}
+
+TEST_F(DropDistanceTest, FollowsSidewaysMoves) {
+    manager.createNewTetromino();
+    int before = manager.dropDistance();
+    manager.moveTetromino(MOVE_RIGHT, NO_MOVE);
+
+    int after = manager.dropDistance();
+    int expected = 0;
+    while (manager.moveTetromino(NO_MOVE, MOVE_DOWN)) {
+        expected++;
+    }
+    EXPECT_EQ(after, expected);
+    EXPECT_EQ(before, after);  // Empty board: the floor is the same distance everywhere
+}
+
+TEST_F(DropDistanceTest, EveryNewPieceStartsWithoutAFraction) {
+    manager.createNewTetromino();
+    for (int tick = 0; tick < 30; tick++) {
+        game->getGravity().step(INITIAL_LEVEL);
+    }
+
+    // A hard drop locks without gravity's lock path
+    manager.hardDrop();
+    EXPECT_EQ(game->getGravity().ticksUntilRow(INITIAL_LEVEL), Gravity{}.ticksUntilRow(INITIAL_LEVEL));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
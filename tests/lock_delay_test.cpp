@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "LockDelay.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+
+// The lock delay state machine on its own
+class LockDelayTest : public ::testing::Test {
+protected:
+    LockDelay delay;
+
+    void SetUp() override {
+        delay.reset(0);
+    }
+
+    // Grounded ticks until tick() asks for a lock
+    int ticksToLock() {
+        for (int ticks = 1; ticks <= LOCK_DELAY_TICKS * 2; ticks++) {
+            if (delay.tick(true)) {
+                return ticks;
+            }
+        }
+        return -1;
+    }
+};
+
+TEST_F(LockDelayTest, LocksAfterTheDelayOnTheGround) {
+    EXPECT_EQ(ticksToLock(), LOCK_DELAY_TICKS);
+}
+
+TEST_F(LockDelayTest, NeverLocksInTheAir) {
+    for (int tick = 0; tick < LOCK_DELAY_TICKS * 2; tick++) {
+        EXPECT_FALSE(delay.tick(false));
+    }
+    EXPECT_EQ(delay.ticksLeft(), LOCK_DELAY_TICKS);
+}
+
+TEST_F(LockDelayTest, MovesInTheAirCostNothing) {
+    for (int i = 0; i < LOCK_RESET_LIMIT * 2; i++) {
+        delay.onMove();
+    }
+    EXPECT_EQ(delay.resets(), 0);
+    EXPECT_EQ(ticksToLock(), LOCK_DELAY_TICKS);
+}
+
+TEST_F(LockDelayTest, MovesOnTheGroundRestartTheDelay) {
+    for (int tick = 0; tick < LOCK_DELAY_TICKS - 1; tick++) {
+        ASSERT_FALSE(delay.tick(true));
+    }
+    delay.onMove();
+    EXPECT_EQ(delay.resets(), 1);
+    EXPECT_EQ(delay.ticksLeft(), LOCK_DELAY_TICKS);
+    EXPECT_EQ(ticksToLock(), LOCK_DELAY_TICKS);
+}
+
+TEST_F(LockDelayTest, LocksAtOnceWhenResetsRunOut) {
+    delay.tick(true);
+    for (int i = 0; i < LOCK_RESET_LIMIT; i++) {
+        delay.onMove();
+    }
+    EXPECT_EQ(delay.resets(), LOCK_RESET_LIMIT);
+    EXPECT_TRUE(delay.tick(true));
+}
+
+TEST_F(LockDelayTest, FallingLowerGivesResetsBack) {
+    delay.tick(true);
+    for (int i = 0; i < LOCK_RESET_LIMIT; i++) {
+        delay.onMove();
+    }
+
+    delay.onFall(0);  // Same row, nothing changes
+    EXPECT_EQ(delay.resets(), LOCK_RESET_LIMIT);
+
+    delay.onFall(3);
+    EXPECT_EQ(delay.resets(), 0);
+    EXPECT_EQ(ticksToLock(), LOCK_DELAY_TICKS);
+}
+
+TEST_F(LockDelayTest, SameTicksGiveTheSameLock) {
+    auto run = [] {
+        LockDelay delay;
+        delay.reset(0);
+        for (int tick = 0;; tick++) {
+            if (tick % 7 == 0) {
+                delay.onMove();
+            }
+            if (delay.tick(tick > 3)) {
+                return tick;
+            }
+        }
+    };
+    EXPECT_EQ(run(), run());
+}
+
+// Lock delay through TetrominoManager
+class TetrominoLockDelayTest : public ::testing::Test {
+protected:
+    std::unique_ptr<TestGame> game = std::make_unique<TestGame>();
+    TetrominoManager manager{*game};
+
+    void SetUp() override {
+        manager.createNewTetromino();
+        manager.dropTetromino(GRID_HEIGHT);
+    }
+};
+
+TEST_F(TetrominoLockDelayTest, SoftDropOnTheGroundDoesNotLock) {
+    ASSERT_TRUE(manager.isGrounded());
+    const Tetromino* piece = manager.getCurrentTetromino();
+    int y = piece->y();
+
+    manager.softDrop();
+    EXPECT_EQ(manager.getCurrentTetromino(), piece);
+    EXPECT_EQ(manager.getCurrentTetromino()->y(), y);
+}
+
+TEST_F(TetrominoLockDelayTest, GroundedPieceLocksAfterTheDelay) {
+    for (int tick = 1; tick < LOCK_DELAY_TICKS; tick++) {
+        ASSERT_FALSE(manager.tickLockDelay()) << "tick " << tick;
+    }
+    EXPECT_EQ(manager.ticksUntilLock(), 1);
+    EXPECT_TRUE(manager.tickLockDelay());
+}
+
+TEST_F(TetrominoLockDelayTest, SlidingRestartsTheDelay) {
+    for (int tick = 1; tick < LOCK_DELAY_TICKS; tick++) {
+        manager.tickLockDelay();
+    }
+    ASSERT_TRUE(manager.moveTetromino(MOVE_LEFT, NO_MOVE));
+    EXPECT_EQ(manager.ticksUntilLock(), LOCK_DELAY_TICKS);
+    EXPECT_FALSE(manager.tickLockDelay());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "MusicStream.h"
+#include "WavDecoder.h"
+#include <SDL2/SDL_mixer.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+void put16(std::vector<std::byte>& out, unsigned value) {
+    out.push_back(static_cast<std::byte>(value & 0xFF));
+    out.push_back(static_cast<std::byte>((value >> 8) & 0xFF));
+}
+
+void put32(std::vector<std::byte>& out, std::uint32_t value) {
+    put16(out, value & 0xFFFF);
+    put16(out, value >> 16);
+}
+
+void putId(std::vector<std::byte>& out, const char* id) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<std::byte>(id[i]));
+    }
+}
+
+// A minimal RIFF/WAVE file around the given sample data
+std::vector<std::byte> makeWav(std::uint16_t format, int channels, int rate, int blockAlign, int bits,
+                               const std::vector<std::byte>& data) {
+    std::vector<std::byte> wav;
+    putId(wav, "RIFF");
+    put32(wav, static_cast<std::uint32_t>(4 + 8 + 16 + 8 + data.size()));
+    putId(wav, "WAVE");
+    putId(wav, "fmt ");
+    put32(wav, 16);
+    put16(wav, format);
+    put16(wav, static_cast<unsigned>(channels));
+    put32(wav, static_cast<std::uint32_t>(rate));
+    put32(wav, static_cast<std::uint32_t>(rate * blockAlign));
+    put16(wav, static_cast<unsigned>(blockAlign));
+    put16(wav, static_cast<unsigned>(bits));
+    putId(wav, "data");
+    put32(wav, static_cast<std::uint32_t>(data.size()));
+    wav.insert(wav.end(), data.begin(), data.end());
+    return wav;
+}
+
+std::vector<std::byte> makePcm(const std::vector<std::int16_t>& samples, int channels, int rate) {
+    std::vector<std::byte> data;
+    for (std::int16_t sample : samples) {
+        put16(data, static_cast<std::uint16_t>(sample));
+    }
+    return makeWav(WavDecoder::FORMAT_PCM, channels, rate, channels * 2, 16, data);
+}
+
+std::int16_t atMusicVolume(int sample) {
+    return static_cast<std::int16_t>(sample * MUSIC_VOLUME / MIX_MAX_VOLUME);
+}
+
+} // namespace
+
+TEST(WavDecoderTest, DecodesPcmInPieces) {
+    std::vector<std::int16_t> samples = {1, -2, 300, -400, 5000, -6000, 32767, -32768};
+    std::vector<std::byte> wav = makePcm(samples, 2, 22050);
+
+    WavDecoder decoder;
+    ASSERT_TRUE(decoder.open(wav));
+    EXPECT_EQ(decoder.channels(), 2);
+    EXPECT_EQ(decoder.sampleRate(), 22050);
+
+    // Whole frames only: 3 samples of room take one stereo frame
+    std::array<std::int16_t, 3> out{};
+    std::vector<std::int16_t> decoded;
+    while (std::size_t count = decoder.decode(out)) {
+        EXPECT_EQ(count, 2U);
+        decoded.insert(decoded.end(), out.begin(), out.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+    EXPECT_EQ(decoded, samples);
+
+    decoder.rewind();
+    ASSERT_EQ(decoder.decode(out), 2U);
+    EXPECT_EQ(out[0], 1);
+}
+
+TEST(WavDecoderTest, DecodesImaAdpcm) {
+    // One mono block: header with the first sample 1000 and step index 0,
+    // then eight nibbles, low nibble first
+    std::vector<std::byte> data;
+    put16(data, 1000);
+    data.push_back(std::byte{0});
+    data.push_back(std::byte{0});
+    for (unsigned byte : {0x44u, 0x00u, 0x00u, 0x98u}) {
+        data.push_back(static_cast<std::byte>(byte));
+    }
+    std::vector<std::byte> wav = makeWav(WavDecoder::FORMAT_IMA_ADPCM, 1, 44100, 8, 4, data);
+
+    WavDecoder decoder;
+    ASSERT_TRUE(decoder.open(wav));
+    std::array<std::int16_t, 16> out{};
+    ASSERT_EQ(decoder.decode(out), 9U);
+
+    // Two +4 nibbles add a full step (7, then 9) and raise the step size,
+    // zeros add an eighth of it and shrink it again, 8 and 9 are negative
+    std::vector<std::int16_t> expected = {1000, 1007, 1017, 1018, 1019, 1020, 1021, 1021, 1020};
+    EXPECT_EQ(std::vector<std::int16_t>(out.begin(), out.begin() + 9), expected);
+    EXPECT_EQ(decoder.decode(out), 0U);
+}
+
+TEST(WavDecoderTest, RejectsOtherFiles) {
+    WavDecoder decoder;
+    std::vector<std::byte> text(64, std::byte{'x'});
+    EXPECT_FALSE(decoder.open(text));
+
+    std::vector<std::byte> eightBit = makeWav(WavDecoder::FORMAT_PCM, 1, 8000, 1, 8, {std::byte{1}, std::byte{2}});
+    EXPECT_FALSE(decoder.open(eightBit));
+    EXPECT_FALSE(decoder.isOpen());
+}
+
+// Rendering device samples without the decode thread
+class MusicStreamTest : public ::testing::Test {
+protected:
+    MusicStream stream;
+    std::vector<std::byte> wav = makePcm({100, 200, 300, 400}, 1, 44100);
+
+    void SetUp() override {
+        ASSERT_TRUE(stream.addTrack(wav));
+        stream.setOutput(44100, 2);
+    }
+};
+
+TEST_F(MusicStreamTest, SilentUntilPlayed) {
+    std::array<std::int16_t, 8> out{};
+    EXPECT_EQ(stream.render(out), 0U);
+}
+
+TEST_F(MusicStreamTest, LoopsWithoutAGap) {
+    stream.play(1);
+    std::array<std::int16_t, 20> out{};
+    ASSERT_EQ(stream.render(out), out.size());
+
+    // Mono is copied to both channels and the track repeats seamlessly
+    std::array<int, 4> track = {100, 200, 300, 400};
+    for (std::size_t frame = 0; frame < 10; frame++) {
+        EXPECT_EQ(out[frame * 2], atMusicVolume(track[frame % 4])) << "frame " << frame;
+        EXPECT_EQ(out[frame * 2 + 1], out[frame * 2]);
+    }
+}
+
+TEST_F(MusicStreamTest, ResamplesToTheOutputRate) {
+    // Half the track's rate takes every other frame, the way a tempo of 2 would
+    stream.setOutput(22050, 1);
+    stream.play(1);
+    std::array<std::int16_t, 4> out{};
+    ASSERT_EQ(stream.render(out), out.size());
+    EXPECT_EQ(out[0], atMusicVolume(100));
+    EXPECT_EQ(out[1], atMusicVolume(300));
+    EXPECT_EQ(out[2], atMusicVolume(100));
+}
+
+TEST(MusicLevelTest, TracksAndTempoFollowTheLevel) {
+    MusicStream::Selection first = MusicStream::forLevel(1, 3);
+    EXPECT_EQ(first.track, 0U);
+    EXPECT_DOUBLE_EQ(first.tempo, 1.0);
+
+    MusicStream::Selection faster = MusicStream::forLevel(MUSIC_LEVELS_PER_TRACK, 3);
+    EXPECT_EQ(faster.track, 0U);
+    EXPECT_GT(faster.tempo, 1.0);
+
+    MusicStream::Selection next = MusicStream::forLevel(MUSIC_LEVELS_PER_TRACK + 1, 3);
+    EXPECT_EQ(next.track, 1U);
+    EXPECT_DOUBLE_EQ(next.tempo, 1.0);
+
+    // Past the last track it starts over
+    EXPECT_EQ(MusicStream::forLevel(3 * MUSIC_LEVELS_PER_TRACK + 1, 3).track, 0U);
+}
+
+TEST_F(MusicStreamTest, MixerReadsWhatTheDecodeThreadWrote) {
+    stream.play(1);
+    stream.start();
+
+    // The mixer hook only copies, it is silent until the thread has caught up
+    std::array<std::int16_t, 64> out{};
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    do {
+        std::this_thread::sleep_for(1ms);
+        MusicStream::mix(&stream, reinterpret_cast<Uint8*>(out.data()), static_cast<int>(sizeof(out)));
+    } while (out[0] == 0 && std::chrono::steady_clock::now() < deadline);
+    stream.stop();
+
+    EXPECT_NE(out[0], 0);
+    for (std::int16_t sample : out) {
+        EXPECT_NE(sample, 0);
+    }
+
+    // Paused music is silent
+    stream.pause();
+    MusicStream::mix(&stream, reinterpret_cast<Uint8*>(out.data()), static_cast<int>(sizeof(out)));
+    EXPECT_EQ(out[0], 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "PlacementDatabase.h"
+#include "PlacementSearch.h"
+#include "Tetromino.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+// Test fixture for the placement database and the board code it is built on
+class PlacementDatabaseTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("placement_db_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".bin")).string();
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+};
+
+TEST_F(PlacementDatabaseTest, PieceMasksMatchTetrominoShapes) {
+    for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+        Tetromino tetromino(static_cast<TetrominoType>(type), 0, 0);
+
+        for (int rotation = 0; rotation < TETROMINO_ROTATION_COUNT; rotation++) {
+            const PieceMask& mask = pieceMask(static_cast<TetrominoType>(type), rotation);
+            auto shape = tetromino.getRotatedShape();
+
+            for (int y = 0; y < TETROMINO_GRID_SIZE; y++) {
+                for (int x = 0; x < TETROMINO_GRID_SIZE; x++) {
+                    EXPECT_EQ(shape[y][x], ((mask.rows[y] >> x) & 1U) != 0);
+                }
+            }
+            tetromino.rotateWithoutWallKick();
+        }
+    }
+}
+
+TEST_F(PlacementDatabaseTest, BoardClearsCompletedLines) {
+    Board board;
+    for (int x = 0; x < GRID_WIDTH; x++) {
+        board.setOccupied(x, GRID_HEIGHT - 1);
+    }
+    board.setOccupied(0, GRID_HEIGHT - 2);
+
+    EXPECT_EQ(board.clearLines(), 1);
+    EXPECT_TRUE(board.isOccupied(0, GRID_HEIGHT - 1));
+    EXPECT_FALSE(board.isOccupied(1, GRID_HEIGHT - 1));
+    EXPECT_EQ(board.columnHeight(0), 1);
+}
+
+TEST_F(PlacementDatabaseTest, GeneratorCountsDistinctPlacementsOnEmptyBoard) {
+    Board board;
+
+    // Horizontal and vertical I, one O orientation, four T orientations
+    EXPECT_EQ(PlacementGenerator::generate(board, TetrominoType::I).size(), 17U);
+    EXPECT_EQ(PlacementGenerator::generate(board, TetrominoType::O).size(), 9U);
+    EXPECT_EQ(PlacementGenerator::generate(board, TetrominoType::T).size(), 34U);
+}
+
+TEST_F(PlacementDatabaseTest, SwarGeneratorMatchesPerColumnGenerator) {
+    std::mt19937 rng(1234);
+    std::bernoulli_distribution filled(0.35);
+
+    for (int trial = 0; trial < 50; trial++) {
+        // Random rubble in the lower half, including overhangs
+        Board board;
+        for (int y = GRID_HEIGHT / HALF; y < GRID_HEIGHT; y++) {
+            for (int x = 0; x < GRID_WIDTH; x++) {
+                if (filled(rng)) {
+                    board.setOccupied(x, y);
+                }
+            }
+        }
+
+        for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+            EXPECT_EQ(PlacementGenerator::generate(board, static_cast<TetrominoType>(type)),
+                      PlacementGenerator::generateByColumn(board, static_cast<TetrominoType>(type)));
+        }
+    }
+}
+
+TEST_F(PlacementDatabaseTest, LegalColumnsMatchFits) {
+    Board board;
+    board.setOccupied(3, GRID_HEIGHT - 1);
+    board.setOccupied(7, GRID_HEIGHT - 2);
+
+    for (int rotation = 0; rotation < TETROMINO_ROTATION_COUNT; rotation++) {
+        const PieceMask& mask = pieceMask(TetrominoType::J, rotation);
+        for (int y = GRID_HEIGHT - TETROMINO_GRID_SIZE; y < GRID_HEIGHT; y++) {
+            std::uint16_t legal = board.legalColumns(mask, y);
+            for (int column = 0; column < GRID_WIDTH; column++) {
+                EXPECT_EQ(((legal >> column) & 1U) != 0, board.fits(mask, column - mask.minX, y));
+            }
+        }
+    }
+}
+
+TEST_F(PlacementDatabaseTest, SurfaceBoardRoundTripsSignature) {
+    const int maxStep = 2;
+    for (std::uint32_t signature : {0U, 1U, 12345U, PlacementDatabase::surfaceCount(maxStep) - 1}) {
+        auto board = PlacementDatabase::surfaceBoard(signature, maxStep);
+        ASSERT_TRUE(board.has_value());
+        EXPECT_EQ(PlacementDatabase::surfaceSignature(*board, maxStep), signature);
+        EXPECT_EQ(board->holeCount(), 0);
+    }
+}
+
+TEST_F(PlacementDatabaseTest, SurfaceTallerThanPlayfieldHasNoBoard) {
+    // Nine steps of +3 would need a 27-row stack
+    const int maxStep = PlacementDatabase::MAX_SUPPORTED_STEP;
+    EXPECT_FALSE(PlacementDatabase::surfaceBoard(PlacementDatabase::surfaceCount(maxStep) - 1, maxStep).has_value());
+
+    // Six steps of +3 and three flat ones reach 18 rows and still fit
+    std::uint32_t signature = 0;
+    std::uint32_t digit = 1;
+    for (int x = 0; x + 1 < GRID_WIDTH; x++) {
+        signature += static_cast<std::uint32_t>((x < 6 ? 3 : 0) + maxStep) * digit;
+        digit *= 2 * maxStep + 1;
+    }
+    auto board = PlacementDatabase::surfaceBoard(signature, maxStep);
+    ASSERT_TRUE(board.has_value());
+    EXPECT_EQ(PlacementDatabase::surfaceSignature(*board, maxStep), signature);
+    EXPECT_EQ(board->columnHeight(GRID_WIDTH - 1), 18);
+}
+
+TEST_F(PlacementDatabaseTest, SteepSurfaceHasNoSignature) {
+    Board board;
+    for (int y = GRID_HEIGHT - 3; y < GRID_HEIGHT; y++) {
+        board.setOccupied(0, y);
+    }
+    EXPECT_FALSE(PlacementDatabase::surfaceSignature(board, 2).has_value());
+    EXPECT_TRUE(PlacementDatabase::surfaceSignature(board, 3).has_value());
+}
+
+TEST_F(PlacementDatabaseTest, LookupReturnsStoredPlacement) {
+    const int maxStep = 1;
+    Board board = *PlacementDatabase::surfaceBoard(42, maxStep);
+    auto best = PlacementSearch::findBest(board, TetrominoType::T, TetrominoType::I);
+    ASSERT_TRUE(best.has_value());
+
+    std::vector<PlacementRecord> records = {
+        {PlacementDatabase::makeKey(42, TetrominoType::T, TetrominoType::I),
+         static_cast<std::uint8_t>(best->rotation), static_cast<std::int8_t>(best->x), 0},
+        {PlacementDatabase::makeKey(7, TetrominoType::O, TetrominoType::O), 0, 4, 0}
+    };
+    ASSERT_TRUE(PlacementDatabase::write(path, maxStep, records));
+
+    PlacementDatabase database;
+    ASSERT_TRUE(database.open(path));
+    EXPECT_EQ(database.size(), 2U);
+    EXPECT_EQ(database.lookup(board, TetrominoType::T, TetrominoType::I), best);
+    EXPECT_FALSE(database.lookup(board, TetrominoType::T, TetrominoType::O).has_value());
+}
+
+TEST_F(PlacementDatabaseTest, OpenRejectsForeignFile) {
+    std::ofstream(path, std::ios::binary) << "definitely not a placement database file";
+
+    PlacementDatabase database;
+    EXPECT_FALSE(database.open(path));
+    EXPECT_FALSE(database.isOpen());
+}
+
+TEST_F(PlacementDatabaseTest, OpenRejectsWrappedRecordCount) {
+    std::vector<PlacementRecord> records = {{PlacementDatabase::makeKey(7, TetrominoType::O, TetrominoType::O), 0, 4, 0}};
+    ASSERT_TRUE(PlacementDatabase::write(path, 1, records));
+
+    // recordCount * sizeof(PlacementRecord) wraps around to the one record actually stored
+    PlacementDatabaseHeader header{};
+    {
+        std::ifstream in(path, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+    header.recordCount += (std::uint64_t{1} << 63) / (sizeof(PlacementRecord) / 2);
+    ASSERT_EQ(header.recordCount * sizeof(PlacementRecord), sizeof(PlacementRecord));
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    PlacementDatabase database;
+    EXPECT_FALSE(database.open(path));
+    EXPECT_FALSE(database.isOpen());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
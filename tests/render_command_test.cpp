@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "GameRenderer.h"
+#include "RenderCommand.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+#include <algorithm>
+
+// Test fixture for frame snapshots and the command lists built from them
+class RenderCommandTest : public ::testing::Test {
+protected:
+    TestGame game;
+    FrameSnapshot snapshot;
+    RenderCommandList commands;
+
+    void build(Uint32 ticks = 0) {
+        snapshot.capture(game, game.getTetrominoManager(), ticks);
+        GameRenderer::buildCommands(snapshot, commands);
+    }
+
+    bool contains(RenderOp op) const {
+        auto list = commands.commands();
+        return std::any_of(list.begin(), list.end(), [op](const RenderCommand& command) { return command.op == op; });
+    }
+
+    bool containsText(TextId id) const {
+        auto list = commands.commands();
+        return std::any_of(list.begin(), list.end(), [id](const RenderCommand& command) {
+            return (command.op == RenderOp::Text || command.op == RenderOp::LargeText || command.op == RenderOp::Value) &&
+                   command.id == static_cast<std::uint8_t>(id);
+        });
+    }
+};
+
+TEST_F(RenderCommandTest, SnapshotCopiesVisibleState) {
+    game.startGame();
+    game.increaseScore(120);
+    snapshot.capture(game, game.getTetrominoManager(), 0);
+
+    EXPECT_EQ(snapshot.state, GameState::Playing);
+    EXPECT_EQ(snapshot.score, 120);
+    EXPECT_EQ(snapshot.boardVersion, game.getBoardVersion());
+    ASSERT_TRUE(snapshot.piece.has_value());
+    EXPECT_EQ(*snapshot.piece, *game.getTetrominoManager().getCurrentTetromino());
+    EXPECT_EQ(snapshot.next, game.getTetrominoManager().getNextTetrominoType());
+}
+
+TEST_F(RenderCommandTest, GhostIsTheHardDropPosition) {
+    game.startGame();
+    snapshot.capture(game, game.getTetrominoManager(), 0);
+    ASSERT_TRUE(snapshot.ghost.has_value());
+
+    TetrominoManager& manager = game.getTetrominoManager();
+    while (manager.moveTetromino(NO_MOVE, MOVE_DOWN)) {
+    }
+    EXPECT_EQ(*snapshot.ghost, *manager.getCurrentTetromino());
+
+    // Resting on the floor there is nothing to show
+    snapshot.capture(game, manager, 0);
+    EXPECT_FALSE(snapshot.ghost.has_value());
+}
+
+TEST_F(RenderCommandTest, PlayingFrameIsLayeredBoardPiecesSidebar) {
+    game.startGame();
+    build();
+
+    auto list = commands.commands();
+    ASSERT_GE(list.size(), 3U);
+    EXPECT_EQ(list[0].op, RenderOp::Board);
+    EXPECT_EQ(list[1].op, RenderOp::Piece);
+    EXPECT_EQ(list[2].op, RenderOp::Ghost);
+    EXPECT_TRUE(containsText(TextId::Score));
+    EXPECT_FALSE(contains(RenderOp::Fill));
+
+    // Layers never interleave, so each is timed as one run
+    for (std::size_t i = 1; i < list.size(); i++) {
+        EXPECT_GE(list[i].layer, list[i - 1].layer);
+    }
+}
+
+TEST_F(RenderCommandTest, OverlaysFollowTheGame) {
+    game.startGame();
+    game.pauseGame();
+    build();
+    EXPECT_EQ(commands.commands().front().op, RenderOp::Board);
+    EXPECT_TRUE(containsText(TextId::Paused));
+
+    game.setGameOver();
+    build();
+    EXPECT_TRUE(containsText(TextId::GameOver));
+    EXPECT_TRUE(containsText(TextId::FinalScore));
+    EXPECT_FALSE(containsText(TextId::Paused));
+}
+
+TEST_F(RenderCommandTest, StartScreenBlinks) {
+    build(0);
+    EXPECT_TRUE(containsText(TextId::PressStart));
+    EXPECT_FALSE(contains(RenderOp::Board));
+
+    build(BLINK_INTERVAL.count());
+    EXPECT_FALSE(containsText(TextId::PressStart));
+}
+
+TEST_F(RenderCommandTest, HudIsDrawnLast) {
+    game.startGame();
+    game.pauseGame();
+    snapshot.capture(game, game.getTetrominoManager(), 0);
+    snapshot.hudVisible = true;
+    GameRenderer::buildCommands(snapshot, commands);
+
+    EXPECT_EQ(commands.commands().back().op, RenderOp::Hud);
+    EXPECT_LT(commands.size(), RenderCommandList::CAPACITY);
+}
+
+TEST_F(RenderCommandTest, FullListDropsCommands) {
+    for (std::size_t i = 0; i < RenderCommandList::CAPACITY; i++) {
+        EXPECT_TRUE(commands.push({}));
+    }
+    EXPECT_FALSE(commands.push({}));
+    EXPECT_EQ(commands.size(), RenderCommandList::CAPACITY);
+
+    commands.clear();
+    EXPECT_TRUE(commands.empty());
+}
+
+TEST_F(RenderCommandTest, EveryTextHasAString) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(TextId::COUNT); i++) {
+        EXPECT_STRNE(textFor(static_cast<TextId>(i)), "");
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "RenderThread.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// The triple buffer the simulation publishes frame snapshots through
+class TripleBufferTest : public ::testing::Test {
+protected:
+    TripleBuffer<int> buffer;
+};
+
+TEST_F(TripleBufferTest, NothingToReadBeforePublish) {
+    EXPECT_FALSE(buffer.update());
+}
+
+TEST_F(TripleBufferTest, ReaderSeesOnlyTheNewestValue) {
+    for (int i = 1; i <= 3; i++) {
+        buffer.back() = i;
+        buffer.publish();
+    }
+
+    ASSERT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.front(), 3);
+    EXPECT_FALSE(buffer.update());
+}
+
+TEST_F(TripleBufferTest, WriterNeverTouchesTheFrontValue) {
+    buffer.back() = 1;
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+
+    // Two more writes without a read cycle through the other two slots
+    for (int i = 2; i <= 5; i++) {
+        buffer.back() = i;
+        buffer.publish();
+        EXPECT_EQ(buffer.front(), 1);
+    }
+
+    ASSERT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.front(), 5);
+}
+
+TEST_F(TripleBufferTest, ValuesSurviveConcurrentUse) {
+    constexpr int count = 100000;
+    std::thread writer([this] {
+        for (int i = 1; i <= count; i++) {
+            buffer.back() = i;
+            buffer.publish();
+        }
+    });
+
+    // Values arrive in order with gaps, never torn or repeated
+    int last = 0;
+    while (last < count) {
+        if (buffer.update()) {
+            EXPECT_GT(buffer.front(), last);
+            last = buffer.front();
+        }
+    }
+    writer.join();
+}
+
+// A render thread whose present is far slower than the simulation
+class RenderThreadTest : public ::testing::Test {
+protected:
+    static constexpr auto SLOW_PRESENT = 20ms;
+    std::atomic<std::uint64_t> lastDrawn{0};
+};
+
+TEST_F(RenderThreadTest, SlowPresentDoesNotBlockPublishing) {
+    constexpr int frames = 50;
+    {
+        RenderThread renderThread([this](const FrameSnapshot& snapshot) {
+            std::this_thread::sleep_for(SLOW_PRESENT);
+            lastDrawn = snapshot.sequence;
+        });
+
+        // Drawing inline would take frames * SLOW_PRESENT
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 1; i <= frames; i++) {
+            renderThread.beginFrame().sequence = i;
+            renderThread.publish();
+            std::this_thread::sleep_for(1ms);
+        }
+        EXPECT_LT(std::chrono::steady_clock::now() - start, frames * SLOW_PRESENT / 2);
+
+        // The newest snapshot is always drawn eventually
+        for (int i = 0; i < 100 && lastDrawn != frames; i++) {
+            std::this_thread::sleep_for(SLOW_PRESENT);
+        }
+        EXPECT_EQ(lastDrawn, static_cast<std::uint64_t>(frames));
+        EXPECT_LT(renderThread.getFramesDrawn(), static_cast<std::uint64_t>(frames));
+    }
+}
+
+TEST_F(RenderThreadTest, ReleaseRunsOnTheRenderThread) {
+    std::thread::id drawThread;
+    std::thread::id releaseThread;
+    {
+        RenderThread renderThread(
+            [&](const FrameSnapshot& snapshot) {
+                drawThread = std::this_thread::get_id();
+                lastDrawn = snapshot.sequence;
+            },
+            [&] { releaseThread = std::this_thread::get_id(); });
+
+        renderThread.beginFrame().sequence = 1;
+        renderThread.publish();
+        while (lastDrawn != 1) {
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_NE(drawThread, std::this_thread::get_id());
+    EXPECT_EQ(releaseThread, drawThread);
+}
+
+TEST_F(RenderThreadTest, PaceRunsBeforeTheFrameIsPicked) {
+    std::atomic<bool> pacing{false};
+    std::atomic<std::uint64_t> firstDrawn{0};
+    {
+        RenderThread renderThread(
+            [&](const FrameSnapshot& snapshot) {
+                if (firstDrawn == 0) {
+                    firstDrawn = snapshot.sequence;
+                }
+                lastDrawn = snapshot.sequence;
+            },
+            {},
+            [&] {
+                pacing = true;
+                std::this_thread::sleep_for(SLOW_PRESENT);
+            });
+
+        renderThread.beginFrame().sequence = 1;
+        renderThread.publish();
+        while (!pacing) {
+            std::this_thread::yield();
+        }
+
+        // Published while the render thread waits for its slot
+        renderThread.beginFrame().sequence = 2;
+        renderThread.publish();
+        while (lastDrawn != 2) {
+            std::this_thread::yield();
+        }
+    }
+
+    // The frame published during the wait is the one drawn, not the stale one
+    EXPECT_EQ(firstDrawn, 2U);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "Rules.h"
+#include "Board.h"
+#include "Tetromino.h"
+#include "TetrominoManager.h"
+#include "test_helpers.h"
+#include <random>
+
+// Scripted scenarios checked by the compiler against the same rules the game runs
+
+// Drops a piece straight down from spawn after moving it to box column x
+constexpr int dropFromSpawn(Board& board, TetrominoType type, int rotation, int x) {
+    const PieceMask& mask = pieceMask(type, rotation);
+    return board.place(mask, x, board.dropY(mask, x, spawnY(type)));
+}
+
+// Two rows of two horizontal I pieces each, then an O in the last two columns: a double
+constexpr int scriptedDouble() {
+    Board board;
+    int lines = 0;
+    lines += dropFromSpawn(board, TetrominoType::I, 0, 0);
+    lines += dropFromSpawn(board, TetrominoType::I, 0, 4);
+    lines += dropFromSpawn(board, TetrominoType::I, 0, 0);
+    lines += dropFromSpawn(board, TetrominoType::I, 0, 4);
+    lines += dropFromSpawn(board, TetrominoType::O, 0, 7);
+    return board == Board() ? lines : -1;
+}
+static_assert(scriptedDouble() == 2);
+
+// Nine vertical I pieces side by side leave a well in the last column, then an I into the well: a tetris
+constexpr int scriptedTetris() {
+    Board board;
+    for (int x = 0; x < GRID_WIDTH - 1; x++) {
+        // Vertical I occupies box column 2
+        dropFromSpawn(board, TetrominoType::I, 1, x - 2);
+    }
+    return dropFromSpawn(board, TetrominoType::I, 1, GRID_WIDTH - 3);
+}
+static_assert(scriptedTetris() == 4);
+static_assert(lineClearScore(scriptedTetris(), INITIAL_LEVEL) == 800);
+
+// Kicks: a T rotated against the left wall is pushed back inside
+constexpr bool scriptedWallKick() {
+    Board board;
+    Tetromino tetromino(TetrominoType::T, 0, 0);
+    tetromino.rotate(board);
+    tetromino.rotate(board);
+    tetromino.rotate(board);
+    tetromino.moveLeft(board);
+    tetromino.rotate(board);
+    return tetromino.rotation() == 0 && board.fits(pieceMask(TetrominoType::T, 0), tetromino.x(), tetromino.y());
+}
+static_assert(scriptedWallKick());
+
+static_assert(levelForLines(0) == INITIAL_LEVEL);
+static_assert(levelForLines(LINES_PER_LEVEL) == INITIAL_LEVEL + 1);
+static_assert(levelForLines(LINES_PER_LEVEL * 1000) == MAX_LEVEL);
+static_assert(TetrominoManager::spawnTetromino(TetrominoType::I).y() == spawnY(TetrominoType::I));
+
+TEST(RulesTest, LevelProgressionMatchesGame) {
+    // Runtime level updates go through the same rule as the static_asserts above
+    TestGame game;
+    for (int step = 0; step < 30; step++) {
+        game.incrementLinesCleared(3);
+        EXPECT_EQ(game.getLevel(), levelForLines(game.getLinesCleared()));
+    }
+}
+
+TEST(RulesTest, BoardRotationMatchesGameRotation) {
+    // Against an empty grid the Game and Board overloads must agree
+    TestGame game;
+    Board board;
+    for (int type = 0; type < static_cast<int>(TetrominoType::COUNT); type++) {
+        Tetromino onGame(static_cast<TetrominoType>(type), 0, 0);
+        Tetromino onBoard = onGame;
+        for (int step = 0; step < TETROMINO_ROTATION_COUNT; step++) {
+            onGame.rotate(game);
+            onBoard.rotate(board);
+            EXPECT_EQ(onGame.x(), onBoard.x());
+            EXPECT_EQ(onGame.y(), onBoard.y());
+            EXPECT_EQ(onGame.rotation(), onBoard.rotation());
+        }
+    }
+}
+
+// Game whose grid can be filled directly
+class RulesGame : public TestGame {
+public:
+    void setCell(int x, int y, TetrominoType type) { grid_[y][x] = type; }
+};
+
+TEST(RulesTest, GameLineClearMatchesBoard) {
+    std::mt19937 rng(29);
+    std::bernoulli_distribution filled(0.5);
+    std::bernoulli_distribution fullRow(0.3);
+
+    for (int trial = 0; trial < 20; trial++) {
+        RulesGame game;
+        for (int y = GRID_HEIGHT / HALF; y < GRID_HEIGHT; y++) {
+            bool full = fullRow(rng);
+            for (int x = 0; x < GRID_WIDTH; x++) {
+                if (full || filled(rng)) {
+                    game.setCell(x, y, static_cast<TetrominoType>((x + y) % static_cast<int>(TetrominoType::COUNT)));
+                }
+            }
+        }
+        game.markBoardChanged();
+
+        Board expected = Board::fromGrid(game.getGrid());
+        int lines = expected.clearLines();
+        game.getTetrominoManager().clearLines();
+
+        EXPECT_EQ(game.getLinesCleared(), lines);
+        EXPECT_EQ(Board::fromGrid(game.getGrid()), expected);
+        for (int y = -1; y <= GRID_HEIGHT; y++) {
+            for (int x = -1; x <= GRID_WIDTH; x++) {
+                EXPECT_EQ(game.isPositionFree(x, y), !expected.isOccupied(x, y));
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
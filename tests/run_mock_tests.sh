@@ -19,7 +19,7 @@ echo "================"
 
 # Run each test executable with a focus on the actual test results
 cd tests
-for test in tetromino_test tetromino_manager_test game_test grid_collision_test; do
+for test in tetromino_test tetromino_manager_test game_test grid_collision_test placement_database_test finesse_test rules_test search_arena_test text_cache_test font_manager_test glyph_atlas_test block_atlas_test board_layer_test frame_pacer_test frame_profiler_test software_rasterizer_test render_thread_test render_command_test startup_profiler_test asset_archive_test sound_queue_test audio_latency_test music_stream_test sound_synth_test auto_repeat_test gravity_test lock_delay_test trace_test; do
   echo "Running $test:"
   ./$test 2>/dev/null | grep -E '(RUN|OK|\[|\]|Failure)' | grep -v "ALSA\|SDL_mixer\|audio"
   echo ""
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "PlacementSearch.h"
+#include "SearchArena.h"
+#include <array>
+#include <cstdint>
+
+// Upstream resource that counts what the arena asks for
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+    int deallocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override {
+        deallocations++;
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Test fixture for the search arena and node pool
+class SearchArenaTest : public ::testing::Test {
+protected:
+    CountingResource upstream;
+};
+
+TEST_F(SearchArenaTest, ResetReusesBlocks) {
+    SearchArena arena(1024, &upstream);
+    for (int round = 0; round < 3; round++) {
+        arena.reset();
+        for (int i = 0; i < 100; i++) {
+            EXPECT_NE(arena.allocate(24, alignof(std::uint64_t)), nullptr);
+        }
+    }
+
+    // 100 * 24 bytes needs three 1 KiB blocks the first time round only
+    EXPECT_EQ(upstream.allocations, 3);
+    EXPECT_EQ(arena.allocationCount(), 300U);
+    EXPECT_GE(arena.peakBytes(), 2400U);
+}
+
+TEST_F(SearchArenaTest, AllocationsAreAligned) {
+    SearchArena arena(1024, &upstream);
+    EXPECT_NE(arena.allocate(1, 1), nullptr);
+    for (std::size_t alignment : {2U, 8U, 16U, 64U}) {
+        auto address = reinterpret_cast<std::uintptr_t>(arena.allocate(3, alignment));
+        EXPECT_EQ(address % alignment, 0U);
+    }
+}
+
+TEST_F(SearchArenaTest, OversizedRequestGetsItsOwnBlock) {
+    SearchArena arena(256, &upstream);
+    void* large = arena.allocate(4096, 8);
+    EXPECT_NE(large, nullptr);
+    EXPECT_GE(arena.capacity(), 4096U);
+
+    arena.release();
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+    EXPECT_EQ(arena.capacity(), 0U);
+}
+
+TEST_F(SearchArenaTest, NodePoolReusesReleasedNodes) {
+    struct Node {
+        int value;
+    };
+
+    SearchArena arena(1024, &upstream);
+    NodePool<Node> pool(&arena);
+    Node* first = pool.create(1);
+    pool.create(2);
+    pool.destroy(first);
+
+    std::size_t allocations = arena.allocationCount();
+    Node* reused = pool.create(3);
+    EXPECT_EQ(reused, first);
+    EXPECT_EQ(reused->value, 3);
+    EXPECT_EQ(arena.allocationCount(), allocations);
+    EXPECT_EQ(pool.liveCount(), 2U);
+}
+
+TEST_F(SearchArenaTest, SearchStopsAllocatingAfterWarmUp) {
+    Board board;
+    board.setOccupied(0, GRID_HEIGHT - 1);
+    std::array<TetrominoType, 4> pieces = {TetrominoType::T, TetrominoType::I, TetrominoType::S, TetrominoType::L};
+
+    PlacementSearch::findBest(board, TetrominoType::T, TetrominoType::I);
+    PlacementSearch::beamSearch(board, pieces, 8);
+
+    SearchArena& arena = SearchArena::threadLocal();
+    arena.resetStatistics();
+    PlacementSearch::findBest(board, TetrominoType::Z, TetrominoType::O);
+    PlacementSearch::beamSearch(board, pieces, 8);
+
+    EXPECT_GT(arena.allocationCount(), 0U);
+    EXPECT_EQ(arena.upstreamAllocationCount(), 0U);
+}
+
+TEST_F(SearchArenaTest, WideBeamMatchesLookahead) {
+    Board board;
+    for (int x = 0; x < GRID_WIDTH - 1; x++) {
+        board.setOccupied(x, GRID_HEIGHT - 1);
+    }
+    board.setOccupied(4, GRID_HEIGHT - 2);
+
+    for (TetrominoType current : {TetrominoType::T, TetrominoType::I, TetrominoType::J}) {
+        std::array<TetrominoType, 2> pieces = {current, TetrominoType::S};
+        EXPECT_EQ(PlacementSearch::beamSearch(board, pieces, MAX_PLACEMENTS * MAX_PLACEMENTS),
+                  PlacementSearch::findBest(board, current, TetrominoType::S));
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
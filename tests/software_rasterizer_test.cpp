@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "SoftwareRasterizer.h"
+#include "BlockAtlas.h"
+#include "Renderer.h"
+#include "Color.h"
+
+// Test fixture for the CPU frame backend
+class SoftwareRasterizerTest : public ::testing::Test {
+protected:
+    static constexpr SDL_Color RED = {255, 0, 0, 255};
+    static constexpr SDL_Color BLUE = {0, 0, 255, 255};
+
+    SoftwareRasterizer raster{64, 32};
+};
+
+TEST_F(SoftwareRasterizerTest, FillIsClippedToFrame) {
+    raster.clear(BLUE);
+    raster.fillRect({-5, -5, 10, 10}, RED);
+
+    EXPECT_EQ(raster.pixel(4, 4), SoftwareRasterizer::pack(RED));
+    EXPECT_EQ(raster.pixel(5, 5), SoftwareRasterizer::pack(BLUE));
+    raster.fillRect({60, 30, 100, 100}, RED);
+    EXPECT_EQ(raster.pixel(63, 31), SoftwareRasterizer::pack(RED));
+}
+
+TEST_F(SoftwareRasterizerTest, FillIgnoresAlphaLikeSdlDraws) {
+    raster.fillRect({0, 0, 8, 8}, {0, 0, 0, 180});
+    EXPECT_EQ(raster.pixel(1, 1), 0xFF000000u);
+}
+
+TEST_F(SoftwareRasterizerTest, OutlineLeavesInsideUntouched) {
+    raster.clear(BLUE);
+    raster.drawRect({2, 2, 6, 6}, RED);
+
+    EXPECT_EQ(raster.pixel(2, 2), SoftwareRasterizer::pack(RED));
+    EXPECT_EQ(raster.pixel(7, 5), SoftwareRasterizer::pack(RED));
+    EXPECT_EQ(raster.pixel(4, 4), SoftwareRasterizer::pack(BLUE));
+}
+
+TEST_F(SoftwareRasterizerTest, BlitBlendsWithAlphaAndTint) {
+    raster.clear({0, 0, 0, 255});
+
+    // Odd width so both the four-pixel and the tail loop run
+    std::vector<std::uint32_t> source(7, SoftwareRasterizer::pack({200, 100, 50, 255}));
+    source[6] = SoftwareRasterizer::pack({200, 100, 50, 0});
+    raster.blit(source, 7, {0, 0, 7, 1}, 0, 0, {255, 255, 255, 128});
+
+    // Half of each channel over black, transparent pixel leaves black
+    for (int x = 0; x < 6; x++) {
+        EXPECT_EQ(raster.pixel(x, 0), SoftwareRasterizer::pack({100, 50, 25, 255})) << x;
+    }
+    EXPECT_EQ(raster.pixel(6, 0), 0xFF000000u);
+}
+
+TEST_F(SoftwareRasterizerTest, OpaqueBlitCopiesExactly) {
+    auto pixels = SoftwareRasterizer::fromRgba32(BlockAtlas::renderPixels());
+    SDL_Rect sprite = BlockAtlas::spriteRect(BlockAtlas::blockSprite(TetrominoType::T));
+    raster.blit(pixels, BlockAtlas::ATLAS_WIDTH, sprite, 10, 10, BlockAtlas::NO_TINT);
+
+    const Color& purple = COLORS[static_cast<std::size_t>(TetrominoType::T)];
+    EXPECT_EQ(raster.pixel(10 + sprite.w / 2, 10 + sprite.h / 2),
+              SoftwareRasterizer::pack({purple.r, purple.g, purple.b, ALPHA_OPAQUE}));
+}
+
+TEST(SoftwareRendererTest, HeadlessFramesAreDeterministic) {
+    FontManager fonts;
+    std::vector<std::vector<std::optional<TetrominoType>>> grid(GRID_HEIGHT,
+        std::vector<std::optional<TetrominoType>>(GRID_WIDTH));
+    grid[GRID_HEIGHT - 1][0] = TetrominoType::I;
+
+    auto draw = [&](Renderer& renderer) {
+        renderer.clear();
+        renderer.drawBoard(grid, 1);
+        renderer.drawTetromino(Tetromino(TetrominoType::O, 4, 2));
+        renderer.present();
+        return renderer.getFrame()->checksum();
+    };
+
+    Renderer first(nullptr, fonts, RenderBackend::Software);
+    Renderer second(nullptr, fonts, RenderBackend::Software);
+    ASSERT_NE(first.getFrame(), nullptr);
+    EXPECT_EQ(draw(first), draw(second));
+
+    const Color& cyan = COLORS[static_cast<std::size_t>(TetrominoType::I)];
+    EXPECT_EQ(first.getFrame()->pixel(BLOCK_SIZE / 2, (GRID_HEIGHT - 1) * BLOCK_SIZE + BLOCK_SIZE / 2),
+              SoftwareRasterizer::pack({cyan.r, cyan.g, cyan.b, ALPHA_OPAQUE}));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
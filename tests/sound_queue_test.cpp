@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "SoundQueue.h"
+#include "SpscQueue.h"
+#include <thread>
+
+// The ring the sound events travel through
+class SpscQueueTest : public ::testing::Test {
+protected:
+    SpscQueue<int, 4> queue;
+};
+
+TEST_F(SpscQueueTest, PopsInPushOrder) {
+    int value = 0;
+    EXPECT_FALSE(queue.pop(value));
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST_F(SpscQueueTest, PushFailsWhenFull) {
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(4));
+
+    // Popping one makes room for one
+    int value = 0;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.push(4));
+    EXPECT_FALSE(queue.push(5));
+}
+
+TEST_F(SpscQueueTest, WrapsAroundManyTimes) {
+    int value = 0;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(queue.push(i));
+        ASSERT_TRUE(queue.push(i + 1000));
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+}
+
+TEST(SpscQueueThreadTest, ValuesSurviveConcurrentUse) {
+    constexpr int count = 100000;
+    SpscQueue<int, 64> queue;
+    std::thread producer([&queue] {
+        for (int i = 1; i <= count; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Every value arrives exactly once and in order
+    int expected = 1;
+    int value = 0;
+    while (expected <= count) {
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(queue.pop(value));
+}
+
+// Coalescing the events of one frame
+class SoundQueueTest : public ::testing::Test {
+protected:
+    SoundQueue queue;
+
+    static std::uint16_t count(const SoundQueue::Batch& batch, SoundEffect effect) {
+        return batch[static_cast<std::size_t>(effect)];
+    }
+};
+
+TEST_F(SoundQueueTest, DrainCountsEachEffect) {
+    for (int i = 0; i < 5; i++) {
+        queue.push(SoundEffect::Move);
+    }
+    queue.push(SoundEffect::Rotate);
+    queue.push(SoundEffect::LineClear);
+
+    SoundQueue::Batch batch = queue.drain();
+    EXPECT_EQ(count(batch, SoundEffect::Move), 5);
+    EXPECT_EQ(count(batch, SoundEffect::Rotate), 1);
+    EXPECT_EQ(count(batch, SoundEffect::LineClear), 1);
+    EXPECT_EQ(count(batch, SoundEffect::Drop), 0);
+
+    // Drained events are gone
+    batch = queue.drain();
+    EXPECT_EQ(count(batch, SoundEffect::Move), 0);
+}
+
+TEST_F(SoundQueueTest, DropsEventsWhenFull) {
+    for (int i = 0; i < SOUND_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(queue.push(SoundEffect::Move));
+    }
+    EXPECT_FALSE(queue.push(SoundEffect::Drop));
+    EXPECT_EQ(queue.dropped(), 1U);
+
+    SoundQueue::Batch batch = queue.drain();
+    EXPECT_EQ(count(batch, SoundEffect::Move), SOUND_QUEUE_SIZE);
+    EXPECT_EQ(count(batch, SoundEffect::Drop), 0);
+    EXPECT_TRUE(queue.push(SoundEffect::Drop));
+}
+
+TEST(SoundVoiceTest, EveryEffectHasAVoice) {
+    for (int voices : SOUND_VOICE_LIMITS) {
+        EXPECT_GE(voices, 1);
+    }
+    EXPECT_EQ(static_cast<std::size_t>(SoundEffect::GameOver) + 1, SOUND_EFFECT_COUNT);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
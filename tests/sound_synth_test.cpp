@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "SoundSynth.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int RATE = 44100;
+
+constexpr std::array<SoundEffect, SOUND_EFFECT_COUNT> ALL_EFFECTS = {
+    SoundEffect::Move, SoundEffect::Rotate, SoundEffect::Drop,
+    SoundEffect::LineClear, SoundEffect::LevelUp, SoundEffect::GameOver};
+
+float peak(std::span<const float> samples) {
+    float result = 0.0f;
+    for (float sample : samples) {
+        result = std::max(result, std::fabs(sample));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(SoundSynthTest, EveryEffectHasSound) {
+    for (SoundEffect effect : ALL_EFFECTS) {
+        std::vector<float> samples = SoundSynth::render(effect, RATE);
+        ASSERT_FALSE(samples.empty());
+        EXPECT_GT(peak(samples), 0.05f) << static_cast<int>(effect);
+        EXPECT_LE(peak(samples), 1.0f) << static_cast<int>(effect);
+    }
+}
+
+TEST(SoundSynthTest, LengthCoversTheLastNote) {
+    std::vector<float> samples = SoundSynth::render(SoundEffect::GameOver, RATE);
+    float end = 0.0f;
+    for (const SoundSynth::Note& note : SoundSynth::patch(SoundEffect::GameOver)) {
+        end = std::max(end, note.start + note.duration);
+    }
+    EXPECT_NEAR(static_cast<double>(samples.size()), end * RATE, 2.0);
+}
+
+TEST(SoundSynthTest, RendersTheSameEveryTime) {
+    for (SoundEffect effect : ALL_EFFECTS) {
+        EXPECT_EQ(SoundSynth::render(effect, RATE), SoundSynth::render(effect, RATE));
+    }
+}
+
+TEST(SoundSynthTest, NotesFadeInAndOut) {
+    // Starting or stopping at full level would click
+    SoundSynth::Note note = {SoundSynth::Wave::Square, 0.0f, 0.05f, 440.0f, 440.0f, 1.0f, 0.5f, 0.0f};
+    std::vector<float> samples(static_cast<std::size_t>(0.05f * RATE));
+    SoundSynth::renderNote(note, RATE, samples);
+
+    EXPECT_EQ(samples.front(), 0.0f);
+    EXPECT_LT(std::fabs(samples.back()), 0.01f);
+    EXPECT_NEAR(peak(samples), 1.0f, 1e-3f);
+}
+
+TEST(SoundSynthTest, PitchMatchesTheNote) {
+    // A square wave at 441 Hz changes sign twice per 100 samples
+    SoundSynth::Note note = {SoundSynth::Wave::Square, 0.0f, 1.0f, 441.0f, 441.0f, 1.0f, 0.5f, 0.0f};
+    std::vector<float> samples(RATE);
+    SoundSynth::renderNote(note, RATE, samples);
+
+    int crossings = 0;
+    for (std::size_t i = 1; i < samples.size(); i++) {
+        crossings += (samples[i - 1] < 0.0f) != (samples[i] < 0.0f) ? 1 : 0;
+    }
+    EXPECT_NEAR(crossings, 2 * 441, 2);
+}
+
+TEST(SoundSynthTest, NotesAddUpInPlace) {
+    // Odd lengths take the scalar tail after the four-wide loop
+    SoundSynth::Note note = {SoundSynth::Wave::Triangle, 0.0f, 0.001f, 1000.0f, 1000.0f, 0.5f, 0.0f, 0.0f};
+    std::vector<float> once(47);
+    SoundSynth::renderNote(note, RATE, once);
+    std::vector<float> twice(47);
+    SoundSynth::renderNote(note, RATE, twice);
+    SoundSynth::renderNote(note, RATE, twice);
+    for (std::size_t i = 0; i < once.size(); i++) {
+        EXPECT_FLOAT_EQ(twice[i], once[i] * 2.0f);
+    }
+}
+
+TEST(SoundSynthTest, PcmCopiesEveryChannel) {
+    std::vector<float> samples = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.0f, -2.0f, 0.25f, 0.1f, -0.1f, 0.75f};
+    std::vector<std::int16_t> stereo = SoundSynth::toPcm(samples, 2);
+    std::vector<std::int16_t> mono = SoundSynth::toPcm(samples, 1);
+    ASSERT_EQ(stereo.size(), samples.size() * 2);
+    ASSERT_EQ(mono.size(), samples.size());
+
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        float clamped = std::clamp(samples[i], -1.0f, 1.0f);
+        EXPECT_NEAR(mono[i], clamped * 32767.0f, 1.0f) << i;
+        EXPECT_EQ(stereo[i * 2], mono[i]);
+        EXPECT_EQ(stereo[i * 2 + 1], mono[i]);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "Constants.h"
+#include "StartupProfiler.h"
+#include <sstream>
+
+using namespace std::chrono_literals;
+
+// Test fixture for the cold-start report
+class StartupProfilerTest : public ::testing::Test {
+protected:
+    StartupProfiler profiler;
+};
+
+TEST_F(StartupProfilerTest, StepsAreKeptInOrder) {
+    profiler.record("SDL", 30ms);
+    {
+        auto scope = profiler.measure("fonts");
+    }
+
+    ASSERT_EQ(profiler.phases().size(), 2U);
+    EXPECT_STREQ(profiler.phases()[0].name, "SDL");
+    EXPECT_EQ(profiler.phases()[0].duration, 30ms);
+    EXPECT_STREQ(profiler.phases()[1].name, "fonts");
+}
+
+TEST_F(StartupProfilerTest, StepsBeyondCapacityAreDropped) {
+    for (std::size_t i = 0; i < StartupProfiler::MAX_PHASES + 4; i++) {
+        profiler.record("step", 1ms);
+    }
+    EXPECT_EQ(profiler.phases().size(), StartupProfiler::MAX_PHASES);
+}
+
+TEST_F(StartupProfilerTest, OnlyTheFirstFrameCounts) {
+    EXPECT_FALSE(profiler.getTimeToFirstFrame().has_value());
+
+    auto first = StartupProfiler::Clock::now();
+    EXPECT_TRUE(profiler.markFirstFrame(first));
+    EXPECT_FALSE(profiler.markFirstFrame(first + 1s));
+
+    ASSERT_TRUE(profiler.getTimeToFirstFrame().has_value());
+    EXPECT_LT(*profiler.getTimeToFirstFrame(), 1s);
+}
+
+TEST_F(StartupProfilerTest, ReportFlagsASlowStart) {
+    profiler.record("renderer", 5ms);
+    profiler.markFirstFrame(StartupProfiler::Clock::now() + STARTUP_TARGET * 2);
+
+    std::ostringstream report;
+    profiler.report(report);
+    EXPECT_NE(report.str().find("renderer 5 ms"), std::string::npos);
+    EXPECT_NE(report.str().find("over the 100 ms target"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
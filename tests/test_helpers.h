@@ -32,4 +32,7 @@ public:
             tetrominoManager_ = std::make_unique<TetrominoManager>(*this);
         }
     }
+    
+    TetrominoManager& getTetrominoManager() { return *tetrominoManager_; }
+    Gravity& getGravity() { return gravity_; }
 };
\ No newline at end of file
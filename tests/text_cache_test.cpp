@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "TextCache.h"
+#include <string>
+
+// TextCache that fakes rasterisation: each glyph is 10x10 pixels
+class MockTextCache : public TextCache {
+public:
+    explicit MockTextCache(std::size_t byteBudget) : TextCache(nullptr, byteBudget) {}
+    ~MockTextCache() override { clear(); }
+
+    int renders = 0;
+    int destroys = 0;
+
+protected:
+    bool render(std::string_view text, TTF_Font*, SDL_Color, Entry& entry) override {
+        renders++;
+        entry = {nullptr, static_cast<int>(text.size()) * GLYPH_SIZE, GLYPH_SIZE};
+        return true;
+    }
+
+    void destroy(Entry&) override { destroys++; }
+
+private:
+    static constexpr int GLYPH_SIZE = 10;
+};
+
+// Test fixture for the text texture cache
+class TextCacheTest : public ::testing::Test {
+protected:
+    static constexpr SDL_Color WHITE = {255, 255, 255, 255};
+    static constexpr SDL_Color GREY = {200, 200, 200, 255};
+
+    // "abcd" costs 40x10 pixels at 4 bytes each
+    static constexpr std::size_t FOUR_CHAR_BYTES = 40 * 10 * TextCache::BYTES_PER_PIXEL;
+
+    TTF_Font* font = reinterpret_cast<TTF_Font*>(0x1000);
+    TTF_Font* otherFont = reinterpret_cast<TTF_Font*>(0x2000);
+};
+
+TEST_F(TextCacheTest, StaticLabelIsRenderedOnce) {
+    MockTextCache cache(TextCache::DEFAULT_BYTE_BUDGET);
+    for (int frame = 0; frame < 60; frame++) {
+        ASSERT_NE(cache.get("Controls:", font, GREY), nullptr);
+    }
+
+    EXPECT_EQ(cache.renders, 1);
+    EXPECT_EQ(cache.misses(), 1U);
+    EXPECT_EQ(cache.hits(), 59U);
+}
+
+TEST_F(TextCacheTest, FontAndColourArePartOfTheKey) {
+    MockTextCache cache(TextCache::DEFAULT_BYTE_BUDGET);
+    cache.get("Score", font, GREY);
+    cache.get("Score", font, WHITE);
+    cache.get("Score", otherFont, GREY);
+    cache.get(std::string("Score"), font, GREY);
+
+    EXPECT_EQ(cache.renders, 3);
+    EXPECT_EQ(cache.size(), 3U);
+    EXPECT_EQ(cache.hits(), 1U);
+}
+
+TEST_F(TextCacheTest, EvictsLeastRecentlyUsedOverBudget) {
+    MockTextCache cache(FOUR_CHAR_BYTES * 2);
+    cache.get("aaaa", font, GREY);
+    cache.get("bbbb", font, GREY);
+    cache.get("aaaa", font, GREY);  // "bbbb" is now the oldest
+    cache.get("cccc", font, GREY);
+
+    EXPECT_EQ(cache.evictions(), 1U);
+    EXPECT_EQ(cache.destroys, 1);
+    EXPECT_EQ(cache.bytes(), FOUR_CHAR_BYTES * 2);
+
+    int renders = cache.renders;
+    cache.get("aaaa", font, GREY);
+    EXPECT_EQ(cache.renders, renders);
+    cache.get("bbbb", font, GREY);
+    EXPECT_EQ(cache.renders, renders + 1);
+}
+
+TEST_F(TextCacheTest, ClearDestroysEveryTexture) {
+    MockTextCache cache(TextCache::DEFAULT_BYTE_BUDGET);
+    cache.get("one", font, GREY);
+    cache.get("two", font, GREY);
+    cache.clear();
+
+    EXPECT_EQ(cache.destroys, 2);
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ(cache.bytes(), 0U);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "Trace.h"
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::string dump() {
+    std::ostringstream out;
+    Trace::writeChromeJson(out);
+    return out.str();
+}
+
+std::size_t count(const std::string& text, const std::string& needle) {
+    std::size_t found = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        found++;
+    }
+    return found;
+}
+
+} // namespace
+
+// The trace recorder is global, each test uses zone names of its own
+class TraceTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        Trace::setEnabled(false);
+    }
+};
+
+TEST_F(TraceTest, ZonesAreOnlyRecordedWhileEnabled) {
+    {
+        Trace::Zone zone("disabledZone");
+    }
+    Trace::setEnabled(true);
+    {
+        Trace::Zone zone("enabledZone");
+    }
+
+    std::string json = dump();
+    EXPECT_EQ(count(json, "\"disabledZone\""), 0U);
+    EXPECT_EQ(count(json, "\"enabledZone\""), 1U);
+}
+
+TEST_F(TraceTest, WritesCompleteEventsInMicroseconds) {
+    auto begin = Trace::Clock::now();
+    Trace::record("timedZone", begin, begin + std::chrono::microseconds(1500));
+
+    std::string json = dump();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0U);
+    std::size_t zone = json.find("\"timedZone\"");
+    ASSERT_NE(zone, std::string::npos);
+    std::string event = json.substr(zone, json.find('}', zone) - zone);
+    EXPECT_NE(event.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(event.find("\"dur\":1500.000"), std::string::npos);
+}
+
+TEST_F(TraceTest, EachThreadGetsItsOwnTrack) {
+    Trace::setEnabled(true);
+    std::thread worker([] {
+        Trace::setThreadName("traceTestWorker");
+        Trace::Zone zone("workerZone");
+    });
+    worker.join();
+
+    // Rings outlive their threads
+    std::string json = dump();
+    EXPECT_EQ(count(json, "\"traceTestWorker\""), 1U);
+    EXPECT_EQ(count(json, "\"workerZone\""), 1U);
+}
+
+TEST_F(TraceTest, KeepsOnlyTheNewestZones) {
+    std::thread worker([] {
+        auto now = Trace::Clock::now();
+        for (std::size_t i = 0; i < TRACE_RING_SIZE; i++) {
+            Trace::record("oldZone", now, now);
+        }
+        for (std::size_t i = 0; i < TRACE_RING_SIZE / 2; i++) {
+            Trace::record("newZone", now, now);
+        }
+    });
+    worker.join();
+
+    // The oldest slot of a full ring is the next one written, so it is left out
+    std::string json = dump();
+    EXPECT_EQ(count(json, "\"oldZone\""), TRACE_RING_SIZE / 2 - 1);
+    EXPECT_EQ(count(json, "\"newZone\""), TRACE_RING_SIZE / 2);
+}
+
+TEST_F(TraceTest, DumpsWhileAnotherThreadRecords) {
+    std::atomic<bool> done{false};
+    std::thread worker([&] {
+        auto now = Trace::Clock::now();
+        while (!done.load()) {
+            for (int i = 0; i < 1000; i++) {
+                Trace::record("busyZone", now, now);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    for (int i = 0; i < 5; i++) {
+        std::string json = dump();
+        EXPECT_LE(count(json, "\"busyZone\""), TRACE_RING_SIZE);
+        EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+    }
+    done = true;
+    worker.join();
+}
+
+TEST_F(TraceTest, CopiesOnlyWholeZonesFromAFullRing) {
+    // Every zone lasts 2 us, a slot copied mid-write would mix two zones
+    std::atomic<bool> full{false};
+    std::atomic<bool> done{false};
+    std::thread worker([&] {
+        auto start = Trace::Clock::now();
+        for (std::int64_t i = 0; !done.load(); i++) {
+            auto begin = start + std::chrono::microseconds(i);
+            Trace::record("tornZone", begin, begin + std::chrono::microseconds(2));
+            if (i == static_cast<std::int64_t>(TRACE_RING_SIZE)) {
+                full = true;
+            }
+            if (i % 1000 == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    while (!full.load()) {
+        std::this_thread::yield();
+    }
+
+    for (int i = 0; i < 20; i++) {
+        std::string json = dump();
+        EXPECT_LE(count(json, "\"tornZone\""), TRACE_RING_SIZE);
+        for (std::size_t at = json.find("\"tornZone\""); at != std::string::npos; at = json.find("\"tornZone\"", at + 1)) {
+            std::size_t dur = json.find("\"dur\":", at);
+            ASSERT_EQ(json.compare(dur, 12, "\"dur\":2.000,"), 0) << json.substr(at, json.find('}', at) - at);
+        }
+    }
+    done = true;
+    worker.join();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
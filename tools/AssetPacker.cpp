@@ -0,0 +1,117 @@
+// Asset packer: writes the fonts and sounds the game uses into one archive
+// that it memory-maps at startup. WAVs are decoded and converted to the
+// mixer's output format here, so the game never parses or resamples audio.
+// Usage: asset_pack output.pak file...
+//   .ttf files become fonts/<name>, .wav files sounds/<name>, and .wav
+//   files in a directory called music become music/<name>, stored as they
+//   are: music is streamed and decoded while it plays
+#include "AssetArchive.h"
+#include "Constants.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+namespace {
+
+std::optional<std::vector<std::byte>> readFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return std::nullopt;
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<std::byte> data(bytes.size());
+    std::memcpy(data.data(), bytes.data(), bytes.size());
+    return data;
+}
+
+// Any WAV SDL can read to MIX_DEFAULT_FORMAT at AUDIO_SAMPLE_RATE and AUDIO_CHANNELS
+std::optional<std::vector<std::byte>> convertWav(const std::vector<std::byte>& wav) {
+    SDL_AudioSpec spec;
+    Uint8* samples = nullptr;
+    Uint32 length = 0;
+    SDL_RWops* stream = SDL_RWFromConstMem(wav.data(), static_cast<int>(wav.size()));
+    if (!SDL_LoadWAV_RW(stream, 1, &spec, &samples, &length)) {
+        return std::nullopt;
+    }
+
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq,
+                          MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, AUDIO_SAMPLE_RATE) < 0) {
+        SDL_FreeWAV(samples);
+        return std::nullopt;
+    }
+
+    std::size_t capacity = static_cast<std::size_t>(length) * static_cast<std::size_t>(std::max(cvt.len_mult, 1));
+    std::vector<std::byte> converted(capacity);
+    std::memcpy(converted.data(), samples, length);
+    SDL_FreeWAV(samples);
+
+    cvt.buf = reinterpret_cast<Uint8*>(converted.data());
+    cvt.len = static_cast<int>(length);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        return std::nullopt;
+    }
+    converted.resize(cvt.needed ? static_cast<std::size_t>(cvt.len_cvt) : length);
+    return converted;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: asset_pack output.pak file..." << '\n';
+        return 1;
+    }
+
+    std::vector<AssetArchive::Input> inputs;
+    for (int i = 2; i < argc; i++) {
+        std::filesystem::path path = argv[i];
+        auto data = readFile(path);
+        if (!data) {
+            std::cerr << "Cannot read " << path << '\n';
+            return 1;
+        }
+
+        std::string extension = path.extension().string();
+        std::string filename = path.filename().string();
+        if (extension == ".wav" && path.parent_path().filename() == "music") {
+            inputs.push_back({"music/" + filename, AssetArchive::Kind::Raw, std::move(*data)});
+        } else if (extension == ".wav") {
+            if (auto pcm = convertWav(*data)) {
+                inputs.push_back({"sounds/" + filename, AssetArchive::Kind::Pcm, std::move(*pcm)});
+            } else {
+                // Left for SDL_mixer to decode at load time
+                std::cerr << "Cannot convert " << path << ": " << SDL_GetError() << ", storing it as is" << '\n';
+                inputs.push_back({"sounds/" + filename, AssetArchive::Kind::Raw, std::move(*data)});
+            }
+        } else if (extension == ".ttf") {
+            inputs.push_back({"fonts/" + filename, AssetArchive::Kind::Raw, std::move(*data)});
+        } else {
+            std::cerr << "Skipping " << path << ", only .ttf and .wav files are packed" << '\n';
+        }
+    }
+
+    std::size_t count = inputs.size();
+    auto image = AssetArchive::pack(std::move(inputs));
+    if (!image) {
+        std::cerr << "Asset names must be shorter than " << AssetArchive::NAME_LENGTH << " characters" << '\n';
+        return 1;
+    }
+
+    std::ofstream out(argv[1], std::ios::binary);
+    out.write(reinterpret_cast<const char*>(image->data()), static_cast<std::streamsize>(image->size()));
+    if (!out) {
+        std::cerr << "Cannot write " << argv[1] << '\n';
+        return 1;
+    }
+
+    std::cout << "Packed " << count << " assets into " << argv[1] << " (" << image->size() << " bytes)" << '\n';
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Placement perft: counts every sequence of hard-drop placements to a fixed
+// depth and reports throughput for each placement generator.
+// Usage: perft [depth]
+#include "PlacementGenerator.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr std::array<TetrominoType, 7> PIECE_SEQUENCE = {
+    TetrominoType::T, TetrominoType::I, TetrominoType::O, TetrominoType::S,
+    TetrominoType::Z, TetrominoType::J, TetrominoType::L
+};
+
+using Generator = std::vector<Placement> (*)(const Board&, TetrominoType);
+
+std::uint64_t perft(const Board& board, int depth, int ply, Generator generate) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    TetrominoType type = PIECE_SEQUENCE[ply % PIECE_SEQUENCE.size()];
+    std::uint64_t nodes = 0;
+    for (const Placement& placement : generate(board, type)) {
+        Board next = board;
+        next.place(pieceMask(type, placement.rotation), placement.x, placement.y);
+        nodes += perft(next, depth - 1, ply + 1, generate);
+    }
+    return nodes;
+}
+
+double run(const char* name, int depth, Generator generate) {
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t nodes = perft(Board(), depth, 0, generate);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ": " << nodes << " nodes in " << elapsed.count() << " s ("
+              << static_cast<std::uint64_t>(nodes / elapsed.count()) << " nodes/s)\n";
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int depth = argc > 1 ? std::stoi(argv[1]) : 4;
+
+    double byColumn = run("per-column", depth, &PlacementGenerator::generateByColumn);
+    double swar = run("swar", depth, &PlacementGenerator::generate);
+
+    std::cout << "speedup: " << byColumn / swar << "x\n";
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Offline generator for the placement database read by PlacementDatabase.
+// Usage: placement_db_gen <output file> [max step]
+#include "PlacementDatabase.h"
+#include "PlacementSearch.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <output file> [max step 1-"
+                  << PlacementDatabase::MAX_SUPPORTED_STEP << "]\n";
+        return 1;
+    }
+
+    std::string outputPath = argv[1];
+    int maxStep = argc > 2 ? std::stoi(argv[2]) : PlacementDatabase::DEFAULT_MAX_STEP;
+    if (maxStep < 1 || maxStep > PlacementDatabase::MAX_SUPPORTED_STEP) {
+        std::cerr << "Max step must be between 1 and " << PlacementDatabase::MAX_SUPPORTED_STEP << '\n';
+        return 1;
+    }
+
+    const std::uint32_t surfaces = PlacementDatabase::surfaceCount(maxStep);
+    const unsigned threadCount = std::max(1U, std::thread::hardware_concurrency());
+    std::cout << "Generating " << surfaces << " surfaces with " << threadCount << " threads\n";
+
+    std::vector<std::vector<PlacementRecord>> results(threadCount);
+    std::vector<std::thread> workers;
+    std::atomic<std::uint32_t> nextSurface{0};
+
+    for (unsigned t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            for (std::uint32_t surface = nextSurface++; surface < surfaces; surface = nextSurface++) {
+                auto board = PlacementDatabase::surfaceBoard(surface, maxStep);
+                if (!board) {
+                    continue;
+                }
+
+                for (int piece = 0; piece < static_cast<int>(TetrominoType::COUNT); piece++) {
+                    for (int next = 0; next < static_cast<int>(TetrominoType::COUNT); next++) {
+                        auto best = PlacementSearch::findBest(*board, static_cast<TetrominoType>(piece),
+                                                              static_cast<TetrominoType>(next));
+                        if (best) {
+                            results[t].push_back({
+                                PlacementDatabase::makeKey(surface, static_cast<TetrominoType>(piece),
+                                                           static_cast<TetrominoType>(next)),
+                                static_cast<std::uint8_t>(best->rotation),
+                                static_cast<std::int8_t>(best->x),
+                                0
+                            });
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<PlacementRecord> records;
+    for (auto& partial : results) {
+        records.insert(records.end(), partial.begin(), partial.end());
+    }
+
+    std::cout << "Writing " << records.size() << " records to " << outputPath << '\n';
+    return PlacementDatabase::write(outputPath, maxStep, std::move(records)) ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+// Render benchmark: draws game frames with the software rasteriser into a
+// memory buffer, no window or GPU, and reports frame times plus a checksum of
+// the output so runs on different machines can be compared pixel for pixel.
+// Usage: render_bench [frames] [font.ttf]
+#include "FontManager.h"
+#include "FrameStats.h"
+#include "Renderer.h"
+#include <SDL2/SDL_ttf.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Grid = std::vector<std::vector<std::optional<TetrominoType>>>;
+
+constexpr int FILLED_ROWS = 8;
+
+Grid randomGrid() {
+    std::mt19937 rng(2024);
+    std::bernoulli_distribution filled(0.6);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(TetrominoType::COUNT) - 1);
+
+    Grid grid(GRID_HEIGHT, std::vector<std::optional<TetrominoType>>(GRID_WIDTH));
+    for (int y = GRID_HEIGHT - FILLED_ROWS; y < GRID_HEIGHT; y++) {
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            if (filled(rng)) {
+                grid[y][x] = static_cast<TetrominoType>(type(rng));
+            }
+        }
+    }
+    return grid;
+}
+
+double milliseconds(FrameStats::Duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::stoi(argv[1]) : 1000;
+
+    // Text is optional, without a font the renderer draws its outline fallback
+    FontManager fonts;
+    bool ttf = argc > 2 && TTF_Init() == 0;
+    if (ttf) {
+        const char* paths[] = {argv[2]};
+        fonts.resolve(paths, FONT_SIZE);
+        fonts.get(LARGE_FONT_SIZE);
+    }
+
+    std::uint64_t combined = 0;
+    FrameStats stats;
+    {
+        Renderer renderer(nullptr, fonts, RenderBackend::Software);
+        Grid grid = randomGrid();
+        int sidebarX = GRID_WIDTH * BLOCK_SIZE + SIDEBAR_PADDING;
+
+        for (int frame = 0; frame < frames; frame++) {
+            auto start = std::chrono::steady_clock::now();
+
+            auto type = static_cast<TetrominoType>(frame % static_cast<int>(TetrominoType::COUNT));
+            renderer.clear();
+            renderer.drawBoard(grid, 0);
+            renderer.drawTetromino(Tetromino(type, frame % (GRID_WIDTH - 3), frame % (GRID_HEIGHT - FILLED_ROWS - 4)));
+            renderer.drawText("Next:", sidebarX, UI_PADDING_MEDIUM);
+            renderer.drawNextTetromino(type, sidebarX + BLOCK_SIZE, UI_PADDING_MEDIUM + UI_PADDING_LARGE);
+            renderer.drawDynamicText("Score: " + std::to_string(frame * 100), sidebarX, WINDOW_HEIGHT / 2);
+            renderer.present();
+
+            stats.add(std::chrono::steady_clock::now() - start);
+            combined = combined * 31 + renderer.getFrame()->checksum();
+        }
+
+        std::cout << frames << " frames of " << WINDOW_WIDTH << "x" << WINDOW_HEIGHT << ": mean "
+                  << milliseconds(stats.mean()) << " ms, p50 " << milliseconds(stats.percentile(50)) << " ms, p99 "
+                  << milliseconds(stats.percentile(99)) << " ms (last " << stats.size() << " frames)\n"
+                  << "  last frame checksum: " << std::hex << renderer.getFrame()->checksum()
+                  << ", all frames: " << combined << std::dec << '\n';
+    }
+
+    fonts.closeAll();
+    if (ttf) {
+        TTF_Quit();
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Search benchmark: runs the placement searches over random boards and
+// reports throughput, arena use and calls to the global allocator.
+// Usage: search_bench [iterations] [beam width]
+#include "PlacementSearch.h"
+#include "SearchArena.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> globalAllocations{0};
+
+constexpr std::array<TetrominoType, 7> PIECE_SEQUENCE = {
+    TetrominoType::T, TetrominoType::I, TetrominoType::O, TetrominoType::S,
+    TetrominoType::Z, TetrominoType::J, TetrominoType::L
+};
+
+constexpr int PREVIEW_LENGTH = 5;
+
+std::vector<Board> randomBoards(int count) {
+    std::mt19937 rng(2024);
+    std::bernoulli_distribution filled(0.4);
+
+    std::vector<Board> boards(count);
+    for (Board& board : boards) {
+        for (int y = GRID_HEIGHT - 8; y < GRID_HEIGHT; y++) {
+            for (int x = 0; x < GRID_WIDTH; x++) {
+                if (filled(rng)) {
+                    board.setOccupied(x, y);
+                }
+            }
+        }
+        board.clearLines();
+    }
+    return boards;
+}
+
+template <typename Search>
+void run(const char* name, const std::vector<Board>& boards, Search&& search) {
+    SearchArena& arena = SearchArena::threadLocal();
+
+    // Warm-up: the first search on a thread sizes the arena
+    search(boards[0], 0);
+    arena.resetStatistics();
+
+    std::uint64_t before = globalAllocations.load();
+    auto start = std::chrono::steady_clock::now();
+    int found = 0;
+    for (int i = 0; i < static_cast<int>(boards.size()); i++) {
+        found += search(boards[i], i).has_value() ? 1 : 0;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::uint64_t globalCalls = globalAllocations.load() - before;
+
+    std::cout << name << ": " << boards.size() << " searches in " << elapsed.count() << " s ("
+              << static_cast<std::uint64_t>(boards.size() / elapsed.count()) << " searches/s, "
+              << found << " found)\n"
+              << "  arena allocations: " << arena.allocationCount() << " ("
+              << static_cast<std::uint64_t>(arena.allocationCount() / elapsed.count()) << " allocs/s)\n"
+              << "  arena peak: " << arena.peakBytes() << " bytes of " << arena.capacity() << " reserved\n"
+              << "  upstream blocks: " << arena.upstreamAllocationCount()
+              << ", global allocator calls: " << globalCalls << '\n';
+}
+
+} // namespace
+
+// Count every call to the global allocator made by this process
+void* operator new(std::size_t size) {
+    globalAllocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 2000;
+    int beamWidth = argc > 2 ? std::stoi(argv[2]) : 16;
+
+    std::vector<Board> boards = randomBoards(iterations);
+
+    run("lookahead", boards, [](const Board& board, int i) {
+        return PlacementSearch::findBest(board, PIECE_SEQUENCE[i % PIECE_SEQUENCE.size()],
+                                         PIECE_SEQUENCE[(i + 1) % PIECE_SEQUENCE.size()]);
+    });
+
+    run("beam", boards, [beamWidth](const Board& board, int i) {
+        std::array<TetrominoType, PREVIEW_LENGTH> pieces{};
+        for (int p = 0; p < PREVIEW_LENGTH; p++) {
+            pieces[p] = PIECE_SEQUENCE[(i + p) % PIECE_SEQUENCE.size()];
+        }
+        return PlacementSearch::beamSearch(board, pieces, beamWidth);
+    });
+
+    return 0;
+}